@@ -0,0 +1,43 @@
+// build
+// make fuzz
+// run
+// ./out/fuzz_configuration [corpus directories]
+
+#define _GNU_SOURCE
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "binding.h"
+#include "config.h"
+
+/*
+ * The device section is not fuzzed, the device is never found.
+ */
+struct input_device input_devices[MAX_INPUT_DEVICES];
+int input_device_count = 0;
+
+int find_device_event_path(char* name, int number, char* event_path)
+{
+    return EXIT_FAILURE;
+}
+
+/*
+ * The fuzzing entry point: parses the input as a configuration file.
+ */
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+    FILE* file = fmemopen((void*)data, size, "r");
+    if (!file)
+    {
+        return 0;
+    }
+    parse_configuration(file);
+    fclose(file);
+    return 0;
+}
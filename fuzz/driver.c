@@ -0,0 +1,176 @@
+// build
+// make fuzz-replay
+// run
+// ./out/fuzz_configuration_replay [files or directories]
+// afl-fuzz -i fuzz/corpus/events -o out/afl -- ./out/fuzz_events_replay
+
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+/*
+ * A standalone driver for the fuzzing entry points, for compilers without
+ * libFuzzer and for AFL. It runs the entry point on each file (or on the
+ * standard input without arguments) and reports the slowest inputs.
+ */
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+// The number of slowest inputs reported
+#define SLOWEST_LENGTH 10
+
+/*
+ * An input and its run time.
+ */
+struct timing
+{
+    char path[256];
+    long long nanoseconds;
+};
+
+// The slowest inputs, slowest first
+static struct timing slowest[SLOWEST_LENGTH];
+static int slowest_length;
+static int inputs;
+
+/*
+ * Returns the monotonic time in nanoseconds.
+ */
+static long long now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * 1000000000LL + time.tv_nsec;
+}
+
+/*
+ * Records the run time of an input among the slowest inputs.
+ */
+static void record(const char* path, long long nanoseconds)
+{
+    if (slowest_length == SLOWEST_LENGTH && slowest[SLOWEST_LENGTH - 1].nanoseconds >= nanoseconds)
+    {
+        return;
+    }
+    int i = slowest_length < SLOWEST_LENGTH ? slowest_length++ : SLOWEST_LENGTH - 1;
+    while (i > 0 && slowest[i - 1].nanoseconds < nanoseconds)
+    {
+        slowest[i] = slowest[i - 1];
+        i--;
+    }
+    snprintf(slowest[i].path, sizeof(slowest[i].path), "%s", path);
+    slowest[i].nanoseconds = nanoseconds;
+}
+
+/*
+ * Reads a stream and runs the entry point on its content.
+ */
+static int run(FILE* file, const char* path)
+{
+    size_t size = 0;
+    size_t capacity = 4096;
+    uint8_t* data = malloc(capacity);
+    size_t length;
+    while (data && (length = fread(data + size, 1, capacity - size, file)) > 0)
+    {
+        size += length;
+        if (size == capacity)
+        {
+            capacity *= 2;
+            uint8_t* grown = realloc(data, capacity);
+            if (!grown)
+            {
+                free(data);
+            }
+            data = grown;
+        }
+    }
+    if (!data)
+    {
+        fprintf(stderr, "error: could not read %s\n", path);
+        return EXIT_FAILURE;
+    }
+    long long start = now();
+    LLVMFuzzerTestOneInput(data, size);
+    record(path, now() - start);
+    inputs++;
+    free(data);
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Runs the entry point on a file, or on each file of a directory.
+ */
+static int run_path(const char* path)
+{
+    struct stat status;
+    if (stat(path, &status) != 0)
+    {
+        fprintf(stderr, "error: could not open %s\n", path);
+        return EXIT_FAILURE;
+    }
+    if (S_ISDIR(status.st_mode))
+    {
+        DIR* directory = opendir(path);
+        if (!directory)
+        {
+            fprintf(stderr, "error: could not open %s\n", path);
+            return EXIT_FAILURE;
+        }
+        int result = EXIT_SUCCESS;
+        struct dirent* entry;
+        while ((entry = readdir(directory)) != NULL)
+        {
+            if (entry->d_name[0] == '.')
+            {
+                continue;
+            }
+            char child[512];
+            snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+            if (run_path(child) != EXIT_SUCCESS)
+            {
+                result = EXIT_FAILURE;
+            }
+        }
+        closedir(directory);
+        return result;
+    }
+    FILE* file = fopen(path, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "error: could not open %s\n", path);
+        return EXIT_FAILURE;
+    }
+    int result = run(file, path);
+    fclose(file);
+    return result;
+}
+
+/*
+ * Main method.
+ */
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        return run(stdin, "<stdin>");
+    }
+    int result = EXIT_SUCCESS;
+    for (int i = 1; i < argc; i++)
+    {
+        if (run_path(argv[i]) != EXIT_SUCCESS)
+        {
+            result = EXIT_FAILURE;
+        }
+    }
+    printf("%i inputs, slowest:\n", inputs);
+    for (int i = 0; i < slowest_length; i++)
+    {
+        printf("%12.3f ms %s\n", slowest[i].nanoseconds / 1e6, slowest[i].path);
+    }
+    return result;
+}
@@ -0,0 +1,164 @@
+// build
+// make fuzz
+// run
+// ./out/fuzz_events [corpus directories]
+
+#define _GNU_SOURCE
+#include <linux/input.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "binding.h"
+#include "clock.h"
+#include "config.h"
+#include "mapper.h"
+
+/*
+ * The input is a configuration file, a zero byte, then events of three bytes:
+ * the key code (little endian, beyond KEY_MAX is allowed), and a byte with
+ * the key value in the low two bits and the milliseconds that pass before
+ * the event in the high six bits.
+ */
+#define RECORD_LENGTH 3
+
+// The fuzzed engine, its timers and the keys held down on the input
+static struct tc_engine engine;
+static struct timer_wheel wheel;
+static unsigned char down[KEY_CNT];
+
+// The virtual time in microseconds
+static uint64_t virtualTime;
+
+/*
+ * The virtual clock of the fuzzed engine.
+ */
+static uint64_t virtualClock()
+{
+    return virtualTime;
+}
+
+/*
+ * Advances the virtual time, expiring the timers that are due.
+ */
+static void elapse(int milliseconds)
+{
+    virtualTime += milliseconds * 1000ULL;
+    timer_advance(&wheel, virtualTime);
+}
+
+/*
+ * The output sink of the fuzzed engine, checks that the frames are key
+ * events ending with a synchronization.
+ */
+static void checkOutput(void* context, const struct input_event* events, int count)
+{
+    if (count < 1 || events[count - 1].type != EV_SYN)
+    {
+        abort();
+    }
+    for (int i = 0; i < count - 1; i++)
+    {
+        if (events[i].type == EV_SYN)
+        {
+            continue;
+        }
+        if (events[i].type != EV_KEY || events[i].code >= KEY_CNT || events[i].value < 0 || events[i].value > 2)
+        {
+            abort();
+        }
+    }
+}
+
+/*
+ * The device section is not fuzzed, the device is never found.
+ */
+struct input_device input_devices[MAX_INPUT_DEVICES];
+int input_device_count = 0;
+
+int find_device_event_path(char* name, int number, char* event_path)
+{
+    return EXIT_FAILURE;
+}
+
+/*
+ * The fuzzing entry point: replays the events through an engine with the configuration.
+ * Once every input key is released and the timers have expired, no output
+ * key may be left down.
+ */
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    const uint8_t* separator = memchr(data, '\0', size);
+    if (!separator)
+    {
+        return 0;
+    }
+    size_t length = separator - data;
+    FILE* file = length > 0 ? fmemopen((void*)data, length, "r") : NULL;
+    if (file)
+    {
+        parse_configuration(file);
+        fclose(file);
+    }
+    else
+    {
+        init_keymap(&keymap);
+        compile_key_actions(&keymap);
+    }
+
+    virtualTime = 1000000;
+    current_time = virtualClock;
+    timer_wheel_init(&wheel, virtualTime);
+    initEngine(&engine, &keymap, &wheel, checkOutput, NULL);
+    memset(down, 0, sizeof(down));
+    int repeating = -1;
+
+    for (const uint8_t* record = separator + 1; record + RECORD_LENGTH <= data + size; record += RECORD_LENGTH)
+    {
+        int code = record[0] | record[1] << 8;
+        int value = record[2] & 0x03;
+        elapse(record[2] >> 2);
+        if (value == 3)
+        {
+            continue;
+        }
+        // Like the input core, only report changes, and repeats of the last key pressed
+        if (code < KEY_CNT)
+        {
+            if (value == 2 ? code != repeating : down[code] == value)
+            {
+                continue;
+            }
+            down[code] = value != 0;
+            if (value == 1)
+            {
+                repeating = code;
+            }
+            else if (value == 0 && code == repeating)
+            {
+                repeating = -1;
+            }
+        }
+        processKey(&engine, EV_KEY, code, value, virtualTime);
+    }
+
+    for (int code = 0; code < KEY_CNT; code++)
+    {
+        if (down[code])
+        {
+            processKey(&engine, EV_KEY, code, 0, virtualTime);
+        }
+    }
+    elapse(60000);
+    for (int code = 0; code < KEY_CNT; code++)
+    {
+        if (engine.keystate[code])
+        {
+            fprintf(stderr, "output key %i is stuck down\n", code);
+            abort();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,375 @@
+// build
+// make bench
+// run
+// ./out/touchcursor_bench [-c] [-j] [-r] [iterations]
+//   -c collects hardware counters per event (cycles, instructions, branch and cache misses)
+//   -j prints one JSON object per scenario
+//   -r runs the engine with a flight recorder, as the daemon does
+
+#define _GNU_SOURCE
+#include <linux/input.h>
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "config.h"
+#include "keys.h"
+#include "mapper.h"
+
+// The number of events emitted by the mapper
+static long emitted;
+
+/*
+ * The output sink of the benchmark engine, counts the key events.
+ */
+static void countOutput(void* context, const struct input_event* events, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        emitted += events[i].type == EV_KEY;
+    }
+}
+
+// The benchmark engine, on the keymap of the configuration, and its flight recorder
+static struct tc_engine engine;
+static struct flight_recorder recorder;
+
+// The benchmark configuration, also parsed by the reload scenario
+static const char configuration[] =
+    "[Hyper]\n"
+    "HYPER1=KEY_SPACE\n"
+    "[Bindings]\n"
+    "KEY_I=KEY_UP\n"
+    "KEY_J=KEY_LEFT\n"
+    "KEY_K=KEY_DOWN\n"
+    "KEY_L=KEY_RIGHT\n"
+    "KEY_H=KEY_PAGEUP\n"
+    "KEY_N=KEY_PAGEDOWN\n"
+    "KEY_U=KEY_HOME\n"
+    "KEY_O=KEY_END\n"
+    "KEY_M=KEY_DELETE\n"
+    "KEY_P=KEY_BACKSPACE\n"
+    "KEY_Y=KEY_INSERT\n"
+    "KEY_D=C-LEFT\n"
+    "KEY_F=C-RIGHT\n"
+    "KEY_B=KEY_H,KEY_E,KEY_L,KEY_L,KEY_O\n"
+    "[Combos]\n"
+    "KEY_W+KEY_Q=KEY_ESC\n"
+    "[TapHold]\n"
+    "KEY_R=KEY_R,KEY_LEFTALT\n";
+
+/*
+ * A benchmark scenario: a key sequence that is replayed through the mapper,
+ * or a reload of the configuration.
+ * The sequence is pairs of key code and key value and returns the mapper to idle.
+ */
+struct scenario
+{
+    const char* name;
+    const int* sequence;
+    int length;
+    int reload;
+};
+
+// Typing unmapped keys without the hyper key
+static const int idle_passthrough[] = {
+    KEY_A, 1, KEY_A, 0, KEY_S, 1, KEY_S, 0, KEY_D, 1, KEY_D, 0, KEY_F, 1, KEY_F, 0
+};
+
+// Holding the hyper key and moving the cursor
+static const int hyper_navigation[] = {
+    KEY_SPACE, 1, KEY_J, 1, KEY_J, 0, KEY_J, 1, KEY_J, 2, KEY_J, 2, KEY_J, 0,
+    KEY_I, 1, KEY_I, 0, KEY_L, 1, KEY_L, 0, KEY_SPACE, 0
+};
+
+// Overlapping key presses while typing quickly
+static const int fast_rollover[] = {
+    KEY_T, 1, KEY_H, 1, KEY_T, 0, KEY_E, 1, KEY_H, 0, KEY_SPACE, 1, KEY_E, 0,
+    KEY_J, 1, KEY_SPACE, 0, KEY_J, 0, KEY_SPACE, 1, KEY_K, 1, KEY_SPACE, 0, KEY_K, 0
+};
+
+// Typing combo keys, alone and as a combo
+static const int combo_typing[] = {
+    KEY_W, 1, KEY_W, 0, KEY_Q, 1, KEY_Q, 0, KEY_W, 1, KEY_Q, 1, KEY_Q, 0, KEY_W, 0
+};
+
+// Typing tap/hold keys, tapped and held with another key
+static const int tap_hold_typing[] = {
+    KEY_R, 1, KEY_R, 0, KEY_R, 1, KEY_O, 1, KEY_O, 0, KEY_R, 0, KEY_R, 1, KEY_O, 1, KEY_R, 0, KEY_O, 0
+};
+
+#define scenario(array) { #array, array, sizeof(array) / sizeof(array[0]), 0 }
+static const struct scenario scenarios[] = {
+    scenario(idle_passthrough),
+    scenario(hyper_navigation),
+    scenario(fast_rollover),
+    scenario(combo_typing),
+    scenario(tap_hold_typing),
+    { "reload", NULL, 0, 1 },
+};
+
+// Reloads are much slower than key events, they run this many times fewer iterations
+#define RELOAD_DIVISOR 1000
+
+/*
+ * A hardware counter, read per scenario with -c.
+ * Counters the processor or the kernel does not provide are left closed.
+ */
+struct counter
+{
+    const char* name;
+    uint32_t type;
+    uint64_t config;
+    int descriptor;
+};
+
+#define CACHE_READ_MISSES(cache) ((cache) | PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+static struct counter counters[] = {
+    { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1 },
+    { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, -1 },
+    { "branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, -1 },
+    { "l1d_misses", PERF_TYPE_HW_CACHE, CACHE_READ_MISSES(PERF_COUNT_HW_CACHE_L1D), -1 },
+    { "llc_misses", PERF_TYPE_HW_CACHE, CACHE_READ_MISSES(PERF_COUNT_HW_CACHE_LL), -1 },
+};
+#define COUNTER_COUNT (int)(sizeof(counters) / sizeof(counters[0]))
+
+/*
+ * The result of a scenario.
+ */
+struct result
+{
+    long events;
+    long long elapsed;
+    long emitted;
+    // The counter values, or -1 for the counters that are not available
+    double counts[COUNTER_COUNT];
+};
+
+/*
+ * Opens the hardware counters of the benchmark thread, in user space only.
+ */
+static void open_counters()
+{
+    int opened = 0;
+    for (int i = 0; i < COUNTER_COUNT; i++)
+    {
+        struct perf_event_attr attributes;
+        memset(&attributes, 0, sizeof(attributes));
+        attributes.size = sizeof(attributes);
+        attributes.type = counters[i].type;
+        attributes.config = counters[i].config;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        counters[i].descriptor = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+        opened += counters[i].descriptor >= 0;
+    }
+    if (opened < COUNTER_COUNT)
+    {
+        fprintf(stderr, "warning: %i of %i hardware counters are not available\n", COUNTER_COUNT - opened, COUNTER_COUNT);
+    }
+}
+
+/*
+ * Starts or stops the open counters, they are reset when started.
+ */
+static void enable_counters(int enable)
+{
+    for (int i = 0; i < COUNTER_COUNT; i++)
+    {
+        if (counters[i].descriptor >= 0)
+        {
+            if (enable)
+            {
+                ioctl(counters[i].descriptor, PERF_EVENT_IOC_RESET, 0);
+            }
+            ioctl(counters[i].descriptor, enable ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+}
+
+/*
+ * Reads the counters, scaled up when the kernel multiplexed them.
+ */
+static void read_counters(double* counts)
+{
+    for (int i = 0; i < COUNTER_COUNT; i++)
+    {
+        uint64_t values[3];
+        counts[i] = -1;
+        if (counters[i].descriptor >= 0 && read(counters[i].descriptor, values, sizeof(values)) == sizeof(values) && values[2] > 0)
+        {
+            counts[i] = (double)values[0] * values[1] / values[2];
+        }
+    }
+}
+
+/*
+ * Returns the monotonic time in nanoseconds.
+ */
+static long long now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * 1000000000LL + time.tv_nsec;
+}
+
+/*
+ * Parses the benchmark configuration into the keymap and resets the engine, as the daemon does on reload.
+ */
+static int reload()
+{
+    FILE* file = fmemopen((void*)configuration, sizeof(configuration) - 1, "r");
+    if (!file)
+    {
+        return EXIT_FAILURE;
+    }
+    int result = parse_configuration(file);
+    fclose(file);
+    resetMapper(&engine);
+    return result;
+}
+
+/*
+ * Replays a scenario and measures the cost per input event, or per reload.
+ */
+static void run(const struct scenario* scenario, long iterations, struct result* result)
+{
+    emitted = 0;
+    enable_counters(1);
+    long long start = now();
+    if (scenario->reload)
+    {
+        for (long i = 0; i < iterations; i++)
+        {
+            reload();
+        }
+    }
+    else
+    {
+        for (long i = 0; i < iterations; i++)
+        {
+            // The events of an iteration are stamped together, like the events of one read
+            const uint64_t time = engine.clock();
+            for (int j = 0; j < scenario->length; j += 2)
+            {
+                processKey(&engine, EV_KEY, scenario->sequence[j], scenario->sequence[j + 1], time);
+            }
+        }
+    }
+    result->elapsed = now() - start;
+    enable_counters(0);
+    read_counters(result->counts);
+    result->events = scenario->reload ? iterations : iterations * (scenario->length / 2);
+    result->emitted = emitted;
+}
+
+/*
+ * Prints the result of a scenario as a line of text, the counters are printed when collected.
+ */
+static void print_text(const struct scenario* scenario, const struct result* result, int collect)
+{
+    printf("%-20s %10ld events %8.2f ns/event %8.2f emitted/event",
+        scenario->name, result->events, (double)result->elapsed / result->events, (double)result->emitted / result->events);
+    for (int i = 0; collect && i < COUNTER_COUNT; i++)
+    {
+        if (result->counts[i] < 0)
+        {
+            printf(" %10s %s", "-", counters[i].name);
+        }
+        else
+        {
+            printf(" %10.2f %s", result->counts[i] / result->events, counters[i].name);
+        }
+    }
+    printf("\n");
+}
+
+/*
+ * Prints the result of a scenario as a JSON object on one line, counters that were not collected are null.
+ */
+static void print_json(const struct scenario* scenario, const struct result* result)
+{
+    printf("{\"scenario\": \"%s\", \"events\": %ld, \"ns_per_event\": %.3f, \"emitted_per_event\": %.3f",
+        scenario->name, result->events, (double)result->elapsed / result->events, (double)result->emitted / result->events);
+    for (int i = 0; i < COUNTER_COUNT; i++)
+    {
+        if (result->counts[i] < 0)
+        {
+            printf(", \"%s_per_event\": null", counters[i].name);
+        }
+        else
+        {
+            printf(", \"%s_per_event\": %.3f", counters[i].name, result->counts[i] / result->events);
+        }
+    }
+    printf("}\n");
+}
+
+/*
+ * Main method.
+ */
+int main(int argc, char* argv[])
+{
+    int collect = 0;
+    int json = 0;
+    int record = 0;
+    int option;
+    while ((option = getopt(argc, argv, "cjr")) != -1)
+    {
+        switch (option)
+        {
+            case 'c':
+                collect = 1;
+                break;
+            case 'j':
+                json = 1;
+                break;
+            case 'r':
+                record = 1;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-c] [-j] [-r] [iterations]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    long iterations = optind < argc ? atol(argv[optind]) : 1000000;
+
+    if (collect)
+    {
+        open_counters();
+    }
+    initEngine(&engine, &keymap, &timers, countOutput, NULL);
+    if (record)
+    {
+        engine.recorder = &recorder;
+    }
+    if (reload() != EXIT_SUCCESS)
+    {
+        fprintf(stderr, "error: could not parse the benchmark configuration\n");
+        return EXIT_FAILURE;
+    }
+
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++)
+    {
+        struct result result;
+        long count = scenarios[i].reload ? iterations / RELOAD_DIVISOR : iterations;
+        run(&scenarios[i], count > 0 ? count : 1, &result);
+        if (json)
+        {
+            print_json(&scenarios[i], &result);
+        }
+        else
+        {
+            print_text(&scenarios[i], &result, collect);
+        }
+    }
+    return 0;
+}
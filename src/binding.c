@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "binding.h"
@@ -14,31 +15,32 @@
 #include "emit.h"
 #include "strings.h"
 
-// The input device
-char input_device_name[256] = "Unknown";
-char input_event_path[256] = { '\0' };
-int input_file_descriptor = -1;
+// The input devices
+struct input_device input_devices[MAX_INPUT_DEVICES];
+int input_device_count = 0;
+const char* input_devices_file = "/proc/bus/input/devices";
 
 // The output device
 char output_device_name[32] = "Virtual TouchCursor Keyboard";
 char output_sys_path[256] = { '\0' };
-int output_device_keystate[KEY_MAX];
+int output_device_keystate[KEY_CNT];
 int output_file_descriptor = -1;
 
 /**
- * Searches /proc/bus/input/devices for the device event.
+ * Searches the list of the input devices for the device event.
  *
  * @param name The device name.
  * @param number The device instance number.
+ * @param event_path The event path found, of 256 characters.
  */
-int find_device_event_path(char* name, int number)
+int find_device_event_path(char* name, int number, char* event_path)
 {
     log("info: searching for device %s:%i\n", name, number);
-    input_event_path[0] = '\0';
-    FILE* devices_file = fopen("/proc/bus/input/devices", "r");
+    event_path[0] = '\0';
+    FILE* devices_file = fopen(input_devices_file, "r");
     if (!devices_file)
     {
-        error("error: could not open /proc/bus/input/devices\n");
+        error("error: could not open %s\n", input_devices_file);
         return EXIT_FAILURE;
     }
     char* line = NULL;
@@ -67,7 +69,6 @@ int find_device_event_path(char* name, int number)
         if (matched_name)
         {
             if (!starts_with(line, "H: Handlers")) continue;
-            strcpy(input_device_name, name);
             char* tokens = line;
             char* token = strsep(&tokens, "=");
             while (tokens != NULL)
@@ -75,9 +76,8 @@ int find_device_event_path(char* name, int number)
                 token = strsep(&tokens, " ");
                 if (starts_with(token, "event"))
                 {
-                    strcat(input_event_path, "/dev/input/");
-                    strcat(input_event_path, token);
-                    log("info: found the device event path: %s\n", input_event_path);
+                    snprintf(event_path, 256, "/dev/input/%s", token);
+                    log("info: found the device event path: %s\n", event_path);
                     found_event = 1;
                     break;
                 }
@@ -95,63 +95,109 @@ int find_device_event_path(char* name, int number)
 }
 
 /**
- * Binds to the input device using ioctl.
+ * Opens an input device.
+ * The device is not grabbed until grab_input is called.
  * */
-int bind_input()
+int bind_input(struct input_device* device)
 {
-    if (input_event_path[0] == '\0')
-    {
-        error("error: no input device was configured (or the event path was not found).\n");
-        return EXIT_FAILURE;
-    }
     // Open the keyboard device
-    log("info: attempting to capture: '%s'\n", input_event_path);
-    input_file_descriptor = open(input_event_path, O_RDONLY);
-    if (input_file_descriptor < 0)
+    log("info: attempting to capture: '%s'\n", device->event_path);
+    device->file_descriptor = open(device->event_path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (device->file_descriptor < 0)
     {
         error("error: failed to open the input device: %s\n", strerror(errno));
         return EXIT_FAILURE;
     }
     // Retrieve the device name
-    if (ioctl(input_file_descriptor, EVIOCGNAME(sizeof(input_device_name)), input_device_name) < 0)
+    if (ioctl(device->file_descriptor, EVIOCGNAME(sizeof(device->name)), device->name) < 0)
     {
         error("error: failed to get the device name (EVIOCGNAME: %s)\n", strerror(errno));
+        release_input(device);
         return EXIT_FAILURE;
     }
     // Check that the device is not our virtual device
-    if (strcasestr(input_device_name, "Virtual TouchCursor Keyboard") != NULL)
+    if (strcasestr(device->name, "Virtual TouchCursor Keyboard") != NULL)
     {
-        error("error: you cannot capture the virtual device: %s\n", strerror(errno));
+        error("error: you cannot capture the virtual device: %s\n", device->event_path);
+        release_input(device);
         return EXIT_FAILURE;
     }
-    // Allow last key press to go through
-    // Grabbing the keys too quickly prevents the last key up event from being sent
-    // https://bugs.freedesktop.org/show_bug.cgi?id=101796
-    usleep(200 * 1000);
-    // Grab keys from the input device
-    if (ioctl(input_file_descriptor, EVIOCGRAB, 1) < 0)
+    // Timestamp the events with the monotonic clock of the timers
+    int clock = CLOCK_MONOTONIC;
+    if (ioctl(device->file_descriptor, EVIOCSCLOCKID, &clock) < 0)
+    {
+        warn("warning: failed to set the input clock (EVIOCSCLOCKID: %s)\n", strerror(errno));
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Grabs a bound input device.
+ *
+ * @remarks
+ * Grabbing the keys too quickly prevents the last key up event from being sent,
+ * callers should wait for INPUT_GRAB_DELAY after bind_input before grabbing.
+ * https://bugs.freedesktop.org/show_bug.cgi?id=101796
+ * */
+int grab_input(struct input_device* device)
+{
+    if (ioctl(device->file_descriptor, EVIOCGRAB, 1) < 0)
     {
         error("error: failed to capture the device (EVIOCGRAB: %s)\n", strerror(errno));
         return EXIT_FAILURE;
     }
-    log("info: successfully captured input device: %s (%s)\n", input_device_name, input_event_path);
+    log("info: successfully captured input device: %s (%s)\n", device->name, device->event_path);
     return EXIT_SUCCESS;
 }
 
 /**
- * Releases the input device.
+ * Releases an input device.
  * */
-int release_input()
+int release_input(struct input_device* device)
 {
-    if (input_file_descriptor > 0)
+    if (device->file_descriptor >= 0)
     {
-        log("info: releasing: %s (%s)\n", input_device_name, input_event_path);
-        ioctl(input_file_descriptor, EVIOCGRAB, 0);
-        close(input_file_descriptor);
+        log("info: releasing: %s (%s)\n", device->name, device->event_path);
+        ioctl(device->file_descriptor, EVIOCGRAB, 0);
+        close(device->file_descriptor);
+        device->file_descriptor = -1;
     }
     return EXIT_SUCCESS;
 }
 
+/**
+ * Checks if an input event was timestamped before another.
+ * */
+static int is_earlier(const struct input_event* event, const struct input_event* other)
+{
+    return event->input_event_sec != other->input_event_sec
+        ? event->input_event_sec < other->input_event_sec
+        : event->input_event_usec < other->input_event_usec;
+}
+
+/**
+ * Finds the device whose next event was timestamped first, to merge the events of a group of devices.
+ * Ties go to the device listed first.
+ *
+ * @param events The events read from each device.
+ * @param counts The number of events read from each device.
+ * @param next The index of the next event of each device.
+ * @param first The index of the first device, and last the index after the last one.
+ * @return int The index of the device, or -1 once all the events are taken.
+ * */
+int next_input_device(struct input_event events[][MAX_INPUT_EVENTS], const int* counts, const int* next, int first, int last)
+{
+    int earliest = -1;
+    for (int i = first; i < last; i++)
+    {
+        if (next[i] < counts[i] && (earliest < 0 || is_earlier(&events[i][next[i]], &events[earliest][next[earliest]])))
+        {
+            earliest = i;
+        }
+    }
+    return earliest;
+}
+
 /**
  * Creates and binds a virtual output device using ioctl and uinput.
  * */
@@ -218,7 +264,8 @@ int bind_output()
  * */
 void release_output_keys()
 {
-    for (int i = 0; i < KEY_MAX; i++)
+    flush_events();
+    for (int i = 0; i < KEY_CNT; i++)
     {
         if (output_device_keystate[i] > 0)
         {
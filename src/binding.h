@@ -1,38 +1,82 @@
 #ifndef binding_h
 #define binding_h
 
-#include <linux/input-event-codes.h>
+#include <linux/input.h>
+
+#define MAX_INPUT_DEVICES 8
+
+// The number of events read from an input device at once
+#define MAX_INPUT_EVENTS 64
 
 /**
- * The name of the input device.
+ * An input device of the configuration.
  * */
-extern char input_device_name[256];
+struct input_device
+{
+    // The name of the device
+    char name[256];
+    // The event path for the device
+    char event_path[256];
+    // The file descriptor for the device, -1 while it is not open
+    int file_descriptor;
+    // The index of the profile the device is mapped with
+    int profile;
+    // The index of the first device of the group of the device, whose engine maps the events of the group
+    int group;
+};
+
 /**
- * The event path for the input device.
+ * The input devices, one for each [Device] section that found its device.
  * */
-extern char input_event_path[256];
+extern struct input_device input_devices[MAX_INPUT_DEVICES];
+extern int input_device_count;
+
 /**
- * The file descriptor for the input device.
+ * The list of the input devices searched for the device events, /proc/bus/input/devices.
  * */
-extern int input_file_descriptor;
+extern const char* input_devices_file;
 
 /**
- * Searches /proc/bus/input/devices for the device event.
+ * Searches the list of the input devices for the device event.
  *
  * @param name The device name.
  * @param number The device instance number.
+ * @param event_path The event path found, of 256 characters.
  */
-int find_device_event_path(char* name, int number);
+int find_device_event_path(char* name, int number, char* event_path);
+
+/**
+ * The time to wait between opening and grabbing the input device, in milliseconds.
+ * */
+#define INPUT_GRAB_DELAY 200
 
 /**
- * Binds to the input device using ioctl.
+ * Opens an input device.
+ * The device is not grabbed until grab_input is called.
  * */
-int bind_input();
+int bind_input(struct input_device* device);
 
 /**
- * Releases the input device.
+ * Grabs a bound input device.
+ * */
+int grab_input(struct input_device* device);
+
+/**
+ * Releases an input device.
+ * */
+int release_input(struct input_device* device);
+
+/**
+ * Finds the device whose next event was timestamped first, to merge the events of a group of devices.
+ * Ties go to the device listed first.
+ *
+ * @param events The events read from each device.
+ * @param counts The number of events read from each device.
+ * @param next The index of the next event of each device.
+ * @param first The index of the first device, and last the index after the last one.
+ * @return int The index of the device, or -1 once all the events are taken.
  * */
-int release_input();
+int next_input_device(struct input_event events[][MAX_INPUT_EVENTS], const int* counts, const int* next, int first, int last);
 
 /**
  * The name of the output device.
@@ -45,7 +89,7 @@ extern char output_sys_path[256];
 /**
  * The output device key state.
  * */
-extern int output_device_keystate[KEY_MAX];
+extern int output_device_keystate[KEY_CNT];
 /**
  * The file descriptor for the output device.
  * */
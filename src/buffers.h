@@ -1,14 +1,34 @@
 #ifndef buffers_h
 #define buffers_h
 
-#define log(...)                  \
-    fprintf(stdout, __VA_ARGS__); \
-    fflush(stdout);
-#define warn(...)                 \
-    fprintf(stdout, __VA_ARGS__); \
-    fflush(stdout);
-#define error(...)                \
-    fprintf(stderr, __VA_ARGS__); \
-    fflush(stderr);
+#include "log.h"
+
+/**
+ * The logging macros, each call site is rate limited on its own.
+ * */
+#define log(...)                                            \
+    do                                                      \
+    {                                                       \
+        static struct log_site log_site;                    \
+        log_message(&log_site, log_info, __VA_ARGS__);      \
+    } while (0)
+#define warn(...)                                           \
+    do                                                      \
+    {                                                       \
+        static struct log_site log_site;                    \
+        log_message(&log_site, log_warning, __VA_ARGS__);   \
+    } while (0)
+#define error(...)                                          \
+    do                                                      \
+    {                                                       \
+        static struct log_site log_site;                    \
+        log_message(&log_site, log_error, __VA_ARGS__);     \
+    } while (0)
+#define debug(...)                                          \
+    do                                                      \
+    {                                                       \
+        static struct log_site log_site;                    \
+        log_message(&log_site, log_debug, __VA_ARGS__);     \
+    } while (0)
 
 #endif
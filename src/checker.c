@@ -0,0 +1,357 @@
+// build
+// make checker
+// run
+// ./out/touchcursor_checker [length] [threads]
+
+#include <linux/input.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "keys.h"
+#include "mapper.h"
+
+// The letter of the alphabet that lets the longest term pass instead of toggling a key
+#define WAIT 0
+
+/*
+ * The key alphabet of the sequences: the hyper key, mapped keys (a chord, a
+ * sequence, and enough single keys to fill and wrap the queue of held mapped
+ * keys), an unmapped key, a modifier, two combo keys, a tap/hold key, and
+ * the time passing past every combo window, tap/hold term and repeat delay.
+ */
+static const int alphabet[] = {
+    KEY_SPACE, KEY_J, KEY_K, KEY_L, KEY_I, KEY_U, KEY_D, KEY_B, KEY_A, KEY_LEFTSHIFT, KEY_W, KEY_Q, KEY_R, WAIT
+};
+static const char* names[] = {
+    "SPACE", "J", "K", "L", "I", "U", "D", "B", "A", "LEFTSHIFT", "W", "Q", "R", "WAIT"
+};
+#define ALPHABET_LENGTH (int)(sizeof(alphabet) / sizeof(alphabet[0]))
+
+// The maximum sequence length
+#define MAX_LENGTH 16
+
+// The number of sequences a thread takes at a time
+#define CHUNK 4096
+
+// The keymap shared by all the threads
+static struct tc_keymap keymap;
+
+// The sequence length, the number of sequences and the next sequence to check
+static int length;
+static unsigned long long total;
+static unsigned long long next;
+
+// Set when a thread finds a violation, to stop the other threads
+static int failed;
+
+/*
+ * The state of a checker thread.
+ */
+struct checker
+{
+    pthread_t thread;
+    struct timer_wheel timers;
+    struct tc_engine engine;
+    // The time to let pass for the WAIT letter, in microseconds
+    uint64_t longest;
+    // The keys held down on the output, as seen by the sink
+    unsigned char down[KEY_CNT];
+    // The first violation found in the current sequence
+    const char* violation;
+    unsigned long long sequences;
+    unsigned long long events;
+};
+
+// The virtual time of the checker of the thread, in microseconds, it only passes with the WAIT letter
+static __thread uint64_t virtualTime = 1000000;
+
+/*
+ * The clock of the checker engines.
+ */
+static uint64_t virtualClock()
+{
+    return virtualTime;
+}
+
+/*
+ * Lets the longest term pass, expiring the timers of the engine.
+ */
+static void wait(struct checker* checker)
+{
+    virtualTime += checker->longest;
+    timer_advance(&checker->timers, virtualTime);
+}
+
+/*
+ * Checks the invariants of the queue of held mapped keys: its indexes are in
+ * the store, it holds no key twice, and every key in it is still held.
+ *
+ * @return const char* The violation, or NULL if there is none.
+ * */
+static const char* check_queue(const struct queue* queue, const unsigned char* held)
+{
+    if (queue->head < 0 || queue->head >= QUEUE_LENGTH || queue->tail < 0 || queue->tail >= QUEUE_LENGTH)
+    {
+        return "the queue indexes are out of the store";
+    }
+    for (int i = queue->head; i != queue->tail; i = (i + 1) % QUEUE_LENGTH)
+    {
+        const int code = queue->store[i];
+        if (code <= 0 || code >= KEY_CNT || !held[code])
+        {
+            return "the queue holds a key that is not held";
+        }
+        for (int j = (i + 1) % QUEUE_LENGTH; j != queue->tail; j = (j + 1) % QUEUE_LENGTH)
+        {
+            if (queue->store[j] == code)
+            {
+                return "the queue holds a key twice";
+            }
+        }
+    }
+    return NULL;
+}
+
+/*
+ * The output sink of the checker engines, tracks the keys held down on the output.
+ * Like the input core, a press of a key that is down and a release of a key
+ * that is up do not change its state.
+ */
+static void checkOutput(void* context, const struct input_event* events, int count)
+{
+    struct checker* checker = context;
+    for (int i = 0; i < count; i++)
+    {
+        if (events[i].type == EV_KEY && events[i].value != 2)
+        {
+            checker->down[events[i].code] = events[i].value;
+        }
+    }
+}
+
+/*
+ * Decodes the keys of a sequence from its index, one alphabet digit per event.
+ */
+static void decode(unsigned long long index, int* keys, int* letters)
+{
+    for (int i = 0; i < length; i++)
+    {
+        letters[i] = index % ALPHABET_LENGTH;
+        keys[i] = alphabet[letters[i]];
+        index /= ALPHABET_LENGTH;
+    }
+}
+
+/*
+ * Prints a sequence and the violation it causes.
+ */
+static void report(struct checker* checker, const int* keys, const int* letters)
+{
+    unsigned char held[KEY_CNT];
+    memset(held, 0, sizeof(held));
+    printf("violation: %s\nsequence:", checker->violation);
+    for (int i = 0; i < length; i++)
+    {
+        if (keys[i] == WAIT)
+        {
+            printf(" %s", names[letters[i]]);
+            continue;
+        }
+        held[keys[i]] = !held[keys[i]];
+        printf(" %s%s", names[letters[i]], held[keys[i]] ? "+" : "-");
+    }
+    printf(" then all keys released\n");
+}
+
+/*
+ * Runs a sequence through the engine, then releases the held keys, and checks the invariants.
+ * Each event presses the key if it is up and releases it if it is down.
+ */
+static int check(struct checker* checker, const int* keys)
+{
+    struct tc_engine* engine = &checker->engine;
+    unsigned char held[KEY_CNT];
+    memset(held, 0, sizeof(held));
+    resetMapper(engine);
+    memset(checker->down, 0, sizeof(checker->down));
+    checker->violation = NULL;
+    for (int i = 0; i < length && !checker->violation; i++)
+    {
+        if (keys[i] == WAIT)
+        {
+            wait(checker);
+        }
+        else
+        {
+            held[keys[i]] = !held[keys[i]];
+            processKey(engine, EV_KEY, keys[i], held[keys[i]], engine->clock());
+            checker->events++;
+        }
+        if (engine->pendingLength > MAX_PENDING || engine->tapHoldLength > MAX_PENDING)
+        {
+            checker->violation = "a buffer overflowed";
+        }
+        else
+        {
+            // The hyper stage has not seen the events still held back by the combo and tap/hold stages
+            unsigned char seen[KEY_CNT];
+            memcpy(seen, held, sizeof(seen));
+            for (int j = engine->pendingLength - 1; j >= 0; j--)
+            {
+                seen[engine->pending[j].code] = engine->pending[j].value == 0;
+            }
+            for (int j = engine->tapHoldLength - 1; j >= 0; j--)
+            {
+                seen[engine->tapHoldEvents[j].code] = engine->tapHoldEvents[j].value == 0;
+            }
+            checker->violation = check_queue(&engine->queue, seen);
+        }
+    }
+    for (int i = 0; i < ALPHABET_LENGTH; i++)
+    {
+        if (alphabet[i] != WAIT && held[alphabet[i]])
+        {
+            processKey(engine, EV_KEY, alphabet[i], 0, engine->clock());
+            checker->events++;
+        }
+    }
+    wait(checker);
+    if (!checker->violation)
+    {
+        for (int code = 0; code < KEY_CNT; code++)
+        {
+            if (checker->down[code])
+            {
+                checker->violation = "a key pressed on the output was not released";
+                break;
+            }
+        }
+    }
+    if (!checker->violation && (engine->state != idle || engine->pendingLength != 0 || engine->tapHoldLength != 0))
+    {
+        checker->violation = "the engine is not idle after all keys were released";
+    }
+    checker->sequences++;
+    return checker->violation == NULL;
+}
+
+/*
+ * Checks chunks of sequences until all are checked or a violation is found.
+ */
+static void* run(void* argument)
+{
+    struct checker* checker = argument;
+    int keys[MAX_LENGTH];
+    int letters[MAX_LENGTH];
+    while (!__atomic_load_n(&failed, __ATOMIC_RELAXED))
+    {
+        unsigned long long start = __atomic_fetch_add(&next, CHUNK, __ATOMIC_RELAXED);
+        if (start >= total)
+        {
+            break;
+        }
+        unsigned long long end = start + CHUNK < total ? start + CHUNK : total;
+        for (unsigned long long index = start; index < end; index++)
+        {
+            decode(index, keys, letters);
+            if (!check(checker, keys))
+            {
+                if (!__atomic_exchange_n(&failed, 1, __ATOMIC_RELAXED))
+                {
+                    report(checker, keys, letters);
+                }
+                return NULL;
+            }
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Returns the monotonic time in nanoseconds.
+ */
+static long long now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * 1000000000LL + time.tv_nsec;
+}
+
+/*
+ * Main method.
+ * Checks every sequence of the given length over the alphabet, on all cores.
+ */
+int main(int argc, char* argv[])
+{
+    length = argc > 1 ? atoi(argv[1]) : 6;
+    int threads = argc > 2 ? atoi(argv[2]) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (length < 1 || length > MAX_LENGTH || threads < 1)
+    {
+        fprintf(stderr, "usage: %s [length 1-%i] [threads]\n", argv[0], MAX_LENGTH);
+        return EXIT_FAILURE;
+    }
+    total = 1;
+    for (int i = 0; i < length; i++)
+    {
+        total *= ALPHABET_LENGTH;
+    }
+
+    // default config, with the bindings of the tests
+    init_keymap(&keymap);
+    keymap.hyperKey = KEY_SPACE;
+    const int singles[][2] = { { KEY_J, KEY_LEFT }, { KEY_K, KEY_DOWN }, { KEY_L, KEY_RIGHT }, { KEY_I, KEY_UP }, { KEY_U, KEY_HOME } };
+    for (int i = 0; i < (int)(sizeof(singles) / sizeof(singles[0])); i++)
+    {
+        bind_key_sequence(&keymap, singles[i][0], &singles[i][1], 1);
+    }
+    int ctrlLeft[] = { KEY_LEFTCTRL | SEQUENCE_CHORD, KEY_LEFT };
+    bind_key_sequence(&keymap, KEY_D, ctrlLeft, 2);
+    int hello[] = { KEY_H, KEY_E, KEY_L, KEY_L, KEY_O };
+    bind_key_sequence(&keymap, KEY_B, hello, 5);
+    int wq[] = { KEY_W, KEY_Q }, esc[] = { KEY_ESC };
+    add_combo(&keymap, wq, 2, add_key_sequence(&keymap, esc, 1), 1);
+    keymap.tap_holds[KEY_R] = (struct tap_hold){ KEY_R, KEY_LEFTALT };
+    compile_key_actions(&keymap);
+    int longest = keymap.combo_window > keymap.tap_hold_term ? keymap.combo_window : keymap.tap_hold_term;
+    longest = keymap.repeat.delay > longest ? keymap.repeat.delay : longest;
+    const uint64_t longest_time = (longest + 1) * 1000ULL;
+
+    struct checker* checkers = calloc(threads, sizeof(struct checker));
+    if (!checkers)
+    {
+        fprintf(stderr, "error: could not allocate the checkers\n");
+        return EXIT_FAILURE;
+    }
+    long long start = now();
+    for (int i = 0; i < threads; i++)
+    {
+        struct checker* checker = &checkers[i];
+        timer_wheel_init(&checker->timers, virtualClock());
+        initEngine(&checker->engine, &keymap, &checker->timers, checkOutput, checker);
+        checker->engine.clock = virtualClock;
+        checker->longest = longest_time;
+        pthread_create(&checker->thread, NULL, run, checker);
+    }
+    unsigned long long sequences = 0;
+    unsigned long long events = 0;
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_join(checkers[i].thread, NULL);
+        sequences += checkers[i].sequences;
+        events += checkers[i].events;
+    }
+    double elapsed = (now() - start) / 1e9;
+    printf("%llu sequences of length %i, %llu events, %i threads, %.2f s, %.0f sequences/s, %.0f events/s\n",
+        sequences, length, events, threads, elapsed, sequences / elapsed, events / elapsed);
+    free(checkers);
+    if (failed)
+    {
+        return EXIT_FAILURE;
+    }
+    printf("All sequences passed!\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,15 @@
+#include <time.h>
+
+#include "clock.h"
+
+/**
+ * Returns the monotonic time in microseconds.
+ * */
+uint64_t monotonic_time()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000 + time.tv_nsec / 1000;
+}
+
+uint64_t (*current_time)() = monotonic_time;
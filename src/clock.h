@@ -0,0 +1,17 @@
+#ifndef clock_h
+#define clock_h
+
+#include <stdint.h>
+
+/**
+ * Returns the monotonic time in microseconds.
+ * */
+uint64_t monotonic_time();
+
+/**
+ * The clock the mapper and the timers read the time from, in microseconds.
+ * It is the monotonic clock, tests replace it with a virtual clock.
+ * */
+extern uint64_t (*current_time)();
+
+#endif
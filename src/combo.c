@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "buffers.h"
+#include "combo.h"
+#include "keymap.h"
+
+/**
+ * Hashes a key set to a match table slot.
+ * */
+static unsigned int hash_keys(uint32_t keys)
+{
+    return (keys * 2654435761u) >> 21;
+}
+
+/**
+ * Finds the match table slot for a key set, or the empty slot where it belongs.
+ * */
+static unsigned int find_match(const struct combo_match* table, uint32_t keys)
+{
+    unsigned int slot = hash_keys(keys);
+    while (table[slot].keys != 0 && table[slot].keys != keys)
+    {
+        slot = (slot + 1) % COMBO_MATCH_TABLE_SIZE;
+    }
+    return slot;
+}
+
+/**
+ * Adds a combo.
+ * */
+int add_combo(struct tc_keymap* keymap, const int* codes, int count, int offset, int length)
+{
+    if (keymap->combo_count == MAX_COMBOS)
+    {
+        error("error: too many combos (maximum of %i)\n", MAX_COMBOS);
+        return EXIT_FAILURE;
+    }
+    if (count < 2 || count > MAX_COMBO_KEYS)
+    {
+        error("error: a combo must have between 2 and %i keys\n", MAX_COMBO_KEYS);
+        return EXIT_FAILURE;
+    }
+    struct combo* combo = &keymap->combos[keymap->combo_count++];
+    memset(combo, 0, sizeof(*combo));
+    for (int i = 0; i < count; i++)
+    {
+        combo->codes[i] = codes[i];
+    }
+    combo->count = count;
+    combo->offset = offset;
+    combo->length = length;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Removes all combos.
+ * */
+void clear_combos(struct tc_keymap* keymap)
+{
+    keymap->combo_count = 0;
+    memset(keymap->combo_matches, 0, sizeof(keymap->combo_matches));
+}
+
+/**
+ * Assigns a bit to each key used in a combo and builds the match table.
+ * The bit of each key is stored in key_actions.
+ * */
+int compile_combos(struct tc_keymap* keymap)
+{
+    int candidates = 0;
+    memset(keymap->combo_matches, 0, sizeof(keymap->combo_matches));
+    for (int i = 0; i < keymap->combo_count; i++)
+    {
+        struct combo* combo = &keymap->combos[i];
+        combo->keys = 0;
+        for (int j = 0; j < combo->count; j++)
+        {
+            struct key_action* action = &keymap->key_actions[combo->codes[j]];
+            if (!(action->flags & KEY_ACTION_COMBO))
+            {
+                if (candidates == MAX_COMBO_CANDIDATES)
+                {
+                    error("error: too many combo keys (maximum of %i)\n", MAX_COMBO_CANDIDATES);
+                    keymap->combo_count = i;
+                    return EXIT_FAILURE;
+                }
+                action->flags |= KEY_ACTION_COMBO;
+                action->combo = candidates++;
+            }
+            combo->keys |= 1u << action->combo;
+        }
+        // Every subset of the combo is a prefix, the full set is an exact match
+        for (uint32_t subset = combo->keys; subset != 0; subset = (subset - 1) & combo->keys)
+        {
+            struct combo_match* match = &keymap->combo_matches[find_match(keymap->combo_matches, subset)];
+            match->keys = subset;
+            if (subset == combo->keys)
+            {
+                match->flags |= COMBO_EXACT;
+                match->index = i;
+            }
+            else
+            {
+                match->flags |= COMBO_PREFIX;
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Matches a set of pressed combo keys.
+ *
+ * @param keys The bit mask of the pressed keys.
+ * @param index Receives the index of the combo if the set is a combo.
+ * @return int The COMBO_EXACT and COMBO_PREFIX flags, or 0 if the set cannot become a combo.
+ * */
+int match_combo(const struct tc_keymap* keymap, uint32_t keys, int* index)
+{
+    const struct combo_match* match = &keymap->combo_matches[find_match(keymap->combo_matches, keys)];
+    if (match->keys == 0)
+    {
+        return 0;
+    }
+    *index = match->index;
+    return match->flags;
+}
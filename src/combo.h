@@ -0,0 +1,70 @@
+#ifndef combo_h
+#define combo_h
+
+#include <stdint.h>
+
+#define MAX_COMBOS 64
+#define MAX_COMBO_KEYS 4
+#define MAX_COMBO_CANDIDATES 32
+#define DEFAULT_COMBO_WINDOW 50
+
+/**
+ * Match results for a set of pressed combo keys.
+ * */
+#define COMBO_EXACT 0x01  // The set is a combo
+#define COMBO_PREFIX 0x02 // The set is part of a larger combo
+
+/**
+ * A combo: keys pressed together that emit a sequence.
+ * */
+struct combo
+{
+    uint16_t codes[MAX_COMBO_KEYS];
+    uint8_t count;
+    uint32_t keys;    // The bit mask of the keys, set by compile_combos
+    uint16_t offset;  // The offset of the output sequence in key_sequences
+    uint16_t length;  // The length of the output sequence
+};
+
+/**
+ * An entry of the match table.
+ * Every non-empty subset of the keys of every combo has an entry.
+ * */
+struct combo_match
+{
+    uint32_t keys;
+    uint8_t flags;
+    uint8_t index;
+};
+
+// The size of the match table, an open addressing hash table of key sets
+#define COMBO_MATCH_TABLE_SIZE 2048
+
+struct tc_keymap;
+
+/**
+ * Adds a combo.
+ * */
+int add_combo(struct tc_keymap* keymap, const int* codes, int count, int offset, int length);
+
+/**
+ * Removes all combos.
+ * */
+void clear_combos(struct tc_keymap* keymap);
+
+/**
+ * Assigns a bit to each key used in a combo and builds the match table.
+ * The bit of each key is stored in key_actions.
+ * */
+int compile_combos(struct tc_keymap* keymap);
+
+/**
+ * Matches a set of pressed combo keys.
+ *
+ * @param keys The bit mask of the pressed keys.
+ * @param index Receives the index of the combo if the set is a combo.
+ * @return int The COMBO_EXACT and COMBO_PREFIX flags, or 0 if the set cannot become a combo.
+ * */
+int match_combo(const struct tc_keymap* keymap, uint32_t keys, int* index);
+
+#endif
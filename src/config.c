@@ -1,6 +1,7 @@
 #define _GNU_SOURCE
 #include <ctype.h>
 #include <errno.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -14,9 +15,25 @@
 
 char configuration_file_path[256];
 
-int hyperKey;
-struct key_output keymap[256] = { 0 };
-int remap[256] = { 0 };
+struct tc_keymap keymap;
+int reload_quiet_period = DEFAULT_RELOAD_QUIET_PERIOD;
+uint64_t configuration_hash = 0;
+char metrics_socket_path[108] = { '\0' };
+int bypass_keys[MAX_BYPASS_KEYS];
+int bypass_keys_length = 0;
+struct tc_profile profiles[MAX_PROFILES];
+int profile_count = 0;
+
+// The keymaps of the profiles after the default profile, which reads into keymap
+static struct tc_keymap profile_keymaps[MAX_PROFILES - 1];
+
+// The keymap of the profile being read, and whether the lines up to the next profile are ignored
+static struct tc_keymap* current = &keymap;
+static int skipping_profile = 0;
+
+// The profile and group names of the devices, resolved once every profile is read
+static char device_profiles[MAX_INPUT_DEVICES][MAX_PROFILE_NAME];
+static char device_groups[MAX_INPUT_DEVICES][MAX_PROFILE_NAME];
 
 /**
  * Checks for the device number if it is configured.
@@ -83,32 +100,329 @@ int find_configuration_file()
     return EXIT_FAILURE;
 }
 
+/**
+ * Reads the content of the configuration file into a buffer, which the caller frees.
+ *
+ * @return char* The content, or NULL if the file could not be read.
+ * */
+static char* read_configuration_content(size_t* length)
+{
+    FILE* configuration_file = fopen(configuration_file_path, "r");
+    if (!configuration_file)
+    {
+        return NULL;
+    }
+    char* content = NULL;
+    size_t size = 0;
+    *length = 0;
+    do
+    {
+        if (*length == size)
+        {
+            size = size == 0 ? 4096 : size * 2;
+            char* grown = realloc(content, size);
+            if (grown == NULL)
+            {
+                free(content);
+                fclose(configuration_file);
+                return NULL;
+            }
+            content = grown;
+        }
+        *length += fread(content + *length, 1, size - *length, configuration_file);
+    } while (*length == size);
+    int failed = ferror(configuration_file);
+    fclose(configuration_file);
+    if (failed)
+    {
+        free(content);
+        return NULL;
+    }
+    return content;
+}
+
+/**
+ * Hashes a configuration content (64 bit FNV-1a).
+ * */
+static uint64_t hash_configuration(const char* content, size_t length)
+{
+    uint64_t value = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; i++)
+    {
+        value = (value ^ (unsigned char)content[i]) * 0x100000001b3ULL;
+    }
+    return value;
+}
+
+/**
+ * Hashes the content of the configuration file.
+ * */
+int hash_configuration_file(uint64_t* hash)
+{
+    size_t length;
+    char* content = read_configuration_content(&length);
+    if (content == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+    *hash = hash_configuration(content, length);
+    free(content);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Converts a key string to its code, reporting unknown keys.
+ *
+ * @return int The code, or 0 if the string is not a key name.
+ * */
+static int convert_key(char* token)
+{
+    int code = convertKeyStringToCode(token);
+    if (code == 0)
+    {
+        error("error: unknown key: %s\n", token ? token : "");
+    }
+    return code;
+}
+
+/**
+ * Converts a chord prefix "C-" to its modifier code.
+ * */
+static int convert_chord_prefix(const char* token)
+{
+    if (token[0] == '\0' || token[1] != '-' || token[2] == '\0') return 0;
+    switch (token[0])
+    {
+        case 'C': return KEY_LEFTCTRL;
+        case 'S': return KEY_LEFTSHIFT;
+        case 'A': return KEY_LEFTALT;
+        case 'G': return KEY_RIGHTALT;
+        case 'M': return KEY_LEFTMETA;
+        default: return 0;
+    }
+}
+
+/**
+ * Appends an output token to the key sequences of the current keymap.
+ * A token is a key "LEFT", or a chord "C-LEFT" or "LEFTCTRL+LEFT".
+ * The modifiers of a chord are flagged with SEQUENCE_CHORD.
+ *
+ * @return int The number of codes appended, or -1 on failure.
+ * */
+static int append_key_token(char* token)
+{
+    int count = 0;
+    int modifier;
+    while ((modifier = convert_chord_prefix(token)) != 0)
+    {
+        if (append_key_sequence(current, modifier | SEQUENCE_CHORD) != EXIT_SUCCESS) return -1;
+        count++;
+        token += 2;
+    }
+    char* part;
+    while ((part = strsep(&token, "+")) != NULL)
+    {
+        int code = convert_key(part);
+        if (code == 0) return -1;
+        if (token != NULL)
+        {
+            code |= SEQUENCE_CHORD;
+        }
+        if (append_key_sequence(current, code) != EXIT_SUCCESS) return -1;
+        count++;
+    }
+    return count;
+}
+
 static enum sections {
     configuration_none,
     configuration_device,
     configuration_remap,
     configuration_hyper,
     configuration_bindings,
+    configuration_modifiers,
+    configuration_combos,
+    configuration_tap_hold,
+    configuration_repeat,
+    configuration_options,
     configuration_invalid
 } section;
 
 /**
- * Reads the configuration file.
+ * Converts an option value to a number of milliseconds.
+ *
+ * @return int The number, or -1 if the value is not a number of milliseconds.
  * */
-int read_configuration()
+static int convert_milliseconds(const char* value)
+{
+    char* end;
+    errno = 0;
+    long number = strtol(value, &end, 10);
+    if (end == value || *end != '\0' || errno != 0 || number < 0 || number > INT32_MAX)
+    {
+        error("error: invalid number of milliseconds: %s\n", value);
+        return -1;
+    }
+    return number;
+}
+
+/**
+ * Converts a key repeat time to a number of milliseconds.
+ *
+ * @return int The number, or -1 if the value is not a number of milliseconds or is too long.
+ * */
+static int convert_repeat_time(const char* value)
 {
-    // Zero the existing arrays
-    memset(keymap, 0, sizeof(keymap));
-    memset(remap, 0, sizeof(remap));
+    int milliseconds = convert_milliseconds(value);
+    if (milliseconds > UINT16_MAX)
+    {
+        error("error: the repeat time is too long: %s\n", value);
+        return -1;
+    }
+    return milliseconds;
+}
 
-    // Open the configuration file
-    FILE* configuration_file = fopen(configuration_file_path, "r");
-    if (!configuration_file)
+/**
+ * Starts a profile section, the following sections fill the keymap of the profile.
+ *
+ * @return int EXIT_SUCCESS, or EXIT_FAILURE if the profile cannot be added.
+ * */
+static int add_profile(const char* name)
+{
+    if (name[0] == '\0' || strlen(name) >= MAX_PROFILE_NAME)
     {
-        error("error: could not open the configuration file\n");
+        error("error: invalid profile name: %s\n", name);
+        return EXIT_FAILURE;
+    }
+    if (find_profile(name) >= 0)
+    {
+        error("error: duplicate profile: %s\n", name);
+        return EXIT_FAILURE;
+    }
+    if (profile_count == MAX_PROFILES)
+    {
+        error("error: too many profiles, ignoring profile: %s\n", name);
+        return EXIT_FAILURE;
+    }
+    struct tc_profile* profile = &profiles[profile_count];
+    strcpy(profile->name, name);
+    profile->keymap = &profile_keymaps[profile_count - 1];
+    profile->keys_length = 0;
+    init_keymap(profile->keymap);
+    current = profile->keymap;
+    profile_count++;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Finds a profile by name.
+ *
+ * @return int The index of the profile, or -1 if there is no such profile.
+ * */
+int find_profile(const char* name)
+{
+    for (int i = 0; i < profile_count; i++)
+    {
+        if (strcmp(profiles[i].name, name) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Starts a device section, the device is mapped with the profile being read unless it names one.
+ *
+ * @return int EXIT_SUCCESS, or EXIT_FAILURE if there are too many devices.
+ * */
+static int add_device()
+{
+    if (input_device_count == MAX_INPUT_DEVICES)
+    {
+        error("error: too many devices, ignoring the device section\n");
         return EXIT_FAILURE;
     }
-    // Parse the configuration file
+    struct input_device* device = &input_devices[input_device_count];
+    memset(device, 0, sizeof(*device));
+    device->file_descriptor = -1;
+    strcpy(device_profiles[input_device_count], profiles[profile_count - 1].name);
+    device_groups[input_device_count][0] = '\0';
+    input_device_count++;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Resolves the profiles and groups of the devices, and drops the devices that were not found.
+ * Devices with the same profile share its keymap, and the devices of a group
+ * share the engine of its first device.
+ * */
+static void resolve_devices()
+{
+    int count = 0;
+    for (int i = 0; i < input_device_count; i++)
+    {
+        struct input_device device = input_devices[i];
+        if (device.event_path[0] == '\0')
+        {
+            continue;
+        }
+        int duplicate = 0;
+        for (int j = 0; j < count; j++)
+        {
+            duplicate |= strcmp(input_devices[j].event_path, device.event_path) == 0;
+        }
+        if (duplicate)
+        {
+            error("error: ignoring the device configured twice: %s\n", device.event_path);
+            continue;
+        }
+        device.profile = find_profile(device_profiles[i]);
+        if (device.profile < 0)
+        {
+            error("error: unknown profile %s for the device %s\n", device_profiles[i], device.event_path);
+            device.profile = 0;
+        }
+        device.group = count;
+        for (int j = 0; j < count && device_groups[i][0] != '\0'; j++)
+        {
+            if (strcmp(device_groups[j], device_groups[i]) == 0)
+            {
+                device.group = input_devices[j].group;
+                break;
+            }
+        }
+        // The names are kept at the index of the device
+        memmove(device_groups[count], device_groups[i], sizeof(device_groups[count]));
+        input_devices[count++] = device;
+    }
+    input_device_count = count;
+}
+
+/**
+ * Parses a configuration into the keymap and options.
+ * The diagnostics are not rate limited, so every bad line is reported at startup and reload.
+ * */
+int parse_configuration(FILE* configuration_file)
+{
+    // Zero the existing tables, the lines before the first profile section are the default profile
+    current = &keymap;
+    init_keymap(current);
+    strcpy(profiles[0].name, "default");
+    profiles[0].keymap = current;
+    profiles[0].keys_length = 0;
+    profile_count = 1;
+    skipping_profile = 0;
+    input_device_count = 0;
+    reload_quiet_period = DEFAULT_RELOAD_QUIET_PERIOD;
+    metrics_socket_path[0] = '\0';
+    bypass_keys_length = 0;
+    log_level = log_info;
+    log_journal = 0;
+    // The diagnostics of every line are written, the rate limit is for the event loop
+    log_unlimited = 1;
+    section = configuration_none;
+
     char* buffer = NULL;
     size_t length = 0;
     ssize_t result = -1;
@@ -125,26 +439,64 @@ int read_configuration()
         if (line[0] == '[')
         {
             size_t line_length = strlen(line);
-            if (strncmp(line, "[Device]", line_length) == 0)
+            if (strncmp(line, "[Profile ", 9) == 0 && line[line_length - 1] == ']')
+            {
+                line[line_length - 1] = '\0';
+                skipping_profile = add_profile(trim_string(line + 9)) != EXIT_SUCCESS;
+                section = configuration_none;
+                continue;
+            }
+            if (skipping_profile)
+            {
+                section = configuration_invalid;
+                continue;
+            }
+            if (strcmp(line, "[Device]") == 0)
             {
-                section = configuration_device;
+                section = add_device() == EXIT_SUCCESS ? configuration_device : configuration_invalid;
                 continue;
             }
-            if (strncmp(line, "[Remap]", line_length) == 0)
+            if (strcmp(line, "[Remap]") == 0)
             {
                 section = configuration_remap;
                 continue;
             }
-            if (strncmp(line, "[Hyper]", line_length) == 0)
+            if (strcmp(line, "[Hyper]") == 0)
             {
                 section = configuration_hyper;
                 continue;
             }
-            if (strncmp(line, "[Bindings]", line_length) == 0)
+            if (strcmp(line, "[Bindings]") == 0)
             {
                 section = configuration_bindings;
                 continue;
             }
+            if (strcmp(line, "[Modifiers]") == 0)
+            {
+                section = configuration_modifiers;
+                current->modifiers_configured = 1;
+                continue;
+            }
+            if (strcmp(line, "[TapHold]") == 0)
+            {
+                section = configuration_tap_hold;
+                continue;
+            }
+            if (strcmp(line, "[Repeat]") == 0)
+            {
+                section = configuration_repeat;
+                continue;
+            }
+            if (strcmp(line, "[Combos]") == 0)
+            {
+                section = configuration_combos;
+                continue;
+            }
+            if (strcmp(line, "[Options]") == 0)
+            {
+                section = configuration_options;
+                continue;
+            }
             error("error: invalid section: %s\n", line);
             section = configuration_invalid;
             continue;
@@ -154,11 +506,37 @@ int read_configuration()
         {
             case configuration_device:
             {
-                char* name = line;
-                int number = get_device_number(name);
-                if (find_device_event_path(name, number) == EXIT_SUCCESS)
+                // The first name found is the device, the other names are ignored
+                struct input_device* device = &input_devices[input_device_count - 1];
+                if (starts_with(line, "Profile="))
+                {
+                    char* name = trim_string(line + 8);
+                    if (strlen(name) >= MAX_PROFILE_NAME)
+                    {
+                        error("error: invalid profile name: %s\n", name);
+                    }
+                    else
+                    {
+                        strcpy(device_profiles[input_device_count - 1], name);
+                    }
+                }
+                else if (starts_with(line, "Group="))
+                {
+                    char* name = trim_string(line + 6);
+                    if (strlen(name) >= MAX_PROFILE_NAME)
+                    {
+                        error("error: invalid group name: %s\n", name);
+                    }
+                    else
+                    {
+                        strcpy(device_groups[input_device_count - 1], name);
+                    }
+                }
+                else if (device->event_path[0] == '\0')
                 {
-                    section = configuration_none;
+                    char* name = line;
+                    int number = get_device_number(name);
+                    find_device_event_path(name, number, device->event_path);
                 }
                 break;
             }
@@ -166,10 +544,14 @@ int read_configuration()
             {
                 char* tokens = line;
                 char* token = strsep(&tokens, "=");
-                int fromCode = convertKeyStringToCode(token);
+                int fromCode = convert_key(token);
                 token = strsep(&tokens, "=");
-                int toCode = convertKeyStringToCode(token);
-                remap[fromCode] = toCode;
+                int toCode = convert_key(token);
+                if (fromCode == 0 || toCode == 0)
+                {
+                    break;
+                }
+                current->remap[fromCode] = toCode;
                 break;
             }
             case configuration_hyper:
@@ -177,20 +559,326 @@ int read_configuration()
                 char* tokens = line;
                 char* token = strsep(&tokens, "=");
                 token = strsep(&tokens, "=");
-                int code = convertKeyStringToCode(token);
-                hyperKey = code;
+                int code = convert_key(token);
+                if (code == 0)
+                {
+                    break;
+                }
+                current->hyperKey = code;
                 break;
             }
             case configuration_bindings:
             {
                 char* tokens = line;
                 char* token = strsep(&tokens, "=");
-                int fromCode = convertKeyStringToCode(token);
-                int index = 0;
-                while ((token = strsep(&tokens, ",")) != NULL && index < MAX_SEQUENCE)
+                int fromCode = convert_key(token);
+                if (fromCode == 0)
+                {
+                    break;
+                }
+                int offset = current->key_sequences_length;
+                int length = 0;
+                while ((token = strsep(&tokens, ",")) != NULL)
+                {
+                    int count = append_key_token(token);
+                    if (count < 0)
+                    {
+                        length = -1;
+                        break;
+                    }
+                    length += count;
+                }
+                // A binding with a bad token is skipped, the keys appended before it are dropped
+                if (length < 0)
+                {
+                    current->key_sequences_length = offset;
+                    break;
+                }
+                current->key_actions[fromCode].offset = offset;
+                current->key_actions[fromCode].length = length;
+                break;
+            }
+            case configuration_modifiers:
+            {
+                int code = convert_key(line);
+                if (code > 0)
+                {
+                    current->modifiers[code] = 1;
+                }
+                break;
+            }
+            case configuration_combos:
+            {
+                // The line is split in place, the diagnostics name a copy of it
+                char text[256];
+                snprintf(text, sizeof(text), "%s", line);
+                char* tokens = line;
+                char* keys = strsep(&tokens, "=");
+                int codes[MAX_COMBO_KEYS];
+                int count = 0;
+                int unknown = 0;
+                int repeated = 0;
+                char* token;
+                while (count < MAX_COMBO_KEYS && (token = strsep(&keys, "+")) != NULL)
+                {
+                    codes[count] = convert_key(token);
+                    unknown |= codes[count] == 0;
+                    for (int i = 0; i < count; i++)
+                    {
+                        repeated |= codes[i] == codes[count];
+                    }
+                    count++;
+                }
+                if (unknown)
+                {
+                    break;
+                }
+                if (keys != NULL || count < 2)
+                {
+                    error("error: a combo must have between 2 and %i keys: %s\n", MAX_COMBO_KEYS, text);
+                    break;
+                }
+                if (repeated)
+                {
+                    error("error: a combo cannot repeat a key: %s\n", text);
+                    break;
+                }
+                int offset = current->key_sequences_length;
+                int length = 0;
+                while ((token = strsep(&tokens, ",")) != NULL)
+                {
+                    int appended = append_key_token(token);
+                    if (appended < 0)
+                    {
+                        length = -1;
+                        break;
+                    }
+                    length += appended;
+                }
+                if (length < 0 || add_combo(current, codes, count, offset, length) != EXIT_SUCCESS)
+                {
+                    current->key_sequences_length = offset;
+                }
+                break;
+            }
+            case configuration_tap_hold:
+            {
+                char* tokens = line;
+                char* token = strsep(&tokens, "=");
+                int code = convert_key(token);
+                if (code == 0)
+                {
+                    break;
+                }
+                int tap = convertKeyStringToCode(strsep(&tokens, ","));
+                int hold = convertKeyStringToCode(strsep(&tokens, ","));
+                if (tap == 0 || hold == 0)
+                {
+                    error("error: a tap/hold key needs a tap key and a hold key: %s\n", line);
+                    break;
+                }
+                current->tap_holds[code].tap = tap;
+                current->tap_holds[code].hold = hold;
+                break;
+            }
+            case configuration_repeat:
+            {
+                char* tokens = line;
+                char* token = strsep(&tokens, "=");
+                int code = convert_key(token);
+                if (code == 0)
+                {
+                    break;
+                }
+                char* delay = strsep(&tokens, ",");
+                char* interval = strsep(&tokens, ",");
+                char* minimum = strsep(&tokens, ",");
+                if (delay == NULL || interval == NULL)
+                {
+                    error("error: a repeat needs a delay and an interval: %s\n", line);
+                    break;
+                }
+                int milliseconds[3] = { convert_repeat_time(delay), convert_repeat_time(interval), minimum != NULL ? convert_repeat_time(minimum) : 0 };
+                if (milliseconds[0] < 0 || milliseconds[1] < 0 || milliseconds[2] < 0)
+                {
+                    break;
+                }
+                if (milliseconds[1] == 0)
+                {
+                    error("error: the repeat interval cannot be 0: %s\n", line);
+                    break;
+                }
+                current->repeats[code] = (struct key_repeat){ milliseconds[0], milliseconds[1], milliseconds[2] };
+                break;
+            }
+            case configuration_options:
+            {
+                char* tokens = line;
+                char* name = strsep(&tokens, "=");
+                char* value = strsep(&tokens, "=");
+                if (value == NULL)
+                {
+                    error("error: invalid option: %s\n", line);
+                }
+                else if (strcmp(name, "ReloadQuietPeriod") == 0)
+                {
+                    int milliseconds = convert_milliseconds(value);
+                    if (milliseconds >= 0)
+                    {
+                        reload_quiet_period = milliseconds;
+                    }
+                }
+                else if (strcmp(name, "ComboWindow") == 0)
+                {
+                    int milliseconds = convert_milliseconds(value);
+                    if (milliseconds >= 0)
+                    {
+                        current->combo_window = milliseconds;
+                    }
+                }
+                else if (strcmp(name, "TapHoldTerm") == 0)
+                {
+                    int milliseconds = convert_milliseconds(value);
+                    if (milliseconds >= 0)
+                    {
+                        current->tap_hold_term = milliseconds;
+                    }
+                }
+                else if (strcmp(name, "RepeatDelay") == 0)
+                {
+                    int milliseconds = convert_repeat_time(value);
+                    if (milliseconds >= 0)
+                    {
+                        current->repeat.delay = milliseconds;
+                    }
+                }
+                else if (strcmp(name, "RepeatInterval") == 0)
                 {
-                    int toCode = convertKeyStringToCode(token);
-                    keymap[fromCode].sequence[index++] = toCode;
+                    int milliseconds = convert_repeat_time(value);
+                    if (milliseconds == 0)
+                    {
+                        error("error: the repeat interval cannot be 0\n");
+                    }
+                    else if (milliseconds > 0)
+                    {
+                        current->repeat.interval = milliseconds;
+                    }
+                }
+                else if (strcmp(name, "RepeatMinimum") == 0)
+                {
+                    int milliseconds = convert_repeat_time(value);
+                    if (milliseconds >= 0)
+                    {
+                        current->repeat.minimum = milliseconds;
+                    }
+                }
+                else if (strcmp(name, "MetricsSocket") == 0)
+                {
+                    char* path = trim_string(value);
+                    if (strlen(path) >= sizeof(metrics_socket_path))
+                    {
+                        error("error: metrics socket path is too long: %s\n", path);
+                    }
+                    else
+                    {
+                        strcpy(metrics_socket_path, path);
+                    }
+                }
+                else if (strcmp(name, "BypassKeys") == 0)
+                {
+                    int length = 0;
+                    char* token;
+                    while ((token = strsep(&value, "+")) != NULL)
+                    {
+                        int code = convert_key(token);
+                        if (code == 0 || length == MAX_BYPASS_KEYS)
+                        {
+                            error("error: invalid bypass keys\n");
+                            length = 0;
+                            break;
+                        }
+                        bypass_keys[length++] = code;
+                    }
+                    bypass_keys_length = length;
+                }
+                else if (strcmp(name, "ProfileKeys") == 0)
+                {
+                    struct tc_profile* profile = &profiles[profile_count - 1];
+                    int length = 0;
+                    char* token;
+                    while ((token = strsep(&value, "+")) != NULL)
+                    {
+                        int code = convert_key(token);
+                        if (code == 0 || length == MAX_PROFILE_KEYS)
+                        {
+                            error("error: invalid profile keys\n");
+                            length = 0;
+                            break;
+                        }
+                        profile->keys[length++] = code;
+                    }
+                    profile->keys_length = length;
+                }
+                else if (strcmp(name, "LogLevel") == 0)
+                {
+                    if (strcmp(value, "error") == 0)
+                    {
+                        log_level = log_error;
+                    }
+                    else if (strcmp(value, "warning") == 0)
+                    {
+                        log_level = log_warning;
+                    }
+                    else if (strcmp(value, "info") == 0)
+                    {
+                        log_level = log_info;
+                    }
+                    else if (strcmp(value, "debug") == 0)
+                    {
+                        log_level = log_debug;
+                    }
+                    else
+                    {
+                        error("error: unknown log level: %s\n", value);
+                    }
+                }
+                else if (strcmp(name, "LogTarget") == 0)
+                {
+                    if (strcmp(value, "stdout") == 0)
+                    {
+                        log_journal = 0;
+                    }
+                    else if (strcmp(value, "journal") == 0)
+                    {
+                        log_journal = 1;
+                    }
+                    else
+                    {
+                        error("error: unknown log target: %s\n", value);
+                    }
+                }
+                else if (strcmp(name, "TapHoldInterrupt") == 0)
+                {
+                    if (strcmp(value, "tap") == 0)
+                    {
+                        current->tap_hold_interrupt = interrupt_tap;
+                    }
+                    else if (strcmp(value, "hold") == 0)
+                    {
+                        current->tap_hold_interrupt = interrupt_hold;
+                    }
+                    else if (strcmp(value, "permissive") == 0)
+                    {
+                        current->tap_hold_interrupt = interrupt_permissive;
+                    }
+                    else
+                    {
+                        error("error: unknown tap/hold interrupt policy: %s\n", value);
+                    }
+                }
+                else
+                {
+                    error("error: unknown option: %s\n", name);
                 }
                 break;
             }
@@ -206,14 +894,41 @@ int read_configuration()
             }
         }
     }
-    fclose(configuration_file);
     if (buffer)
     {
         free(buffer);
     }
+    for (int i = 0; i < profile_count; i++)
+    {
+        compile_key_actions(profiles[i].keymap);
+    }
+    resolve_devices();
+    log_unlimited = 0;
     return EXIT_SUCCESS;
 }
 
+/**
+ * Reads the configuration file.
+ * The content is read once, the hash recorded for it is the hash of the content parsed.
+ * */
+int read_configuration()
+{
+    size_t length;
+    char* content = read_configuration_content(&length);
+    FILE* configuration_file = content != NULL ? fmemopen(content, length, "r") : NULL;
+    if (!configuration_file)
+    {
+        error("error: could not open the configuration file\n");
+        free(content);
+        return EXIT_FAILURE;
+    }
+    configuration_hash = hash_configuration(content, length);
+    int result = parse_configuration(configuration_file);
+    fclose(configuration_file);
+    free(content);
+    return result;
+}
+
 /**
  * Helper method to print existing keyboard devices.
  * Does not work for bluetooth keyboards.
@@ -1,7 +1,28 @@
 #ifndef config_h
 #define config_h
 
-#define MAX_SEQUENCE 4
+#include <stdint.h>
+#include <stdio.h>
+
+#include "keymap.h"
+
+#define DEFAULT_RELOAD_QUIET_PERIOD 250
+#define MAX_BYPASS_KEYS 4
+#define MAX_PROFILES 8
+#define MAX_PROFILE_NAME 32
+#define MAX_PROFILE_KEYS 4
+
+/**
+ * A named profile, the key tables of one [Profile name] section.
+ * */
+struct tc_profile
+{
+    char name[MAX_PROFILE_NAME];
+    struct tc_keymap* keymap;
+    // The key combination that switches to the profile, empty if there is none
+    int keys[MAX_PROFILE_KEYS];
+    int keys_length;
+};
 
 /**
  * The configuration file path.
@@ -9,29 +30,60 @@
 extern char configuration_file_path[256];
 
 /**
- * The hyper key.
+ * The key tables read from the configuration file.
  * */
-extern int hyperKey;
+extern struct tc_keymap keymap;
 
 /**
- * Map for keys and their conversion.
+ * The profiles read from the configuration file, all compiled when the file is read.
+ * The first is the default profile, the lines before any profile section, whose tables are keymap.
  * */
-struct key_output
-{
-    int sequence[MAX_SEQUENCE];
-};
-extern struct key_output keymap[256];
+extern struct tc_profile profiles[MAX_PROFILES];
+extern int profile_count;
 
 /**
- * Map for permanently remapped keys.
+ * The time to wait after the last configuration file change before reloading, in milliseconds.
  * */
-extern int remap[256];
+extern int reload_quiet_period;
+
+/**
+ * The path of the Unix socket serving the metrics, empty if the metrics are not served.
+ * */
+extern char metrics_socket_path[108];
+
+/**
+ * The key combination that pauses and resumes remapping, empty if there is none.
+ * */
+extern int bypass_keys[MAX_BYPASS_KEYS];
+extern int bypass_keys_length;
+
+/**
+ * The hash of the configuration file content that was last read.
+ * */
+extern uint64_t configuration_hash;
+
+/**
+ * Hashes the content of the configuration file.
+ * */
+int hash_configuration_file(uint64_t* hash);
 
 /**
  * Finds the configuration file location.
  * */
 int find_configuration_file();
 
+/**
+ * Finds a profile by name.
+ *
+ * @return int The index of the profile, or -1 if there is no such profile.
+ * */
+int find_profile(const char* name);
+
+/**
+ * Parses a configuration into the keymap and options.
+ * */
+int parse_configuration(FILE* configuration_file);
+
 /**
  * Reads the configuration file.
  * */
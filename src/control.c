@@ -0,0 +1,248 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "buffers.h"
+#include "control.h"
+
+// The longest command line, longer lines are discarded
+#define CONTROL_LINE_LENGTH 256
+
+int control_file_descriptor = -1;
+int control_client_descriptor = -1;
+
+static char control_path[108] = { '\0' };
+
+// The bytes read from the client that do not form a complete line yet
+static char pending[CONTROL_LINE_LENGTH];
+static size_t pending_length = 0;
+static size_t pending_start = 0;
+static int discarding = 0;
+
+/**
+ * Finds the default control socket path: $XDG_RUNTIME_DIR/touchcursor.control, or /run/user/<uid>/touchcursor.control.
+ * */
+int control_socket_path(char* path, size_t size)
+{
+    const char* directory = getenv("XDG_RUNTIME_DIR");
+    int length = directory != NULL && directory[0] == '/'
+        ? snprintf(path, size, "%s/touchcursor.control", directory)
+        : snprintf(path, size, "/run/user/%u/touchcursor.control", (unsigned int)getuid());
+    return length > 0 && (size_t)length < size ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * Creates the listening control socket at the path, only the real user may connect.
+ *
+ * @remarks
+ * The socket is created with the permissions of the real user, since the
+ * daemon may run set-user-ID root, and its mode is 0600.
+ * A stale socket left at the path is replaced, any other file is kept.
+ * */
+int bind_control_socket(const char* path)
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path))
+    {
+        error("error: control socket path is too long: %s\n", path);
+        return EXIT_FAILURE;
+    }
+    strcpy(address.sun_path, path);
+    control_file_descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (control_file_descriptor < 0)
+    {
+        error("error: failed to create the control socket: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    uid_t effective_user = geteuid();
+    if (seteuid(getuid()) < 0)
+    {
+        error("error: failed to drop privileges for the control socket: %s\n", strerror(errno));
+        release_control_socket();
+        return EXIT_FAILURE;
+    }
+    struct stat status;
+    if (lstat(path, &status) == 0 && S_ISSOCK(status.st_mode))
+    {
+        unlink(path);
+    }
+    mode_t mask = umask(0177);
+    int result = bind(control_file_descriptor, (struct sockaddr*)&address, sizeof(address));
+    int bind_error = errno;
+    umask(mask);
+    if (seteuid(effective_user) < 0)
+    {
+        error("error: failed to restore privileges after the control socket: %s\n", strerror(errno));
+        release_control_socket();
+        return EXIT_FAILURE;
+    }
+    if (result < 0)
+    {
+        error("error: failed to bind the control socket %s: %s\n", path, strerror(bind_error));
+        release_control_socket();
+        return EXIT_FAILURE;
+    }
+    strcpy(control_path, path);
+    if (listen(control_file_descriptor, 4) < 0)
+    {
+        error("error: failed to listen on the control socket: %s\n", strerror(errno));
+        release_control_socket();
+        return EXIT_FAILURE;
+    }
+    log("info: listening for commands on %s\n", path);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Accepts a control client, replacing the connected client.
+ *
+ * @return int The client descriptor, or -1 if no client was waiting.
+ * */
+int accept_control_client()
+{
+    int client = accept4(control_file_descriptor, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (client < 0)
+    {
+        return -1;
+    }
+    close_control_client();
+    control_client_descriptor = client;
+    return client;
+}
+
+/**
+ * Reads the pending commands of the control client.
+ *
+ * @return int EXIT_SUCCESS, or EXIT_FAILURE if the client disconnected.
+ * */
+int read_control_client()
+{
+    // Move the incomplete line to the start of the buffer
+    memmove(pending, pending + pending_start, pending_length - pending_start);
+    pending_length -= pending_start;
+    pending_start = 0;
+    if (pending_length == sizeof(pending))
+    {
+        // The line is too long, it is discarded up to its end
+        pending_length = 0;
+        discarding = 1;
+    }
+    ssize_t result = read(control_client_descriptor, pending + pending_length, sizeof(pending) - pending_length);
+    if (result < 0)
+    {
+        return errno == EAGAIN || errno == EINTR ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (result == 0)
+    {
+        return EXIT_FAILURE;
+    }
+    pending_length += result;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Returns the next complete command line read from the client, without its new line.
+ *
+ * @return char* The command, or NULL if no complete command is pending.
+ * */
+char* next_control_command()
+{
+    while (pending_start < pending_length)
+    {
+        char* line = pending + pending_start;
+        char* end = memchr(line, '\n', pending_length - pending_start);
+        if (end == NULL)
+        {
+            return NULL;
+        }
+        *end = '\0';
+        if (end > line && end[-1] == '\r')
+        {
+            end[-1] = '\0';
+        }
+        pending_start = end + 1 - pending;
+        if (discarding)
+        {
+            discarding = 0;
+            reply_control("error: command too long\n");
+            continue;
+        }
+        return line;
+    }
+    return NULL;
+}
+
+/**
+ * Sends a reply to the control client, without waiting.
+ * A client that does not read its replies loses them.
+ * */
+void reply_control(const char* format, ...)
+{
+    if (control_client_descriptor < 0)
+    {
+        return;
+    }
+    char reply[512];
+    va_list arguments;
+    va_start(arguments, format);
+    int length = vsnprintf(reply, sizeof(reply), format, arguments);
+    va_end(arguments);
+    if (length >= (int)sizeof(reply))
+    {
+        length = sizeof(reply) - 1;
+    }
+    if (length > 0)
+    {
+        send(control_client_descriptor, reply, length, MSG_DONTWAIT | MSG_NOSIGNAL);
+    }
+}
+
+/**
+ * Disconnects the control client.
+ * */
+void close_control_client()
+{
+    if (control_client_descriptor >= 0)
+    {
+        close(control_client_descriptor);
+        control_client_descriptor = -1;
+    }
+    pending_length = 0;
+    pending_start = 0;
+    discarding = 0;
+}
+
+/**
+ * Closes the control socket and removes its path.
+ * */
+void release_control_socket()
+{
+    close_control_client();
+    if (control_file_descriptor >= 0)
+    {
+        close(control_file_descriptor);
+        control_file_descriptor = -1;
+    }
+    if (control_path[0] != '\0')
+    {
+        uid_t effective_user = geteuid();
+        if (seteuid(getuid()) == 0)
+        {
+            unlink(control_path);
+            if (seteuid(effective_user) < 0)
+            {
+                error("error: failed to restore privileges after the control socket: %s\n", strerror(errno));
+            }
+        }
+        control_path[0] = '\0';
+    }
+}
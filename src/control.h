@@ -0,0 +1,62 @@
+#ifndef control_h
+#define control_h
+
+#include <stddef.h>
+
+/**
+ * The listening control socket, -1 if it could not be created.
+ * */
+extern int control_file_descriptor;
+
+/**
+ * The connected control client, -1 if none is connected.
+ * */
+extern int control_client_descriptor;
+
+/**
+ * Finds the default control socket path: $XDG_RUNTIME_DIR/touchcursor.control, or /run/user/<uid>/touchcursor.control.
+ * */
+int control_socket_path(char* path, size_t size);
+
+/**
+ * Creates the listening control socket at the path, only the real user may connect.
+ * */
+int bind_control_socket(const char* path);
+
+/**
+ * Accepts a control client, replacing the connected client.
+ *
+ * @return int The client descriptor, or -1 if no client was waiting.
+ * */
+int accept_control_client();
+
+/**
+ * Reads the pending commands of the control client.
+ *
+ * @return int EXIT_SUCCESS, or EXIT_FAILURE if the client disconnected.
+ * */
+int read_control_client();
+
+/**
+ * Returns the next complete command line read from the client, without its new line.
+ *
+ * @return char* The command, or NULL if no complete command is pending.
+ * */
+char* next_control_command();
+
+/**
+ * Sends a reply to the control client, without waiting.
+ * */
+void reply_control(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * Disconnects the control client.
+ * */
+void close_control_client();
+
+/**
+ * Closes the control socket and removes its path.
+ * */
+void release_control_socket();
+
+#endif
@@ -5,19 +5,38 @@
 
 #include "binding.h"
 #include "emit.h"
+#include "metrics.h"
+#include "probes.h"
+
+// The number of events queued before they are written
+#define EMIT_QUEUE_LENGTH 256
+
+// The events queued for the next write, and whether they end in an open frame
+static struct input_event queued_events[EMIT_QUEUE_LENGTH];
+static int queued_count = 0;
+static int frame_open = 0;
 
 /**
- * Emits a key event.
+ * Tracks the key events written or queued for the output device, in its key state and the metrics.
+ * Every event for the output goes through here, whether the engine sent it or it was passed through.
  * */
-void emit(int type, int code, int value)
+static void track_key_events(const struct input_event* events, int count)
 {
-    if (type == EV_KEY)
+    for (int i = 0; i < count; i++)
     {
-        // TODO: I don't like this here
-        output_device_keystate[code] = value;
+        if (events[i].type == EV_KEY)
+        {
+            output_device_keystate[events[i].code] = events[i].value;
+            metrics.events_emitted++;
+        }
     }
+}
 
-    // printf("emit: code=%i value=%i\n", code, value);
+/**
+ * Emits a key event.
+ * */
+void emit(int type, int code, int value)
+{
     struct input_event e[2];
     memset(e, 0, sizeof(e));
 
@@ -35,5 +54,74 @@ void emit(int type, int code, int value)
     e[1].code = SYN_REPORT;
     // value = 0
 
+    track_key_events(e, 2);
+    PROBE3(emit, type, code, value);
+    flush_events();
+    frame_open = 0;
     write(output_file_descriptor, &e, sizeof(e));
 }
+
+/**
+ * Emits a batch of events with one write.
+ * The batch must contain its own EV_SYN events to end each frame.
+ * */
+void emit_events(const struct input_event* events, int count)
+{
+    track_key_events(events, count);
+    PROBE1(emit_events, count);
+    flush_events();
+    frame_open = count > 0 && (events[count - 1].type != EV_SYN || events[count - 1].code != SYN_REPORT);
+    write(output_file_descriptor, events, count * sizeof(struct input_event));
+}
+
+/**
+ * Queues a batch of events, they are written by the next flush_events, emit or emit_events.
+ * Frames may span several batches, end_frame ends the last one.
+ * */
+void queue_events(const struct input_event* events, int count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    if (queued_count + count > EMIT_QUEUE_LENGTH)
+    {
+        flush_events();
+        if (count > EMIT_QUEUE_LENGTH)
+        {
+            emit_events(events, count);
+            return;
+        }
+    }
+    track_key_events(events, count);
+    memcpy(&queued_events[queued_count], events, count * sizeof(struct input_event));
+    queued_count += count;
+    frame_open = events[count - 1].type != EV_SYN || events[count - 1].code != SYN_REPORT;
+}
+
+/**
+ * Queues a SYN_REPORT if the queued or written events end in an open frame.
+ * Frames the engine sends are already ended, their input SYN_REPORT is dropped.
+ * */
+void end_frame()
+{
+    if (frame_open)
+    {
+        const struct input_event report = { .type = EV_SYN, .code = SYN_REPORT };
+        queue_events(&report, 1);
+    }
+}
+
+/**
+ * Writes the queued events with one write.
+ * */
+void flush_events()
+{
+    if (queued_count == 0)
+    {
+        return;
+    }
+    PROBE1(emit_events, queued_count);
+    write(output_file_descriptor, queued_events, queued_count * sizeof(struct input_event));
+    queued_count = 0;
+}
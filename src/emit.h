@@ -1,9 +1,33 @@
 #ifndef emit_h
 #define emit_h
 
+#include <linux/input.h>
+
 /**
  * Emits a key event.
  * */
 void emit(int type, int code, int value);
 
+/**
+ * Emits a batch of events with one write.
+ * The batch must contain its own EV_SYN events to end each frame.
+ * */
+void emit_events(const struct input_event* events, int count);
+
+/**
+ * Queues a batch of events, they are written by the next flush_events, emit or emit_events.
+ * Frames may span several batches, end_frame ends the last one.
+ * */
+void queue_events(const struct input_event* events, int count);
+
+/**
+ * Queues a SYN_REPORT if the queued or written events end in an open frame.
+ * */
+void end_frame();
+
+/**
+ * Writes the queued events with one write.
+ * */
+void flush_events();
+
 #endif
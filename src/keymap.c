@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "buffers.h"
+#include "keymap.h"
+#include "keys.h"
+
+/**
+ * Initializes a keymap with no bindings and the default options.
+ * The sequence arena of a keymap that was already used is kept for reuse.
+ * */
+void init_keymap(struct tc_keymap* keymap)
+{
+    uint16_t* key_sequences = keymap->key_sequences;
+    int key_sequences_capacity = keymap->key_sequences_capacity;
+    memset(keymap, 0, sizeof(*keymap));
+    keymap->key_sequences = key_sequences;
+    keymap->key_sequences_capacity = key_sequences_capacity;
+    keymap->tap_hold_term = DEFAULT_TAP_HOLD_TERM;
+    keymap->tap_hold_interrupt = interrupt_permissive;
+    keymap->combo_window = DEFAULT_COMBO_WINDOW;
+    keymap->repeat = (struct key_repeat){ DEFAULT_REPEAT_DELAY, DEFAULT_REPEAT_INTERVAL, 0 };
+}
+
+/**
+ * Frees the sequence arena of a keymap.
+ * */
+void free_keymap(struct tc_keymap* keymap)
+{
+    free(keymap->key_sequences);
+    keymap->key_sequences = NULL;
+    keymap->key_sequences_length = 0;
+    keymap->key_sequences_capacity = 0;
+}
+
+/**
+ * Appends a code to key_sequences, growing the arena as needed.
+ * */
+int append_key_sequence(struct tc_keymap* keymap, int code)
+{
+    if (keymap->key_sequences_length >= UINT16_MAX)
+    {
+        error("error: too many key bindings\n");
+        return EXIT_FAILURE;
+    }
+    if (keymap->key_sequences_length == keymap->key_sequences_capacity)
+    {
+        int capacity = keymap->key_sequences_capacity ? keymap->key_sequences_capacity * 2 : 256;
+        uint16_t* sequences = realloc(keymap->key_sequences, capacity * sizeof(uint16_t));
+        if (!sequences)
+        {
+            error("error: could not allocate the key sequences\n");
+            return EXIT_FAILURE;
+        }
+        keymap->key_sequences = sequences;
+        keymap->key_sequences_capacity = capacity;
+    }
+    keymap->key_sequences[keymap->key_sequences_length++] = code;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Appends an output sequence to key_sequences.
+ *
+ * @return int The offset of the sequence, or -1 on failure.
+ * */
+int add_key_sequence(struct tc_keymap* keymap, const int* sequence, int length)
+{
+    int offset = keymap->key_sequences_length;
+    for (int i = 0; i < length; i++)
+    {
+        if (append_key_sequence(keymap, sequence[i]) != EXIT_SUCCESS)
+        {
+            keymap->key_sequences_length = offset;
+            return -1;
+        }
+    }
+    return offset;
+}
+
+/**
+ * Binds a key to an output sequence of any length.
+ * The sequence is appended to key_sequences.
+ * */
+int bind_key_sequence(struct tc_keymap* keymap, int code, const int* sequence, int length)
+{
+    int offset = add_key_sequence(keymap, sequence, length);
+    if (offset < 0)
+    {
+        return EXIT_FAILURE;
+    }
+    keymap->key_actions[code].offset = offset;
+    keymap->key_actions[code].length = length;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Removes all key bindings and empties key_sequences.
+ * */
+void clear_key_sequences(struct tc_keymap* keymap)
+{
+    memset(keymap->key_actions, 0, sizeof(keymap->key_actions));
+    keymap->key_sequences_length = 0;
+}
+
+/**
+ * Compiles the hyper key, remap, modifiers, tap/hold keys and combos into key_actions.
+ * The sequence offsets and lengths are set when keys are bound.
+ * */
+void compile_key_actions(struct tc_keymap* keymap)
+{
+    for (int code = 0; code < KEY_CNT; code++)
+    {
+        struct key_action* action = &keymap->key_actions[code];
+        action->flags = 0;
+        action->combo = 0;
+        action->remap = keymap->remap[code] != 0 ? keymap->remap[code] : code;
+        if (code == keymap->hyperKey && keymap->hyperKey != 0)
+        {
+            action->flags |= KEY_ACTION_HYPER;
+        }
+        if (keymap->modifiers_configured ? keymap->modifiers[code] : isModifier(code))
+        {
+            action->flags |= KEY_ACTION_MODIFIER;
+        }
+        if (isKeypad(code))
+        {
+            action->flags |= KEY_ACTION_KEYPAD;
+        }
+        if (action->length > 0)
+        {
+            action->flags |= KEY_ACTION_MAPPED;
+        }
+        if (keymap->tap_holds[code].tap != 0)
+        {
+            action->flags |= KEY_ACTION_TAPHOLD;
+        }
+    }
+    compile_combos(keymap);
+}
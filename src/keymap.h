@@ -0,0 +1,146 @@
+#ifndef keymap_h
+#define keymap_h
+
+#include <linux/input.h>
+#include <stdint.h>
+
+#include "combo.h"
+
+#define DEFAULT_TAP_HOLD_TERM 200
+#define DEFAULT_REPEAT_DELAY 250
+#define DEFAULT_REPEAT_INTERVAL 33
+
+/**
+ * Tap/hold keys, which emit one key when tapped and another when held.
+ * */
+struct tap_hold
+{
+    uint16_t tap;
+    uint16_t hold;
+};
+
+/**
+ * The key repeat of a mapped key, in milliseconds.
+ * The interval shortens by a sixteenth at each repeat down to the minimum, a
+ * minimum of 0 repeats at a constant interval.
+ * */
+struct key_repeat
+{
+    uint16_t delay;
+    uint16_t interval;
+    uint16_t minimum;
+};
+
+/**
+ * How other keys pressed while a tap/hold key is undecided affect the decision.
+ * */
+enum tap_hold_interrupts
+{
+    interrupt_tap,        // Other keys do not decide, the key is held only after the term
+    interrupt_hold,       // Pressing another key decides hold
+    interrupt_permissive  // Pressing and releasing another key decides hold
+};
+
+/**
+ * Flags of a key action.
+ * */
+#define KEY_ACTION_HYPER 0x01
+#define KEY_ACTION_MAPPED 0x02
+#define KEY_ACTION_MODIFIER 0x04
+#define KEY_ACTION_KEYPAD 0x08
+#define KEY_ACTION_COMBO 0x10
+#define KEY_ACTION_TAPHOLD 0x20
+
+/**
+ * The compiled action for an input key code.
+ * One load answers every question the mapper asks about a key.
+ * */
+struct key_action
+{
+    uint8_t flags;
+    uint8_t combo;    // The bit of the key in combo key sets
+    uint16_t remap;   // The remapped code, or the code itself if it is not remapped
+    uint16_t offset;  // The offset of the mapped sequence in key_sequences
+    uint16_t length;  // The length of the mapped sequence
+};
+
+/**
+ * Flags a code in a sequence as a modifier of the chord that ends with the next code.
+ * */
+#define SEQUENCE_CHORD 0x8000
+
+/**
+ * The key tables of a configuration.
+ * The tables are filled, then compiled with compile_key_actions. Engines
+ * only read a compiled keymap, so one keymap can be shared by many engines.
+ * */
+struct tc_keymap
+{
+    // The hyper key
+    int hyperKey;
+    // Map for permanently remapped keys
+    int remap[KEY_CNT];
+    // The keys that do not emit the hyper key, if configured
+    unsigned char modifiers[KEY_CNT];
+    int modifiers_configured;
+    // The compiled action of each key
+    struct key_action key_actions[KEY_CNT];
+    // The mapped sequences of all keys and combos, stored contiguously
+    uint16_t* key_sequences;
+    int key_sequences_length;
+    int key_sequences_capacity;
+    // The tap/hold keys, the term in milliseconds and the interrupt policy
+    struct tap_hold tap_holds[KEY_CNT];
+    int tap_hold_term;
+    enum tap_hold_interrupts tap_hold_interrupt;
+    // The key repeat of mapped keys, a delay of 0 leaves the repeat to the input device
+    struct key_repeat repeat;
+    // The key repeat of single mapped keys, used instead when its delay is set
+    struct key_repeat repeats[KEY_CNT];
+    // The combos, the combo window in milliseconds and the match table
+    struct combo combos[MAX_COMBOS];
+    int combo_count;
+    int combo_window;
+    struct combo_match combo_matches[COMBO_MATCH_TABLE_SIZE];
+};
+
+/**
+ * Initializes a keymap with no bindings and the default options.
+ * The sequence arena of a keymap that was already used is kept for reuse.
+ * */
+void init_keymap(struct tc_keymap* keymap);
+
+/**
+ * Frees the sequence arena of a keymap.
+ * */
+void free_keymap(struct tc_keymap* keymap);
+
+/**
+ * Appends a code to key_sequences, growing the arena as needed.
+ * */
+int append_key_sequence(struct tc_keymap* keymap, int code);
+
+/**
+ * Appends an output sequence to key_sequences.
+ *
+ * @return int The offset of the sequence, or -1 on failure.
+ * */
+int add_key_sequence(struct tc_keymap* keymap, const int* sequence, int length);
+
+/**
+ * Binds a key to an output sequence of any length.
+ * The sequence is appended to key_sequences.
+ * */
+int bind_key_sequence(struct tc_keymap* keymap, int code, const int* sequence, int length);
+
+/**
+ * Removes all key bindings and empties key_sequences.
+ * */
+void clear_key_sequences(struct tc_keymap* keymap);
+
+/**
+ * Compiles the hyper key, remap, modifiers, tap/hold keys and combos into key_actions.
+ * */
+void compile_key_actions(struct tc_keymap* keymap);
+
+#endif
@@ -1,932 +1,977 @@
 #include <linux/uinput.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "keys.h"
 
+/**
+ * A key name and its code.
+ * */
+struct key_name
+{
+    const char* name;
+    int code;
+};
+
+/**
+ * The key names, with and without the KEY_ prefix.
+ * The names are sorted (as by strcmp) for the binary search.
+ * */
+static const struct key_name key_names[] = {
+    { "'", KEY_APOSTROPHE },
+    { ",", KEY_COMMA },
+    { "-", KEY_MINUS },
+    { ".", KEY_DOT },
+    { "/", KEY_SLASH },
+    { "0", KEY_0 },
+    { "1", KEY_1 },
+    { "102ND", KEY_102ND },
+    { "10CHANNELSDOWN", KEY_10CHANNELSDOWN },
+    { "10CHANNELSUP", KEY_10CHANNELSUP },
+    { "2", KEY_2 },
+    { "3", KEY_3 },
+    { "4", KEY_4 },
+    { "5", KEY_5 },
+    { "6", KEY_6 },
+    { "7", KEY_7 },
+    { "8", KEY_8 },
+    { "9", KEY_9 },
+    { ";", KEY_SEMICOLON },
+    { "A", KEY_A },
+    { "AB", KEY_AB },
+    { "ADDRESSBOOK", KEY_ADDRESSBOOK },
+    { "AGAIN", KEY_AGAIN },
+    { "ALS_TOGGLE", KEY_ALS_TOGGLE },
+    { "ALTERASE", KEY_ALTERASE },
+    { "ANGLE", KEY_ANGLE },
+    { "APOSTROPHE", KEY_APOSTROPHE },
+    { "ARCHIVE", KEY_ARCHIVE },
+    { "ASPECT_RATIO", KEY_ASPECT_RATIO },
+    { "ATTENDANT_OFF", KEY_ATTENDANT_OFF },
+    { "ATTENDANT_ON", KEY_ATTENDANT_ON },
+    { "ATTENDANT_TOGGLE", KEY_ATTENDANT_TOGGLE },
+    { "AUDIO", KEY_AUDIO },
+    { "AUX", KEY_AUX },
+    { "B", KEY_B },
+    { "BACK", KEY_BACK },
+    { "BACKSLASH", KEY_BACKSLASH },
+    { "BACKSPACE", KEY_BACKSPACE },
+    { "BASSBOOST", KEY_BASSBOOST },
+    { "BATTERY", KEY_BATTERY },
+    { "BLUE", KEY_BLUE },
+    { "BLUETOOTH", KEY_BLUETOOTH },
+    { "BOOKMARKS", KEY_BOOKMARKS },
+    { "BREAK", KEY_BREAK },
+    { "BRIGHTNESSDOWN", KEY_BRIGHTNESSDOWN },
+    { "BRIGHTNESSUP", KEY_BRIGHTNESSUP },
+    { "BRIGHTNESS_AUTO", KEY_BRIGHTNESS_AUTO },
+    { "BRIGHTNESS_CYCLE", KEY_BRIGHTNESS_CYCLE },
+    { "BRIGHTNESS_TOGGLE", KEY_BRIGHTNESS_TOGGLE },
+    { "BRIGHTNESS_ZERO", KEY_BRIGHTNESS_ZERO },
+    { "BRL_DOT1", KEY_BRL_DOT1 },
+    { "BRL_DOT10", KEY_BRL_DOT10 },
+    { "BRL_DOT2", KEY_BRL_DOT2 },
+    { "BRL_DOT3", KEY_BRL_DOT3 },
+    { "BRL_DOT4", KEY_BRL_DOT4 },
+    { "BRL_DOT5", KEY_BRL_DOT5 },
+    { "BRL_DOT6", KEY_BRL_DOT6 },
+    { "BRL_DOT7", KEY_BRL_DOT7 },
+    { "BRL_DOT8", KEY_BRL_DOT8 },
+    { "BRL_DOT9", KEY_BRL_DOT9 },
+    { "BTN_0", BTN_0 },
+    { "BTN_1", BTN_1 },
+    { "BTN_2", BTN_2 },
+    { "BTN_3", BTN_3 },
+    { "BTN_4", BTN_4 },
+    { "BTN_5", BTN_5 },
+    { "BTN_6", BTN_6 },
+    { "BTN_7", BTN_7 },
+    { "BTN_8", BTN_8 },
+    { "BTN_9", BTN_9 },
+    { "BTN_A", BTN_A },
+    { "BTN_B", BTN_B },
+    { "BTN_BACK", BTN_BACK },
+    { "BTN_BASE", BTN_BASE },
+    { "BTN_BASE2", BTN_BASE2 },
+    { "BTN_BASE3", BTN_BASE3 },
+    { "BTN_BASE4", BTN_BASE4 },
+    { "BTN_BASE5", BTN_BASE5 },
+    { "BTN_BASE6", BTN_BASE6 },
+    { "BTN_C", BTN_C },
+    { "BTN_DEAD", BTN_DEAD },
+    { "BTN_DIGI", BTN_DIGI },
+    { "BTN_DPAD_DOWN", BTN_DPAD_DOWN },
+    { "BTN_DPAD_LEFT", BTN_DPAD_LEFT },
+    { "BTN_DPAD_RIGHT", BTN_DPAD_RIGHT },
+    { "BTN_DPAD_UP", BTN_DPAD_UP },
+    { "BTN_EAST", BTN_EAST },
+    { "BTN_EXTRA", BTN_EXTRA },
+    { "BTN_FORWARD", BTN_FORWARD },
+    { "BTN_GAMEPAD", BTN_GAMEPAD },
+    { "BTN_GEAR_DOWN", BTN_GEAR_DOWN },
+    { "BTN_GEAR_UP", BTN_GEAR_UP },
+    { "BTN_JOYSTICK", BTN_JOYSTICK },
+    { "BTN_LEFT", BTN_LEFT },
+    { "BTN_MIDDLE", BTN_MIDDLE },
+    { "BTN_MISC", BTN_MISC },
+    { "BTN_MODE", BTN_MODE },
+    { "BTN_MOUSE", BTN_MOUSE },
+    { "BTN_NORTH", BTN_NORTH },
+    { "BTN_PINKIE", BTN_PINKIE },
+    { "BTN_RIGHT", BTN_RIGHT },
+    { "BTN_SELECT", BTN_SELECT },
+    { "BTN_SIDE", BTN_SIDE },
+    { "BTN_SOUTH", BTN_SOUTH },
+    { "BTN_START", BTN_START },
+    { "BTN_STYLUS", BTN_STYLUS },
+    { "BTN_STYLUS2", BTN_STYLUS2 },
+    { "BTN_STYLUS3", BTN_STYLUS3 },
+    { "BTN_TASK", BTN_TASK },
+    { "BTN_THUMB", BTN_THUMB },
+    { "BTN_THUMB2", BTN_THUMB2 },
+    { "BTN_THUMBL", BTN_THUMBL },
+    { "BTN_THUMBR", BTN_THUMBR },
+    { "BTN_TL", BTN_TL },
+    { "BTN_TL2", BTN_TL2 },
+    { "BTN_TOOL_AIRBRUSH", BTN_TOOL_AIRBRUSH },
+    { "BTN_TOOL_BRUSH", BTN_TOOL_BRUSH },
+    { "BTN_TOOL_DOUBLETAP", BTN_TOOL_DOUBLETAP },
+    { "BTN_TOOL_FINGER", BTN_TOOL_FINGER },
+    { "BTN_TOOL_LENS", BTN_TOOL_LENS },
+    { "BTN_TOOL_MOUSE", BTN_TOOL_MOUSE },
+    { "BTN_TOOL_PEN", BTN_TOOL_PEN },
+    { "BTN_TOOL_PENCIL", BTN_TOOL_PENCIL },
+    { "BTN_TOOL_QUADTAP", BTN_TOOL_QUADTAP },
+    { "BTN_TOOL_QUINTTAP", BTN_TOOL_QUINTTAP },
+    { "BTN_TOOL_RUBBER", BTN_TOOL_RUBBER },
+    { "BTN_TOOL_TRIPLETAP", BTN_TOOL_TRIPLETAP },
+    { "BTN_TOP", BTN_TOP },
+    { "BTN_TOP2", BTN_TOP2 },
+    { "BTN_TOUCH", BTN_TOUCH },
+    { "BTN_TR", BTN_TR },
+    { "BTN_TR2", BTN_TR2 },
+    { "BTN_TRIGGER", BTN_TRIGGER },
+    { "BTN_WEST", BTN_WEST },
+    { "BTN_WHEEL", BTN_WHEEL },
+    { "BTN_X", BTN_X },
+    { "BTN_Y", BTN_Y },
+    { "BTN_Z", BTN_Z },
+    { "C", KEY_C },
+    { "CALC", KEY_CALC },
+    { "CALENDAR", KEY_CALENDAR },
+    { "CAMERA", KEY_CAMERA },
+    { "CAMERA_DOWN", KEY_CAMERA_DOWN },
+    { "CAMERA_FOCUS", KEY_CAMERA_FOCUS },
+    { "CAMERA_LEFT", KEY_CAMERA_LEFT },
+    { "CAMERA_RIGHT", KEY_CAMERA_RIGHT },
+    { "CAMERA_UP", KEY_CAMERA_UP },
+    { "CAMERA_ZOOMIN", KEY_CAMERA_ZOOMIN },
+    { "CAMERA_ZOOMOUT", KEY_CAMERA_ZOOMOUT },
+    { "CANCEL", KEY_CANCEL },
+    { "CAPSLOCK", KEY_CAPSLOCK },
+    { "CD", KEY_CD },
+    { "CHANNEL", KEY_CHANNEL },
+    { "CHANNELDOWN", KEY_CHANNELDOWN },
+    { "CHANNELUP", KEY_CHANNELUP },
+    { "CHAT", KEY_CHAT },
+    { "CLEAR", KEY_CLEAR },
+    { "CLOSE", KEY_CLOSE },
+    { "CLOSECD", KEY_CLOSECD },
+    { "COFFEE", KEY_COFFEE },
+    { "COMMA", KEY_COMMA },
+    { "COMPOSE", KEY_COMPOSE },
+    { "COMPUTER", KEY_COMPUTER },
+    { "CONFIG", KEY_CONFIG },
+    { "CONNECT", KEY_CONNECT },
+    { "CONTEXT_MENU", KEY_CONTEXT_MENU },
+    { "COPY", KEY_COPY },
+    { "CUT", KEY_CUT },
+    { "CYCLEWINDOWS", KEY_CYCLEWINDOWS },
+    { "D", KEY_D },
+    { "DASHBOARD", KEY_DASHBOARD },
+    { "DATABASE", KEY_DATABASE },
+    { "DELETE", KEY_DELETE },
+    { "DELETEFILE", KEY_DELETEFILE },
+    { "DEL_EOL", KEY_DEL_EOL },
+    { "DEL_EOS", KEY_DEL_EOS },
+    { "DEL_LINE", KEY_DEL_LINE },
+    { "DIGITS", KEY_DIGITS },
+    { "DIRECTION", KEY_DIRECTION },
+    { "DIRECTORY", KEY_DIRECTORY },
+    { "DISPLAYTOGGLE", KEY_DISPLAYTOGGLE },
+    { "DISPLAY_OFF", KEY_DISPLAY_OFF },
+    { "DOCUMENTS", KEY_DOCUMENTS },
+    { "DOLLAR", KEY_DOLLAR },
+    { "DOT", KEY_DOT },
+    { "DOWN", KEY_DOWN },
+    { "DVD", KEY_DVD },
+    { "E", KEY_E },
+    { "EDIT", KEY_EDIT },
+    { "EDITOR", KEY_EDITOR },
+    { "EJECTCD", KEY_EJECTCD },
+    { "EJECTCLOSECD", KEY_EJECTCLOSECD },
+    { "EMAIL", KEY_EMAIL },
+    { "END", KEY_END },
+    { "ENTER", KEY_ENTER },
+    { "EPG", KEY_EPG },
+    { "EQUAL", KEY_EQUAL },
+    { "ESC", KEY_ESC },
+    { "EURO", KEY_EURO },
+    { "EXIT", KEY_EXIT },
+    { "F", KEY_F },
+    { "F1", KEY_F1 },
+    { "F10", KEY_F10 },
+    { "F11", KEY_F11 },
+    { "F12", KEY_F12 },
+    { "F13", KEY_F13 },
+    { "F14", KEY_F14 },
+    { "F15", KEY_F15 },
+    { "F16", KEY_F16 },
+    { "F17", KEY_F17 },
+    { "F18", KEY_F18 },
+    { "F19", KEY_F19 },
+    { "F2", KEY_F2 },
+    { "F20", KEY_F20 },
+    { "F21", KEY_F21 },
+    { "F22", KEY_F22 },
+    { "F23", KEY_F23 },
+    { "F24", KEY_F24 },
+    { "F3", KEY_F3 },
+    { "F4", KEY_F4 },
+    { "F5", KEY_F5 },
+    { "F6", KEY_F6 },
+    { "F7", KEY_F7 },
+    { "F8", KEY_F8 },
+    { "F9", KEY_F9 },
+    { "FASTFORWARD", KEY_FASTFORWARD },
+    { "FAVORITES", KEY_FAVORITES },
+    { "FILE", KEY_FILE },
+    { "FINANCE", KEY_FINANCE },
+    { "FIND", KEY_FIND },
+    { "FIRST", KEY_FIRST },
+    { "FN", KEY_FN },
+    { "FN_1", KEY_FN_1 },
+    { "FN_2", KEY_FN_2 },
+    { "FN_B", KEY_FN_B },
+    { "FN_D", KEY_FN_D },
+    { "FN_E", KEY_FN_E },
+    { "FN_ESC", KEY_FN_ESC },
+    { "FN_F", KEY_FN_F },
+    { "FN_F1", KEY_FN_F1 },
+    { "FN_F10", KEY_FN_F10 },
+    { "FN_F11", KEY_FN_F11 },
+    { "FN_F12", KEY_FN_F12 },
+    { "FN_F2", KEY_FN_F2 },
+    { "FN_F3", KEY_FN_F3 },
+    { "FN_F4", KEY_FN_F4 },
+    { "FN_F5", KEY_FN_F5 },
+    { "FN_F6", KEY_FN_F6 },
+    { "FN_F7", KEY_FN_F7 },
+    { "FN_F8", KEY_FN_F8 },
+    { "FN_F9", KEY_FN_F9 },
+    { "FN_RIGHT_SHIFT", KEY_FN_RIGHT_SHIFT },
+    { "FN_S", KEY_FN_S },
+    { "FORWARD", KEY_FORWARD },
+    { "FORWARDMAIL", KEY_FORWARDMAIL },
+    { "FRAMEBACK", KEY_FRAMEBACK },
+    { "FRAMEFORWARD", KEY_FRAMEFORWARD },
+    { "FRONT", KEY_FRONT },
+    { "FULL_SCREEN", KEY_FULL_SCREEN },
+    { "G", KEY_G },
+    { "GAMES", KEY_GAMES },
+    { "GOTO", KEY_GOTO },
+    { "GRAPHICSEDITOR", KEY_GRAPHICSEDITOR },
+    { "GRAVE", KEY_GRAVE },
+    { "GREEN", KEY_GREEN },
+    { "H", KEY_H },
+    { "HANGEUL", KEY_HANGEUL },
+    { "HANGUEL", KEY_HANGUEL },
+    { "HANGUP_PHONE", KEY_HANGUP_PHONE },
+    { "HANJA", KEY_HANJA },
+    { "HELP", KEY_HELP },
+    { "HENKAN", KEY_HENKAN },
+    { "HIRAGANA", KEY_HIRAGANA },
+    { "HOME", KEY_HOME },
+    { "HOMEPAGE", KEY_HOMEPAGE },
+    { "HP", KEY_HP },
+    { "I", KEY_I },
+    { "IMAGES", KEY_IMAGES },
+    { "INFO", KEY_INFO },
+    { "INSERT", KEY_INSERT },
+    { "INS_LINE", KEY_INS_LINE },
+    { "ISO", KEY_ISO },
+    { "J", KEY_J },
+    { "K", KEY_K },
+    { "KATAKANA", KEY_KATAKANA },
+    { "KATAKANAHIRAGANA", KEY_KATAKANAHIRAGANA },
+    { "KBDILLUMDOWN", KEY_KBDILLUMDOWN },
+    { "KBDILLUMTOGGLE", KEY_KBDILLUMTOGGLE },
+    { "KBDILLUMUP", KEY_KBDILLUMUP },
+    { "KEYBOARD", KEY_KEYBOARD },
+    { "KEY_0", KEY_0 },
+    { "KEY_1", KEY_1 },
+    { "KEY_102ND", KEY_102ND },
+    { "KEY_10CHANNELSDOWN", KEY_10CHANNELSDOWN },
+    { "KEY_10CHANNELSUP", KEY_10CHANNELSUP },
+    { "KEY_2", KEY_2 },
+    { "KEY_3", KEY_3 },
+    { "KEY_4", KEY_4 },
+    { "KEY_5", KEY_5 },
+    { "KEY_6", KEY_6 },
+    { "KEY_7", KEY_7 },
+    { "KEY_8", KEY_8 },
+    { "KEY_9", KEY_9 },
+    { "KEY_A", KEY_A },
+    { "KEY_AB", KEY_AB },
+    { "KEY_ADDRESSBOOK", KEY_ADDRESSBOOK },
+    { "KEY_AGAIN", KEY_AGAIN },
+    { "KEY_ALS_TOGGLE", KEY_ALS_TOGGLE },
+    { "KEY_ALTERASE", KEY_ALTERASE },
+    { "KEY_ANGLE", KEY_ANGLE },
+    { "KEY_APOSTROPHE", KEY_APOSTROPHE },
+    { "KEY_ARCHIVE", KEY_ARCHIVE },
+    { "KEY_ASPECT_RATIO", KEY_ASPECT_RATIO },
+    { "KEY_ATTENDANT_OFF", KEY_ATTENDANT_OFF },
+    { "KEY_ATTENDANT_ON", KEY_ATTENDANT_ON },
+    { "KEY_ATTENDANT_TOGGLE", KEY_ATTENDANT_TOGGLE },
+    { "KEY_AUDIO", KEY_AUDIO },
+    { "KEY_AUX", KEY_AUX },
+    { "KEY_B", KEY_B },
+    { "KEY_BACK", KEY_BACK },
+    { "KEY_BACKSLASH", KEY_BACKSLASH },
+    { "KEY_BACKSPACE", KEY_BACKSPACE },
+    { "KEY_BASSBOOST", KEY_BASSBOOST },
+    { "KEY_BATTERY", KEY_BATTERY },
+    { "KEY_BLUE", KEY_BLUE },
+    { "KEY_BLUETOOTH", KEY_BLUETOOTH },
+    { "KEY_BOOKMARKS", KEY_BOOKMARKS },
+    { "KEY_BREAK", KEY_BREAK },
+    { "KEY_BRIGHTNESSDOWN", KEY_BRIGHTNESSDOWN },
+    { "KEY_BRIGHTNESSUP", KEY_BRIGHTNESSUP },
+    { "KEY_BRIGHTNESS_AUTO", KEY_BRIGHTNESS_AUTO },
+    { "KEY_BRIGHTNESS_CYCLE", KEY_BRIGHTNESS_CYCLE },
+    { "KEY_BRIGHTNESS_TOGGLE", KEY_BRIGHTNESS_TOGGLE },
+    { "KEY_BRIGHTNESS_ZERO", KEY_BRIGHTNESS_ZERO },
+    { "KEY_BRL_DOT1", KEY_BRL_DOT1 },
+    { "KEY_BRL_DOT10", KEY_BRL_DOT10 },
+    { "KEY_BRL_DOT2", KEY_BRL_DOT2 },
+    { "KEY_BRL_DOT3", KEY_BRL_DOT3 },
+    { "KEY_BRL_DOT4", KEY_BRL_DOT4 },
+    { "KEY_BRL_DOT5", KEY_BRL_DOT5 },
+    { "KEY_BRL_DOT6", KEY_BRL_DOT6 },
+    { "KEY_BRL_DOT7", KEY_BRL_DOT7 },
+    { "KEY_BRL_DOT8", KEY_BRL_DOT8 },
+    { "KEY_BRL_DOT9", KEY_BRL_DOT9 },
+    { "KEY_C", KEY_C },
+    { "KEY_CALC", KEY_CALC },
+    { "KEY_CALENDAR", KEY_CALENDAR },
+    { "KEY_CAMERA", KEY_CAMERA },
+    { "KEY_CAMERA_DOWN", KEY_CAMERA_DOWN },
+    { "KEY_CAMERA_FOCUS", KEY_CAMERA_FOCUS },
+    { "KEY_CAMERA_LEFT", KEY_CAMERA_LEFT },
+    { "KEY_CAMERA_RIGHT", KEY_CAMERA_RIGHT },
+    { "KEY_CAMERA_UP", KEY_CAMERA_UP },
+    { "KEY_CAMERA_ZOOMIN", KEY_CAMERA_ZOOMIN },
+    { "KEY_CAMERA_ZOOMOUT", KEY_CAMERA_ZOOMOUT },
+    { "KEY_CANCEL", KEY_CANCEL },
+    { "KEY_CAPSLOCK", KEY_CAPSLOCK },
+    { "KEY_CD", KEY_CD },
+    { "KEY_CHANNEL", KEY_CHANNEL },
+    { "KEY_CHANNELDOWN", KEY_CHANNELDOWN },
+    { "KEY_CHANNELUP", KEY_CHANNELUP },
+    { "KEY_CHAT", KEY_CHAT },
+    { "KEY_CLEAR", KEY_CLEAR },
+    { "KEY_CLOSE", KEY_CLOSE },
+    { "KEY_CLOSECD", KEY_CLOSECD },
+    { "KEY_COFFEE", KEY_COFFEE },
+    { "KEY_COMMA", KEY_COMMA },
+    { "KEY_COMPOSE", KEY_COMPOSE },
+    { "KEY_COMPUTER", KEY_COMPUTER },
+    { "KEY_CONFIG", KEY_CONFIG },
+    { "KEY_CONNECT", KEY_CONNECT },
+    { "KEY_CONTEXT_MENU", KEY_CONTEXT_MENU },
+    { "KEY_COPY", KEY_COPY },
+    { "KEY_CUT", KEY_CUT },
+    { "KEY_CYCLEWINDOWS", KEY_CYCLEWINDOWS },
+    { "KEY_D", KEY_D },
+    { "KEY_DASHBOARD", KEY_DASHBOARD },
+    { "KEY_DATABASE", KEY_DATABASE },
+    { "KEY_DELETE", KEY_DELETE },
+    { "KEY_DELETEFILE", KEY_DELETEFILE },
+    { "KEY_DEL_EOL", KEY_DEL_EOL },
+    { "KEY_DEL_EOS", KEY_DEL_EOS },
+    { "KEY_DEL_LINE", KEY_DEL_LINE },
+    { "KEY_DIGITS", KEY_DIGITS },
+    { "KEY_DIRECTION", KEY_DIRECTION },
+    { "KEY_DIRECTORY", KEY_DIRECTORY },
+    { "KEY_DISPLAYTOGGLE", KEY_DISPLAYTOGGLE },
+    { "KEY_DISPLAY_OFF", KEY_DISPLAY_OFF },
+    { "KEY_DOCUMENTS", KEY_DOCUMENTS },
+    { "KEY_DOLLAR", KEY_DOLLAR },
+    { "KEY_DOT", KEY_DOT },
+    { "KEY_DOWN", KEY_DOWN },
+    { "KEY_DVD", KEY_DVD },
+    { "KEY_E", KEY_E },
+    { "KEY_EDIT", KEY_EDIT },
+    { "KEY_EDITOR", KEY_EDITOR },
+    { "KEY_EJECTCD", KEY_EJECTCD },
+    { "KEY_EJECTCLOSECD", KEY_EJECTCLOSECD },
+    { "KEY_EMAIL", KEY_EMAIL },
+    { "KEY_END", KEY_END },
+    { "KEY_ENTER", KEY_ENTER },
+    { "KEY_EPG", KEY_EPG },
+    { "KEY_EQUAL", KEY_EQUAL },
+    { "KEY_ESC", KEY_ESC },
+    { "KEY_EURO", KEY_EURO },
+    { "KEY_EXIT", KEY_EXIT },
+    { "KEY_F", KEY_F },
+    { "KEY_F1", KEY_F1 },
+    { "KEY_F10", KEY_F10 },
+    { "KEY_F11", KEY_F11 },
+    { "KEY_F12", KEY_F12 },
+    { "KEY_F13", KEY_F13 },
+    { "KEY_F14", KEY_F14 },
+    { "KEY_F15", KEY_F15 },
+    { "KEY_F16", KEY_F16 },
+    { "KEY_F17", KEY_F17 },
+    { "KEY_F18", KEY_F18 },
+    { "KEY_F19", KEY_F19 },
+    { "KEY_F2", KEY_F2 },
+    { "KEY_F20", KEY_F20 },
+    { "KEY_F21", KEY_F21 },
+    { "KEY_F22", KEY_F22 },
+    { "KEY_F23", KEY_F23 },
+    { "KEY_F24", KEY_F24 },
+    { "KEY_F3", KEY_F3 },
+    { "KEY_F4", KEY_F4 },
+    { "KEY_F5", KEY_F5 },
+    { "KEY_F6", KEY_F6 },
+    { "KEY_F7", KEY_F7 },
+    { "KEY_F8", KEY_F8 },
+    { "KEY_F9", KEY_F9 },
+    { "KEY_FASTFORWARD", KEY_FASTFORWARD },
+    { "KEY_FAVORITES", KEY_FAVORITES },
+    { "KEY_FILE", KEY_FILE },
+    { "KEY_FINANCE", KEY_FINANCE },
+    { "KEY_FIND", KEY_FIND },
+    { "KEY_FIRST", KEY_FIRST },
+    { "KEY_FN", KEY_FN },
+    { "KEY_FN_1", KEY_FN_1 },
+    { "KEY_FN_2", KEY_FN_2 },
+    { "KEY_FN_B", KEY_FN_B },
+    { "KEY_FN_D", KEY_FN_D },
+    { "KEY_FN_E", KEY_FN_E },
+    { "KEY_FN_ESC", KEY_FN_ESC },
+    { "KEY_FN_F", KEY_FN_F },
+    { "KEY_FN_F1", KEY_FN_F1 },
+    { "KEY_FN_F10", KEY_FN_F10 },
+    { "KEY_FN_F11", KEY_FN_F11 },
+    { "KEY_FN_F12", KEY_FN_F12 },
+    { "KEY_FN_F2", KEY_FN_F2 },
+    { "KEY_FN_F3", KEY_FN_F3 },
+    { "KEY_FN_F4", KEY_FN_F4 },
+    { "KEY_FN_F5", KEY_FN_F5 },
+    { "KEY_FN_F6", KEY_FN_F6 },
+    { "KEY_FN_F7", KEY_FN_F7 },
+    { "KEY_FN_F8", KEY_FN_F8 },
+    { "KEY_FN_F9", KEY_FN_F9 },
+    { "KEY_FN_RIGHT_SHIFT", KEY_FN_RIGHT_SHIFT },
+    { "KEY_FN_S", KEY_FN_S },
+    { "KEY_FORWARD", KEY_FORWARD },
+    { "KEY_FORWARDMAIL", KEY_FORWARDMAIL },
+    { "KEY_FRAMEBACK", KEY_FRAMEBACK },
+    { "KEY_FRAMEFORWARD", KEY_FRAMEFORWARD },
+    { "KEY_FRONT", KEY_FRONT },
+    { "KEY_FULL_SCREEN", KEY_FULL_SCREEN },
+    { "KEY_G", KEY_G },
+    { "KEY_GAMES", KEY_GAMES },
+    { "KEY_GOTO", KEY_GOTO },
+    { "KEY_GRAPHICSEDITOR", KEY_GRAPHICSEDITOR },
+    { "KEY_GRAVE", KEY_GRAVE },
+    { "KEY_GREEN", KEY_GREEN },
+    { "KEY_H", KEY_H },
+    { "KEY_HANGEUL", KEY_HANGEUL },
+    { "KEY_HANGUEL", KEY_HANGUEL },
+    { "KEY_HANGUP_PHONE", KEY_HANGUP_PHONE },
+    { "KEY_HANJA", KEY_HANJA },
+    { "KEY_HELP", KEY_HELP },
+    { "KEY_HENKAN", KEY_HENKAN },
+    { "KEY_HIRAGANA", KEY_HIRAGANA },
+    { "KEY_HOME", KEY_HOME },
+    { "KEY_HOMEPAGE", KEY_HOMEPAGE },
+    { "KEY_HP", KEY_HP },
+    { "KEY_I", KEY_I },
+    { "KEY_IMAGES", KEY_IMAGES },
+    { "KEY_INFO", KEY_INFO },
+    { "KEY_INSERT", KEY_INSERT },
+    { "KEY_INS_LINE", KEY_INS_LINE },
+    { "KEY_ISO", KEY_ISO },
+    { "KEY_J", KEY_J },
+    { "KEY_K", KEY_K },
+    { "KEY_KATAKANA", KEY_KATAKANA },
+    { "KEY_KATAKANAHIRAGANA", KEY_KATAKANAHIRAGANA },
+    { "KEY_KBDILLUMDOWN", KEY_KBDILLUMDOWN },
+    { "KEY_KBDILLUMTOGGLE", KEY_KBDILLUMTOGGLE },
+    { "KEY_KBDILLUMUP", KEY_KBDILLUMUP },
+    { "KEY_KEYBOARD", KEY_KEYBOARD },
+    { "KEY_KP0", KEY_KP0 },
+    { "KEY_KP1", KEY_KP1 },
+    { "KEY_KP2", KEY_KP2 },
+    { "KEY_KP3", KEY_KP3 },
+    { "KEY_KP4", KEY_KP4 },
+    { "KEY_KP5", KEY_KP5 },
+    { "KEY_KP6", KEY_KP6 },
+    { "KEY_KP7", KEY_KP7 },
+    { "KEY_KP8", KEY_KP8 },
+    { "KEY_KP9", KEY_KP9 },
+    { "KEY_KPASTERISK", KEY_KPASTERISK },
+    { "KEY_KPCOMMA", KEY_KPCOMMA },
+    { "KEY_KPDOT", KEY_KPDOT },
+    { "KEY_KPENTER", KEY_KPENTER },
+    { "KEY_KPEQUAL", KEY_KPEQUAL },
+    { "KEY_KPJPCOMMA", KEY_KPJPCOMMA },
+    { "KEY_KPLEFTPAREN", KEY_KPLEFTPAREN },
+    { "KEY_KPMINUS", KEY_KPMINUS },
+    { "KEY_KPPLUS", KEY_KPPLUS },
+    { "KEY_KPPLUSMINUS", KEY_KPPLUSMINUS },
+    { "KEY_KPRIGHTPAREN", KEY_KPRIGHTPAREN },
+    { "KEY_KPSLASH", KEY_KPSLASH },
+    { "KEY_L", KEY_L },
+    { "KEY_LANGUAGE", KEY_LANGUAGE },
+    { "KEY_LAST", KEY_LAST },
+    { "KEY_LEFT", KEY_LEFT },
+    { "KEY_LEFTALT", KEY_LEFTALT },
+    { "KEY_LEFTBRACE", KEY_LEFTBRACE },
+    { "KEY_LEFTCTRL", KEY_LEFTCTRL },
+    { "KEY_LEFTMETA", KEY_LEFTMETA },
+    { "KEY_LEFTSHIFT", KEY_LEFTSHIFT },
+    { "KEY_LEFT_DOWN", KEY_LEFT_DOWN },
+    { "KEY_LEFT_UP", KEY_LEFT_UP },
+    { "KEY_LIGHTS_TOGGLE", KEY_LIGHTS_TOGGLE },
+    { "KEY_LINEFEED", KEY_LINEFEED },
+    { "KEY_LIST", KEY_LIST },
+    { "KEY_LOGOFF", KEY_LOGOFF },
+    { "KEY_M", KEY_M },
+    { "KEY_MACRO", KEY_MACRO },
+    { "KEY_MAIL", KEY_MAIL },
+    { "KEY_MEDIA", KEY_MEDIA },
+    { "KEY_MEDIA_REPEAT", KEY_MEDIA_REPEAT },
+    { "KEY_MEMO", KEY_MEMO },
+    { "KEY_MENU", KEY_MENU },
+    { "KEY_MESSENGER", KEY_MESSENGER },
+    { "KEY_MHP", KEY_MHP },
+    { "KEY_MICMUTE", KEY_MICMUTE },
+    { "KEY_MINUS", KEY_MINUS },
+    { "KEY_MODE", KEY_MODE },
+    { "KEY_MOVE", KEY_MOVE },
+    { "KEY_MP3", KEY_MP3 },
+    { "KEY_MSDOS", KEY_MSDOS },
+    { "KEY_MUHENKAN", KEY_MUHENKAN },
+    { "KEY_MUTE", KEY_MUTE },
+    { "KEY_N", KEY_N },
+    { "KEY_NEW", KEY_NEW },
+    { "KEY_NEWS", KEY_NEWS },
+    { "KEY_NEXT", KEY_NEXT },
+    { "KEY_NEXTSONG", KEY_NEXTSONG },
+    { "KEY_NOTIFICATION_CENTER", KEY_NOTIFICATION_CENTER },
+    { "KEY_NUMERIC_0", KEY_NUMERIC_0 },
+    { "KEY_NUMERIC_1", KEY_NUMERIC_1 },
+    { "KEY_NUMERIC_2", KEY_NUMERIC_2 },
+    { "KEY_NUMERIC_3", KEY_NUMERIC_3 },
+    { "KEY_NUMERIC_4", KEY_NUMERIC_4 },
+    { "KEY_NUMERIC_5", KEY_NUMERIC_5 },
+    { "KEY_NUMERIC_6", KEY_NUMERIC_6 },
+    { "KEY_NUMERIC_7", KEY_NUMERIC_7 },
+    { "KEY_NUMERIC_8", KEY_NUMERIC_8 },
+    { "KEY_NUMERIC_9", KEY_NUMERIC_9 },
+    { "KEY_NUMERIC_A", KEY_NUMERIC_A },
+    { "KEY_NUMERIC_B", KEY_NUMERIC_B },
+    { "KEY_NUMERIC_C", KEY_NUMERIC_C },
+    { "KEY_NUMERIC_D", KEY_NUMERIC_D },
+    { "KEY_NUMERIC_POUND", KEY_NUMERIC_POUND },
+    { "KEY_NUMERIC_STAR", KEY_NUMERIC_STAR },
+    { "KEY_NUMLOCK", KEY_NUMLOCK },
+    { "KEY_O", KEY_O },
+    { "KEY_OK", KEY_OK },
+    { "KEY_OPEN", KEY_OPEN },
+    { "KEY_OPTION", KEY_OPTION },
+    { "KEY_P", KEY_P },
+    { "KEY_PAGEDOWN", KEY_PAGEDOWN },
+    { "KEY_PAGEUP", KEY_PAGEUP },
+    { "KEY_PASTE", KEY_PASTE },
+    { "KEY_PAUSE", KEY_PAUSE },
+    { "KEY_PAUSECD", KEY_PAUSECD },
+    { "KEY_PC", KEY_PC },
+    { "KEY_PHONE", KEY_PHONE },
+    { "KEY_PICKUP_PHONE", KEY_PICKUP_PHONE },
+    { "KEY_PLAY", KEY_PLAY },
+    { "KEY_PLAYCD", KEY_PLAYCD },
+    { "KEY_PLAYER", KEY_PLAYER },
+    { "KEY_PLAYPAUSE", KEY_PLAYPAUSE },
+    { "KEY_POWER", KEY_POWER },
+    { "KEY_POWER2", KEY_POWER2 },
+    { "KEY_PRESENTATION", KEY_PRESENTATION },
+    { "KEY_PREVIOUS", KEY_PREVIOUS },
+    { "KEY_PREVIOUSSONG", KEY_PREVIOUSSONG },
+    { "KEY_PRINT", KEY_PRINT },
+    { "KEY_PROG1", KEY_PROG1 },
+    { "KEY_PROG2", KEY_PROG2 },
+    { "KEY_PROG3", KEY_PROG3 },
+    { "KEY_PROG4", KEY_PROG4 },
+    { "KEY_PROGRAM", KEY_PROGRAM },
+    { "KEY_PROPS", KEY_PROPS },
+    { "KEY_PVR", KEY_PVR },
+    { "KEY_Q", KEY_Q },
+    { "KEY_QUESTION", KEY_QUESTION },
+    { "KEY_R", KEY_R },
+    { "KEY_RADIO", KEY_RADIO },
+    { "KEY_RECORD", KEY_RECORD },
+    { "KEY_RED", KEY_RED },
+    { "KEY_REDO", KEY_REDO },
+    { "KEY_REFRESH", KEY_REFRESH },
+    { "KEY_REPLY", KEY_REPLY },
+    { "KEY_RESTART", KEY_RESTART },
+    { "KEY_REWIND", KEY_REWIND },
+    { "KEY_RFKILL", KEY_RFKILL },
+    { "KEY_RIGHT", KEY_RIGHT },
+    { "KEY_RIGHTALT", KEY_RIGHTALT },
+    { "KEY_RIGHTBRACE", KEY_RIGHTBRACE },
+    { "KEY_RIGHTCTRL", KEY_RIGHTCTRL },
+    { "KEY_RIGHTMETA", KEY_RIGHTMETA },
+    { "KEY_RIGHTSHIFT", KEY_RIGHTSHIFT },
+    { "KEY_RIGHT_DOWN", KEY_RIGHT_DOWN },
+    { "KEY_RIGHT_UP", KEY_RIGHT_UP },
+    { "KEY_RO", KEY_RO },
+    { "KEY_ROTATE_DISPLAY", KEY_ROTATE_DISPLAY },
+    { "KEY_ROTATE_LOCK_TOGGLE", KEY_ROTATE_LOCK_TOGGLE },
+    { "KEY_S", KEY_S },
+    { "KEY_SAT", KEY_SAT },
+    { "KEY_SAT2", KEY_SAT2 },
+    { "KEY_SAVE", KEY_SAVE },
+    { "KEY_SCALE", KEY_SCALE },
+    { "KEY_SCREEN", KEY_SCREEN },
+    { "KEY_SCREENLOCK", KEY_SCREENLOCK },
+    { "KEY_SCROLLDOWN", KEY_SCROLLDOWN },
+    { "KEY_SCROLLLOCK", KEY_SCROLLLOCK },
+    { "KEY_SCROLLUP", KEY_SCROLLUP },
+    { "KEY_SEARCH", KEY_SEARCH },
+    { "KEY_SELECT", KEY_SELECT },
+    { "KEY_SEMICOLON", KEY_SEMICOLON },
+    { "KEY_SEND", KEY_SEND },
+    { "KEY_SENDFILE", KEY_SENDFILE },
+    { "KEY_SETUP", KEY_SETUP },
+    { "KEY_SHOP", KEY_SHOP },
+    { "KEY_SHUFFLE", KEY_SHUFFLE },
+    { "KEY_SLASH", KEY_SLASH },
+    { "KEY_SLEEP", KEY_SLEEP },
+    { "KEY_SLOW", KEY_SLOW },
+    { "KEY_SOUND", KEY_SOUND },
+    { "KEY_SPACE", KEY_SPACE },
+    { "KEY_SPELLCHECK", KEY_SPELLCHECK },
+    { "KEY_SPORT", KEY_SPORT },
+    { "KEY_SPREADSHEET", KEY_SPREADSHEET },
+    { "KEY_STOP", KEY_STOP },
+    { "KEY_STOPCD", KEY_STOPCD },
+    { "KEY_SUBTITLE", KEY_SUBTITLE },
+    { "KEY_SUSPEND", KEY_SUSPEND },
+    { "KEY_SWITCHVIDEOMODE", KEY_SWITCHVIDEOMODE },
+    { "KEY_SYSRQ", KEY_SYSRQ },
+    { "KEY_T", KEY_T },
+    { "KEY_TAB", KEY_TAB },
+    { "KEY_TAPE", KEY_TAPE },
+    { "KEY_TEEN", KEY_TEEN },
+    { "KEY_TEXT", KEY_TEXT },
+    { "KEY_TIME", KEY_TIME },
+    { "KEY_TITLE", KEY_TITLE },
+    { "KEY_TOUCHPAD_OFF", KEY_TOUCHPAD_OFF },
+    { "KEY_TOUCHPAD_ON", KEY_TOUCHPAD_ON },
+    { "KEY_TOUCHPAD_TOGGLE", KEY_TOUCHPAD_TOGGLE },
+    { "KEY_TUNER", KEY_TUNER },
+    { "KEY_TV", KEY_TV },
+    { "KEY_TV2", KEY_TV2 },
+    { "KEY_TWEN", KEY_TWEN },
+    { "KEY_U", KEY_U },
+    { "KEY_UNDO", KEY_UNDO },
+    { "KEY_UNKNOWN", KEY_UNKNOWN },
+    { "KEY_UP", KEY_UP },
+    { "KEY_UWB", KEY_UWB },
+    { "KEY_V", KEY_V },
+    { "KEY_VCR", KEY_VCR },
+    { "KEY_VCR2", KEY_VCR2 },
+    { "KEY_VENDOR", KEY_VENDOR },
+    { "KEY_VIDEO", KEY_VIDEO },
+    { "KEY_VIDEOPHONE", KEY_VIDEOPHONE },
+    { "KEY_VIDEO_NEXT", KEY_VIDEO_NEXT },
+    { "KEY_VIDEO_PREV", KEY_VIDEO_PREV },
+    { "KEY_VOICEMAIL", KEY_VOICEMAIL },
+    { "KEY_VOLUMEDOWN", KEY_VOLUMEDOWN },
+    { "KEY_VOLUMEUP", KEY_VOLUMEUP },
+    { "KEY_W", KEY_W },
+    { "KEY_WAKEUP", KEY_WAKEUP },
+    { "KEY_WIMAX", KEY_WIMAX },
+    { "KEY_WLAN", KEY_WLAN },
+    { "KEY_WORDPROCESSOR", KEY_WORDPROCESSOR },
+    { "KEY_WPS_BUTTON", KEY_WPS_BUTTON },
+    { "KEY_WWAN", KEY_WWAN },
+    { "KEY_WWW", KEY_WWW },
+    { "KEY_X", KEY_X },
+    { "KEY_XFER", KEY_XFER },
+    { "KEY_Y", KEY_Y },
+    { "KEY_YELLOW", KEY_YELLOW },
+    { "KEY_YEN", KEY_YEN },
+    { "KEY_Z", KEY_Z },
+    { "KEY_ZENKAKUHANKAKU", KEY_ZENKAKUHANKAKU },
+    { "KEY_ZOOM", KEY_ZOOM },
+    { "KEY_ZOOMIN", KEY_ZOOMIN },
+    { "KEY_ZOOMOUT", KEY_ZOOMOUT },
+    { "KEY_ZOOMRESET", KEY_ZOOMRESET },
+    { "KP0", KEY_KP0 },
+    { "KP1", KEY_KP1 },
+    { "KP2", KEY_KP2 },
+    { "KP3", KEY_KP3 },
+    { "KP4", KEY_KP4 },
+    { "KP5", KEY_KP5 },
+    { "KP6", KEY_KP6 },
+    { "KP7", KEY_KP7 },
+    { "KP8", KEY_KP8 },
+    { "KP9", KEY_KP9 },
+    { "KPASTERISK", KEY_KPASTERISK },
+    { "KPCOMMA", KEY_KPCOMMA },
+    { "KPDOT", KEY_KPDOT },
+    { "KPENTER", KEY_KPENTER },
+    { "KPEQUAL", KEY_KPEQUAL },
+    { "KPJPCOMMA", KEY_KPJPCOMMA },
+    { "KPLEFTPAREN", KEY_KPLEFTPAREN },
+    { "KPMINUS", KEY_KPMINUS },
+    { "KPPLUS", KEY_KPPLUS },
+    { "KPPLUSMINUS", KEY_KPPLUSMINUS },
+    { "KPRIGHTPAREN", KEY_KPRIGHTPAREN },
+    { "KPSLASH", KEY_KPSLASH },
+    { "L", KEY_L },
+    { "LANGUAGE", KEY_LANGUAGE },
+    { "LAST", KEY_LAST },
+    { "LEFT", KEY_LEFT },
+    { "LEFTALT", KEY_LEFTALT },
+    { "LEFTBRACE", KEY_LEFTBRACE },
+    { "LEFTCTRL", KEY_LEFTCTRL },
+    { "LEFTMETA", KEY_LEFTMETA },
+    { "LEFTSHIFT", KEY_LEFTSHIFT },
+    { "LIGHTS_TOGGLE", KEY_LIGHTS_TOGGLE },
+    { "LINEFEED", KEY_LINEFEED },
+    { "LIST", KEY_LIST },
+    { "LOGOFF", KEY_LOGOFF },
+    { "M", KEY_M },
+    { "MACRO", KEY_MACRO },
+    { "MAIL", KEY_MAIL },
+    { "MEDIA", KEY_MEDIA },
+    { "MEDIA_REPEAT", KEY_MEDIA_REPEAT },
+    { "MEMO", KEY_MEMO },
+    { "MENU", KEY_MENU },
+    { "MESSENGER", KEY_MESSENGER },
+    { "MHP", KEY_MHP },
+    { "MICMUTE", KEY_MICMUTE },
+    { "MINUS", KEY_MINUS },
+    { "MODE", KEY_MODE },
+    { "MOVE", KEY_MOVE },
+    { "MP3", KEY_MP3 },
+    { "MSDOS", KEY_MSDOS },
+    { "MUHENKAN", KEY_MUHENKAN },
+    { "MUTE", KEY_MUTE },
+    { "N", KEY_N },
+    { "NEW", KEY_NEW },
+    { "NEWS", KEY_NEWS },
+    { "NEXT", KEY_NEXT },
+    { "NEXTSONG", KEY_NEXTSONG },
+    { "NOTIFICATION_CENTER", KEY_NOTIFICATION_CENTER },
+    { "NUMERIC_0", KEY_NUMERIC_0 },
+    { "NUMERIC_1", KEY_NUMERIC_1 },
+    { "NUMERIC_2", KEY_NUMERIC_2 },
+    { "NUMERIC_3", KEY_NUMERIC_3 },
+    { "NUMERIC_4", KEY_NUMERIC_4 },
+    { "NUMERIC_5", KEY_NUMERIC_5 },
+    { "NUMERIC_6", KEY_NUMERIC_6 },
+    { "NUMERIC_7", KEY_NUMERIC_7 },
+    { "NUMERIC_8", KEY_NUMERIC_8 },
+    { "NUMERIC_9", KEY_NUMERIC_9 },
+    { "NUMERIC_A", KEY_NUMERIC_A },
+    { "NUMERIC_B", KEY_NUMERIC_B },
+    { "NUMERIC_C", KEY_NUMERIC_C },
+    { "NUMERIC_D", KEY_NUMERIC_D },
+    { "NUMERIC_POUND", KEY_NUMERIC_POUND },
+    { "NUMERIC_STAR", KEY_NUMERIC_STAR },
+    { "NUMLOCK", KEY_NUMLOCK },
+    { "O", KEY_O },
+    { "OK", KEY_OK },
+    { "OPEN", KEY_OPEN },
+    { "OPTION", KEY_OPTION },
+    { "P", KEY_P },
+    { "PAGEDOWN", KEY_PAGEDOWN },
+    { "PAGEUP", KEY_PAGEUP },
+    { "PASTE", KEY_PASTE },
+    { "PAUSE", KEY_PAUSE },
+    { "PAUSECD", KEY_PAUSECD },
+    { "PC", KEY_PC },
+    { "PHONE", KEY_PHONE },
+    { "PICKUP_PHONE", KEY_PICKUP_PHONE },
+    { "PLAY", KEY_PLAY },
+    { "PLAYCD", KEY_PLAYCD },
+    { "PLAYER", KEY_PLAYER },
+    { "PLAYPAUSE", KEY_PLAYPAUSE },
+    { "POWER", KEY_POWER },
+    { "POWER2", KEY_POWER2 },
+    { "PRESENTATION", KEY_PRESENTATION },
+    { "PREVIOUS", KEY_PREVIOUS },
+    { "PREVIOUSSONG", KEY_PREVIOUSSONG },
+    { "PRINT", KEY_PRINT },
+    { "PROG1", KEY_PROG1 },
+    { "PROG2", KEY_PROG2 },
+    { "PROG3", KEY_PROG3 },
+    { "PROG4", KEY_PROG4 },
+    { "PROGRAM", KEY_PROGRAM },
+    { "PROPS", KEY_PROPS },
+    { "PVR", KEY_PVR },
+    { "Q", KEY_Q },
+    { "QUESTION", KEY_QUESTION },
+    { "R", KEY_R },
+    { "RADIO", KEY_RADIO },
+    { "RECORD", KEY_RECORD },
+    { "RED", KEY_RED },
+    { "REDO", KEY_REDO },
+    { "REFRESH", KEY_REFRESH },
+    { "REPLY", KEY_REPLY },
+    { "RESTART", KEY_RESTART },
+    { "REWIND", KEY_REWIND },
+    { "RFKILL", KEY_RFKILL },
+    { "RIGHT", KEY_RIGHT },
+    { "RIGHTALT", KEY_RIGHTALT },
+    { "RIGHTBRACE", KEY_RIGHTBRACE },
+    { "RIGHTCTRL", KEY_RIGHTCTRL },
+    { "RIGHTMETA", KEY_RIGHTMETA },
+    { "RIGHTSHIFT", KEY_RIGHTSHIFT },
+    { "RO", KEY_RO },
+    { "ROTATE_DISPLAY", KEY_ROTATE_DISPLAY },
+    { "ROTATE_LOCK_TOGGLE", KEY_ROTATE_LOCK_TOGGLE },
+    { "S", KEY_S },
+    { "SAT", KEY_SAT },
+    { "SAT2", KEY_SAT2 },
+    { "SAVE", KEY_SAVE },
+    { "SCALE", KEY_SCALE },
+    { "SCREEN", KEY_SCREEN },
+    { "SCREENLOCK", KEY_SCREENLOCK },
+    { "SCROLLDOWN", KEY_SCROLLDOWN },
+    { "SCROLLLOCK", KEY_SCROLLLOCK },
+    { "SCROLLUP", KEY_SCROLLUP },
+    { "SEARCH", KEY_SEARCH },
+    { "SELECT", KEY_SELECT },
+    { "SEMICOLON", KEY_SEMICOLON },
+    { "SEND", KEY_SEND },
+    { "SENDFILE", KEY_SENDFILE },
+    { "SETUP", KEY_SETUP },
+    { "SHOP", KEY_SHOP },
+    { "SHUFFLE", KEY_SHUFFLE },
+    { "SLASH", KEY_SLASH },
+    { "SLEEP", KEY_SLEEP },
+    { "SLOW", KEY_SLOW },
+    { "SOUND", KEY_SOUND },
+    { "SPACE", KEY_SPACE },
+    { "SPELLCHECK", KEY_SPELLCHECK },
+    { "SPORT", KEY_SPORT },
+    { "SPREADSHEET", KEY_SPREADSHEET },
+    { "STOP", KEY_STOP },
+    { "STOPCD", KEY_STOPCD },
+    { "SUBTITLE", KEY_SUBTITLE },
+    { "SUSPEND", KEY_SUSPEND },
+    { "SWITCHVIDEOMODE", KEY_SWITCHVIDEOMODE },
+    { "SYSRQ", KEY_SYSRQ },
+    { "T", KEY_T },
+    { "TAB", KEY_TAB },
+    { "TAPE", KEY_TAPE },
+    { "TEEN", KEY_TEEN },
+    { "TEXT", KEY_TEXT },
+    { "TIME", KEY_TIME },
+    { "TITLE", KEY_TITLE },
+    { "TOUCHPAD_OFF", KEY_TOUCHPAD_OFF },
+    { "TOUCHPAD_ON", KEY_TOUCHPAD_ON },
+    { "TOUCHPAD_TOGGLE", KEY_TOUCHPAD_TOGGLE },
+    { "TUNER", KEY_TUNER },
+    { "TV", KEY_TV },
+    { "TV2", KEY_TV2 },
+    { "TWEN", KEY_TWEN },
+    { "U", KEY_U },
+    { "UNDO", KEY_UNDO },
+    { "UNKNOWN", KEY_UNKNOWN },
+    { "UP", KEY_UP },
+    { "UWB", KEY_UWB },
+    { "V", KEY_V },
+    { "VCR", KEY_VCR },
+    { "VCR2", KEY_VCR2 },
+    { "VENDOR", KEY_VENDOR },
+    { "VIDEO", KEY_VIDEO },
+    { "VIDEOPHONE", KEY_VIDEOPHONE },
+    { "VIDEO_NEXT", KEY_VIDEO_NEXT },
+    { "VIDEO_PREV", KEY_VIDEO_PREV },
+    { "VOICEMAIL", KEY_VOICEMAIL },
+    { "VOLUMEDOWN", KEY_VOLUMEDOWN },
+    { "VOLUMEUP", KEY_VOLUMEUP },
+    { "W", KEY_W },
+    { "WAKEUP", KEY_WAKEUP },
+    { "WIMAX", KEY_WIMAX },
+    { "WLAN", KEY_WLAN },
+    { "WORDPROCESSOR", KEY_WORDPROCESSOR },
+    { "WPS_BUTTON", KEY_WPS_BUTTON },
+    { "WWAN", KEY_WWAN },
+    { "WWW", KEY_WWW },
+    { "X", KEY_X },
+    { "XFER", KEY_XFER },
+    { "Y", KEY_Y },
+    { "YELLOW", KEY_YELLOW },
+    { "YEN", KEY_YEN },
+    { "Z", KEY_Z },
+    { "ZENKAKUHANKAKU", KEY_ZENKAKUHANKAKU },
+    { "ZOOM", KEY_ZOOM },
+    { "ZOOMIN", KEY_ZOOMIN },
+    { "ZOOMOUT", KEY_ZOOMOUT },
+    { "ZOOMRESET", KEY_ZOOMRESET },
+    { "[", KEY_LEFTBRACE },
+    { "\\", KEY_BACKSLASH },
+    { "]", KEY_RIGHTBRACE },
+};
+
+/**
+ * Compares a key string with the name of a key.
+ * */
+static int compare_key_name(const void* key, const void* element)
+{
+    return strcmp((const char*)key, ((const struct key_name*)element)->name);
+}
+
 /**
  * Converts a key string (e.g. "KEY_I") to its corresponding code.
+ * Returns 0 if the string is not a key name.
  * */
 int convertKeyStringToCode(char* keyString)
 {
     if (keyString == NULL) return 0;
-    else if (strcmp(keyString, "KEY_ESC") == 0) return KEY_ESC;
-    else if (strcmp(keyString, "ESC") == 0) return KEY_ESC;
-    else if (strcmp(keyString, "KEY_1") == 0) return KEY_1;
-    else if (strcmp(keyString, "1") == 0) return KEY_1;
-    else if (strcmp(keyString, "KEY_2") == 0) return KEY_2;
-    else if (strcmp(keyString, "2") == 0) return KEY_2;
-    else if (strcmp(keyString, "KEY_3") == 0) return KEY_3;
-    else if (strcmp(keyString, "3") == 0) return KEY_3;
-    else if (strcmp(keyString, "KEY_4") == 0) return KEY_4;
-    else if (strcmp(keyString, "4") == 0) return KEY_4;
-    else if (strcmp(keyString, "KEY_5") == 0) return KEY_5;
-    else if (strcmp(keyString, "5") == 0) return KEY_5;
-    else if (strcmp(keyString, "KEY_6") == 0) return KEY_6;
-    else if (strcmp(keyString, "6") == 0) return KEY_6;
-    else if (strcmp(keyString, "KEY_7") == 0) return KEY_7;
-    else if (strcmp(keyString, "7") == 0) return KEY_7;
-    else if (strcmp(keyString, "KEY_8") == 0) return KEY_8;
-    else if (strcmp(keyString, "8") == 0) return KEY_8;
-    else if (strcmp(keyString, "KEY_9") == 0) return KEY_9;
-    else if (strcmp(keyString, "9") == 0) return KEY_9;
-    else if (strcmp(keyString, "KEY_0") == 0) return KEY_0;
-    else if (strcmp(keyString, "0") == 0) return KEY_0;
-    else if (strcmp(keyString, "KEY_MINUS") == 0) return KEY_MINUS;
-    else if (strcmp(keyString, "MINUS") == 0) return KEY_MINUS;
-    else if (strcmp(keyString, "-") == 0) return KEY_MINUS;
-    else if (strcmp(keyString, "KEY_EQUAL") == 0) return KEY_EQUAL;
-    else if (strcmp(keyString, "EQUAL") == 0) return KEY_EQUAL;
-    else if (strcmp(keyString, "KEY_BACKSPACE") == 0) return KEY_BACKSPACE;
-    else if (strcmp(keyString, "BACKSPACE") == 0) return KEY_BACKSPACE;
-    else if (strcmp(keyString, "KEY_TAB") == 0) return KEY_TAB;
-    else if (strcmp(keyString, "TAB") == 0) return KEY_TAB;
-    else if (strcmp(keyString, "KEY_Q") == 0) return KEY_Q;
-    else if (strcmp(keyString, "Q") == 0) return KEY_Q;
-    else if (strcmp(keyString, "KEY_W") == 0) return KEY_W;
-    else if (strcmp(keyString, "W") == 0) return KEY_W;
-    else if (strcmp(keyString, "KEY_E") == 0) return KEY_E;
-    else if (strcmp(keyString, "E") == 0) return KEY_E;
-    else if (strcmp(keyString, "KEY_R") == 0) return KEY_R;
-    else if (strcmp(keyString, "R") == 0) return KEY_R;
-    else if (strcmp(keyString, "KEY_T") == 0) return KEY_T;
-    else if (strcmp(keyString, "T") == 0) return KEY_T;
-    else if (strcmp(keyString, "KEY_Y") == 0) return KEY_Y;
-    else if (strcmp(keyString, "Y") == 0) return KEY_Y;
-    else if (strcmp(keyString, "KEY_U") == 0) return KEY_U;
-    else if (strcmp(keyString, "U") == 0) return KEY_U;
-    else if (strcmp(keyString, "KEY_I") == 0) return KEY_I;
-    else if (strcmp(keyString, "I") == 0) return KEY_I;
-    else if (strcmp(keyString, "KEY_O") == 0) return KEY_O;
-    else if (strcmp(keyString, "O") == 0) return KEY_O;
-    else if (strcmp(keyString, "KEY_P") == 0) return KEY_P;
-    else if (strcmp(keyString, "P") == 0) return KEY_P;
-    else if (strcmp(keyString, "KEY_LEFTBRACE") == 0) return KEY_LEFTBRACE;
-    else if (strcmp(keyString, "LEFTBRACE") == 0) return KEY_LEFTBRACE;
-    else if (strcmp(keyString, "[") == 0) return KEY_LEFTBRACE;
-    else if (strcmp(keyString, "KEY_RIGHTBRACE") == 0) return KEY_RIGHTBRACE;
-    else if (strcmp(keyString, "RIGHTBRACE") == 0) return KEY_RIGHTBRACE;
-    else if (strcmp(keyString, "]") == 0) return KEY_RIGHTBRACE;
-    else if (strcmp(keyString, "KEY_ENTER") == 0) return KEY_ENTER;
-    else if (strcmp(keyString, "ENTER") == 0) return KEY_ENTER;
-    else if (strcmp(keyString, "KEY_LEFTCTRL") == 0) return KEY_LEFTCTRL;
-    else if (strcmp(keyString, "LEFTCTRL") == 0) return KEY_LEFTCTRL;
-    else if (strcmp(keyString, "KEY_A") == 0) return KEY_A;
-    else if (strcmp(keyString, "A") == 0) return KEY_A;
-    else if (strcmp(keyString, "KEY_S") == 0) return KEY_S;
-    else if (strcmp(keyString, "S") == 0) return KEY_S;
-    else if (strcmp(keyString, "KEY_D") == 0) return KEY_D;
-    else if (strcmp(keyString, "D") == 0) return KEY_D;
-    else if (strcmp(keyString, "KEY_F") == 0) return KEY_F;
-    else if (strcmp(keyString, "F") == 0) return KEY_F;
-    else if (strcmp(keyString, "KEY_G") == 0) return KEY_G;
-    else if (strcmp(keyString, "G") == 0) return KEY_G;
-    else if (strcmp(keyString, "KEY_H") == 0) return KEY_H;
-    else if (strcmp(keyString, "H") == 0) return KEY_H;
-    else if (strcmp(keyString, "KEY_J") == 0) return KEY_J;
-    else if (strcmp(keyString, "J") == 0) return KEY_J;
-    else if (strcmp(keyString, "KEY_K") == 0) return KEY_K;
-    else if (strcmp(keyString, "K") == 0) return KEY_K;
-    else if (strcmp(keyString, "KEY_L") == 0) return KEY_L;
-    else if (strcmp(keyString, "L") == 0) return KEY_L;
-    else if (strcmp(keyString, "KEY_SEMICOLON") == 0) return KEY_SEMICOLON;
-    else if (strcmp(keyString, "SEMICOLON") == 0) return KEY_SEMICOLON;
-    else if (strcmp(keyString, ";") == 0) return KEY_SEMICOLON;
-    else if (strcmp(keyString, "KEY_APOSTROPHE") == 0) return KEY_APOSTROPHE;
-    else if (strcmp(keyString, "APOSTROPHE") == 0) return KEY_APOSTROPHE;
-    else if (strcmp(keyString, "'") == 0) return KEY_APOSTROPHE;
-    else if (strcmp(keyString, "KEY_GRAVE") == 0) return KEY_GRAVE;
-    else if (strcmp(keyString, "GRAVE") == 0) return KEY_GRAVE;
-    else if (strcmp(keyString, "KEY_LEFTSHIFT") == 0) return KEY_LEFTSHIFT;
-    else if (strcmp(keyString, "LEFTSHIFT") == 0) return KEY_LEFTSHIFT;
-    else if (strcmp(keyString, "KEY_BACKSLASH") == 0) return KEY_BACKSLASH;
-    else if (strcmp(keyString, "BACKSLASH") == 0) return KEY_BACKSLASH;
-    else if (strcmp(keyString, "\\") == 0) return KEY_BACKSLASH;
-    else if (strcmp(keyString, "KEY_Z") == 0) return KEY_Z;
-    else if (strcmp(keyString, "Z") == 0) return KEY_Z;
-    else if (strcmp(keyString, "KEY_X") == 0) return KEY_X;
-    else if (strcmp(keyString, "X") == 0) return KEY_X;
-    else if (strcmp(keyString, "KEY_C") == 0) return KEY_C;
-    else if (strcmp(keyString, "C") == 0) return KEY_C;
-    else if (strcmp(keyString, "KEY_V") == 0) return KEY_V;
-    else if (strcmp(keyString, "V") == 0) return KEY_V;
-    else if (strcmp(keyString, "KEY_B") == 0) return KEY_B;
-    else if (strcmp(keyString, "B") == 0) return KEY_B;
-    else if (strcmp(keyString, "KEY_N") == 0) return KEY_N;
-    else if (strcmp(keyString, "N") == 0) return KEY_N;
-    else if (strcmp(keyString, "KEY_M") == 0) return KEY_M;
-    else if (strcmp(keyString, "M") == 0) return KEY_M;
-    else if (strcmp(keyString, "KEY_COMMA") == 0) return KEY_COMMA;
-    else if (strcmp(keyString, "COMMA") == 0) return KEY_COMMA;
-    else if (strcmp(keyString, ",") == 0) return KEY_COMMA;
-    else if (strcmp(keyString, "KEY_DOT") == 0) return KEY_DOT;
-    else if (strcmp(keyString, "DOT") == 0) return KEY_DOT;
-    else if (strcmp(keyString, ".") == 0) return KEY_DOT;
-    else if (strcmp(keyString, "KEY_SLASH") == 0) return KEY_SLASH;
-    else if (strcmp(keyString, "SLASH") == 0) return KEY_SLASH;
-    else if (strcmp(keyString, "/") == 0) return KEY_SLASH;
-    else if (strcmp(keyString, "KEY_RIGHTSHIFT") == 0) return KEY_RIGHTSHIFT;
-    else if (strcmp(keyString, "RIGHTSHIFT") == 0) return KEY_RIGHTSHIFT;
-    else if (strcmp(keyString, "KEY_KPASTERISK") == 0) return KEY_KPASTERISK;
-    else if (strcmp(keyString, "KPASTERISK") == 0) return KEY_KPASTERISK;
-    else if (strcmp(keyString, "KEY_LEFTALT") == 0) return KEY_LEFTALT;
-    else if (strcmp(keyString, "LEFTALT") == 0) return KEY_LEFTALT;
-    else if (strcmp(keyString, "KEY_SPACE") == 0) return KEY_SPACE;
-    else if (strcmp(keyString, "SPACE") == 0) return KEY_SPACE;
-    else if (strcmp(keyString, "KEY_CAPSLOCK") == 0) return KEY_CAPSLOCK;
-    else if (strcmp(keyString, "CAPSLOCK") == 0) return KEY_CAPSLOCK;
-    else if (strcmp(keyString, "KEY_F1") == 0) return KEY_F1;
-    else if (strcmp(keyString, "F1") == 0) return KEY_F1;
-    else if (strcmp(keyString, "KEY_F2") == 0) return KEY_F2;
-    else if (strcmp(keyString, "F2") == 0) return KEY_F2;
-    else if (strcmp(keyString, "KEY_F3") == 0) return KEY_F3;
-    else if (strcmp(keyString, "F3") == 0) return KEY_F3;
-    else if (strcmp(keyString, "KEY_F4") == 0) return KEY_F4;
-    else if (strcmp(keyString, "F4") == 0) return KEY_F4;
-    else if (strcmp(keyString, "KEY_F5") == 0) return KEY_F5;
-    else if (strcmp(keyString, "F5") == 0) return KEY_F5;
-    else if (strcmp(keyString, "KEY_F6") == 0) return KEY_F6;
-    else if (strcmp(keyString, "F6") == 0) return KEY_F6;
-    else if (strcmp(keyString, "KEY_F7") == 0) return KEY_F7;
-    else if (strcmp(keyString, "F7") == 0) return KEY_F7;
-    else if (strcmp(keyString, "KEY_F8") == 0) return KEY_F8;
-    else if (strcmp(keyString, "F8") == 0) return KEY_F8;
-    else if (strcmp(keyString, "KEY_F9") == 0) return KEY_F9;
-    else if (strcmp(keyString, "F9") == 0) return KEY_F9;
-    else if (strcmp(keyString, "KEY_F10") == 0) return KEY_F10;
-    else if (strcmp(keyString, "F10") == 0) return KEY_F10;
-    else if (strcmp(keyString, "KEY_NUMLOCK") == 0) return KEY_NUMLOCK;
-    else if (strcmp(keyString, "NUMLOCK") == 0) return KEY_NUMLOCK;
-    else if (strcmp(keyString, "KEY_SCROLLLOCK") == 0) return KEY_SCROLLLOCK;
-    else if (strcmp(keyString, "SCROLLLOCK") == 0) return KEY_SCROLLLOCK;
-    else if (strcmp(keyString, "KEY_KP7") == 0) return KEY_KP7;
-    else if (strcmp(keyString, "KP7") == 0) return KEY_KP7;
-    else if (strcmp(keyString, "KEY_KP8") == 0) return KEY_KP8;
-    else if (strcmp(keyString, "KP8") == 0) return KEY_KP8;
-    else if (strcmp(keyString, "KEY_KP9") == 0) return KEY_KP9;
-    else if (strcmp(keyString, "KP9") == 0) return KEY_KP9;
-    else if (strcmp(keyString, "KEY_KPMINUS") == 0) return KEY_KPMINUS;
-    else if (strcmp(keyString, "KPMINUS") == 0) return KEY_KPMINUS;
-    else if (strcmp(keyString, "KEY_KP4") == 0) return KEY_KP4;
-    else if (strcmp(keyString, "KP4") == 0) return KEY_KP4;
-    else if (strcmp(keyString, "KEY_KP5") == 0) return KEY_KP5;
-    else if (strcmp(keyString, "KP5") == 0) return KEY_KP5;
-    else if (strcmp(keyString, "KEY_KP6") == 0) return KEY_KP6;
-    else if (strcmp(keyString, "KP6") == 0) return KEY_KP6;
-    else if (strcmp(keyString, "KEY_KPPLUS") == 0) return KEY_KPPLUS;
-    else if (strcmp(keyString, "KPPLUS") == 0) return KEY_KPPLUS;
-    else if (strcmp(keyString, "KEY_KP1") == 0) return KEY_KP1;
-    else if (strcmp(keyString, "KP1") == 0) return KEY_KP1;
-    else if (strcmp(keyString, "KEY_KP2") == 0) return KEY_KP2;
-    else if (strcmp(keyString, "KP2") == 0) return KEY_KP2;
-    else if (strcmp(keyString, "KEY_KP3") == 0) return KEY_KP3;
-    else if (strcmp(keyString, "KP3") == 0) return KEY_KP3;
-    else if (strcmp(keyString, "KEY_KP0") == 0) return KEY_KP0;
-    else if (strcmp(keyString, "KP0") == 0) return KEY_KP0;
-    else if (strcmp(keyString, "KEY_KPDOT") == 0) return KEY_KPDOT;
-    else if (strcmp(keyString, "KPDOT") == 0) return KEY_KPDOT;
-    else if (strcmp(keyString, "KEY_ZENKAKUHANKAKU") == 0) return KEY_ZENKAKUHANKAKU;
-    else if (strcmp(keyString, "ZENKAKUHANKAKU") == 0) return KEY_ZENKAKUHANKAKU;
-    else if (strcmp(keyString, "KEY_102ND") == 0) return KEY_102ND;
-    else if (strcmp(keyString, "102ND") == 0) return KEY_102ND;
-    else if (strcmp(keyString, "KEY_F11") == 0) return KEY_F11;
-    else if (strcmp(keyString, "F11") == 0) return KEY_F11;
-    else if (strcmp(keyString, "KEY_F12") == 0) return KEY_F12;
-    else if (strcmp(keyString, "F12") == 0) return KEY_F12;
-    else if (strcmp(keyString, "KEY_RO") == 0) return KEY_RO;
-    else if (strcmp(keyString, "RO") == 0) return KEY_RO;
-    else if (strcmp(keyString, "KEY_KATAKANA") == 0) return KEY_KATAKANA;
-    else if (strcmp(keyString, "KATAKANA") == 0) return KEY_KATAKANA;
-    else if (strcmp(keyString, "KEY_HIRAGANA") == 0) return KEY_HIRAGANA;
-    else if (strcmp(keyString, "HIRAGANA") == 0) return KEY_HIRAGANA;
-    else if (strcmp(keyString, "KEY_HENKAN") == 0) return KEY_HENKAN;
-    else if (strcmp(keyString, "HENKAN") == 0) return KEY_HENKAN;
-    else if (strcmp(keyString, "KEY_KATAKANAHIRAGANA") == 0) return KEY_KATAKANAHIRAGANA;
-    else if (strcmp(keyString, "KATAKANAHIRAGANA") == 0) return KEY_KATAKANAHIRAGANA;
-    else if (strcmp(keyString, "KEY_MUHENKAN") == 0) return KEY_MUHENKAN;
-    else if (strcmp(keyString, "MUHENKAN") == 0) return KEY_MUHENKAN;
-    else if (strcmp(keyString, "KEY_KPJPCOMMA") == 0) return KEY_KPJPCOMMA;
-    else if (strcmp(keyString, "KPJPCOMMA") == 0) return KEY_KPJPCOMMA;
-    else if (strcmp(keyString, "KEY_KPENTER") == 0) return KEY_KPENTER;
-    else if (strcmp(keyString, "KPENTER") == 0) return KEY_KPENTER;
-    else if (strcmp(keyString, "KEY_RIGHTCTRL") == 0) return KEY_RIGHTCTRL;
-    else if (strcmp(keyString, "RIGHTCTRL") == 0) return KEY_RIGHTCTRL;
-    else if (strcmp(keyString, "KEY_KPSLASH") == 0) return KEY_KPSLASH;
-    else if (strcmp(keyString, "KPSLASH") == 0) return KEY_KPSLASH;
-    else if (strcmp(keyString, "KEY_SYSRQ") == 0) return KEY_SYSRQ;
-    else if (strcmp(keyString, "SYSRQ") == 0) return KEY_SYSRQ;
-    else if (strcmp(keyString, "KEY_RIGHTALT") == 0) return KEY_RIGHTALT;
-    else if (strcmp(keyString, "RIGHTALT") == 0) return KEY_RIGHTALT;
-    else if (strcmp(keyString, "KEY_LINEFEED") == 0) return KEY_LINEFEED;
-    else if (strcmp(keyString, "LINEFEED") == 0) return KEY_LINEFEED;
-    else if (strcmp(keyString, "KEY_HOME") == 0) return KEY_HOME;
-    else if (strcmp(keyString, "HOME") == 0) return KEY_HOME;
-    else if (strcmp(keyString, "KEY_UP") == 0) return KEY_UP;
-    else if (strcmp(keyString, "UP") == 0) return KEY_UP;
-    else if (strcmp(keyString, "KEY_PAGEUP") == 0) return KEY_PAGEUP;
-    else if (strcmp(keyString, "PAGEUP") == 0) return KEY_PAGEUP;
-    else if (strcmp(keyString, "KEY_LEFT") == 0) return KEY_LEFT;
-    else if (strcmp(keyString, "LEFT") == 0) return KEY_LEFT;
-    else if (strcmp(keyString, "KEY_RIGHT") == 0) return KEY_RIGHT;
-    else if (strcmp(keyString, "RIGHT") == 0) return KEY_RIGHT;
-    else if (strcmp(keyString, "KEY_END") == 0) return KEY_END;
-    else if (strcmp(keyString, "END") == 0) return KEY_END;
-    else if (strcmp(keyString, "KEY_DOWN") == 0) return KEY_DOWN;
-    else if (strcmp(keyString, "DOWN") == 0) return KEY_DOWN;
-    else if (strcmp(keyString, "KEY_PAGEDOWN") == 0) return KEY_PAGEDOWN;
-    else if (strcmp(keyString, "PAGEDOWN") == 0) return KEY_PAGEDOWN;
-    else if (strcmp(keyString, "KEY_INSERT") == 0) return KEY_INSERT;
-    else if (strcmp(keyString, "INSERT") == 0) return KEY_INSERT;
-    else if (strcmp(keyString, "KEY_DELETE") == 0) return KEY_DELETE;
-    else if (strcmp(keyString, "DELETE") == 0) return KEY_DELETE;
-    else if (strcmp(keyString, "KEY_MACRO") == 0) return KEY_MACRO;
-    else if (strcmp(keyString, "MACRO") == 0) return KEY_MACRO;
-    else if (strcmp(keyString, "KEY_MUTE") == 0) return KEY_MUTE;
-    else if (strcmp(keyString, "MUTE") == 0) return KEY_MUTE;
-    else if (strcmp(keyString, "KEY_VOLUMEDOWN") == 0) return KEY_VOLUMEDOWN;
-    else if (strcmp(keyString, "VOLUMEDOWN") == 0) return KEY_VOLUMEDOWN;
-    else if (strcmp(keyString, "KEY_VOLUMEUP") == 0) return KEY_VOLUMEUP;
-    else if (strcmp(keyString, "VOLUMEUP") == 0) return KEY_VOLUMEUP;
-    else if (strcmp(keyString, "KEY_POWER") == 0) return KEY_POWER;
-    else if (strcmp(keyString, "POWER") == 0) return KEY_POWER;
-    else if (strcmp(keyString, "KEY_KPEQUAL") == 0) return KEY_KPEQUAL;
-    else if (strcmp(keyString, "KPEQUAL") == 0) return KEY_KPEQUAL;
-    else if (strcmp(keyString, "KEY_KPPLUSMINUS") == 0) return KEY_KPPLUSMINUS;
-    else if (strcmp(keyString, "KPPLUSMINUS") == 0) return KEY_KPPLUSMINUS;
-    else if (strcmp(keyString, "KEY_PAUSE") == 0) return KEY_PAUSE;
-    else if (strcmp(keyString, "PAUSE") == 0) return KEY_PAUSE;
-    else if (strcmp(keyString, "KEY_SCALE") == 0) return KEY_SCALE;
-    else if (strcmp(keyString, "SCALE") == 0) return KEY_SCALE;
-    else if (strcmp(keyString, "KEY_KPCOMMA") == 0) return KEY_KPCOMMA;
-    else if (strcmp(keyString, "KPCOMMA") == 0) return KEY_KPCOMMA;
-    else if (strcmp(keyString, "KEY_HANGEUL") == 0) return KEY_HANGEUL;
-    else if (strcmp(keyString, "HANGEUL") == 0) return KEY_HANGEUL;
-    else if (strcmp(keyString, "KEY_HANGUEL") == 0) return KEY_HANGUEL;
-    else if (strcmp(keyString, "HANGUEL") == 0) return KEY_HANGUEL;
-    else if (strcmp(keyString, "KEY_HANJA") == 0) return KEY_HANJA;
-    else if (strcmp(keyString, "HANJA") == 0) return KEY_HANJA;
-    else if (strcmp(keyString, "KEY_YEN") == 0) return KEY_YEN;
-    else if (strcmp(keyString, "YEN") == 0) return KEY_YEN;
-    else if (strcmp(keyString, "KEY_LEFTMETA") == 0) return KEY_LEFTMETA;
-    else if (strcmp(keyString, "LEFTMETA") == 0) return KEY_LEFTMETA;
-    else if (strcmp(keyString, "KEY_RIGHTMETA") == 0) return KEY_RIGHTMETA;
-    else if (strcmp(keyString, "RIGHTMETA") == 0) return KEY_RIGHTMETA;
-    else if (strcmp(keyString, "KEY_COMPOSE") == 0) return KEY_COMPOSE;
-    else if (strcmp(keyString, "COMPOSE") == 0) return KEY_COMPOSE;
-    else if (strcmp(keyString, "KEY_STOP") == 0) return KEY_STOP;
-    else if (strcmp(keyString, "STOP") == 0) return KEY_STOP;
-    else if (strcmp(keyString, "KEY_AGAIN") == 0) return KEY_AGAIN;
-    else if (strcmp(keyString, "AGAIN") == 0) return KEY_AGAIN;
-    else if (strcmp(keyString, "KEY_PROPS") == 0) return KEY_PROPS;
-    else if (strcmp(keyString, "PROPS") == 0) return KEY_PROPS;
-    else if (strcmp(keyString, "KEY_UNDO") == 0) return KEY_UNDO;
-    else if (strcmp(keyString, "UNDO") == 0) return KEY_UNDO;
-    else if (strcmp(keyString, "KEY_FRONT") == 0) return KEY_FRONT;
-    else if (strcmp(keyString, "FRONT") == 0) return KEY_FRONT;
-    else if (strcmp(keyString, "KEY_COPY") == 0) return KEY_COPY;
-    else if (strcmp(keyString, "COPY") == 0) return KEY_COPY;
-    else if (strcmp(keyString, "KEY_OPEN") == 0) return KEY_OPEN;
-    else if (strcmp(keyString, "OPEN") == 0) return KEY_OPEN;
-    else if (strcmp(keyString, "KEY_PASTE") == 0) return KEY_PASTE;
-    else if (strcmp(keyString, "PASTE") == 0) return KEY_PASTE;
-    else if (strcmp(keyString, "KEY_FIND") == 0) return KEY_FIND;
-    else if (strcmp(keyString, "FIND") == 0) return KEY_FIND;
-    else if (strcmp(keyString, "KEY_CUT") == 0) return KEY_CUT;
-    else if (strcmp(keyString, "CUT") == 0) return KEY_CUT;
-    else if (strcmp(keyString, "KEY_HELP") == 0) return KEY_HELP;
-    else if (strcmp(keyString, "HELP") == 0) return KEY_HELP;
-    else if (strcmp(keyString, "KEY_MENU") == 0) return KEY_MENU;
-    else if (strcmp(keyString, "MENU") == 0) return KEY_MENU;
-    else if (strcmp(keyString, "KEY_CALC") == 0) return KEY_CALC;
-    else if (strcmp(keyString, "CALC") == 0) return KEY_CALC;
-    else if (strcmp(keyString, "KEY_SETUP") == 0) return KEY_SETUP;
-    else if (strcmp(keyString, "SETUP") == 0) return KEY_SETUP;
-    else if (strcmp(keyString, "KEY_SLEEP") == 0) return KEY_SLEEP;
-    else if (strcmp(keyString, "SLEEP") == 0) return KEY_SLEEP;
-    else if (strcmp(keyString, "KEY_WAKEUP") == 0) return KEY_WAKEUP;
-    else if (strcmp(keyString, "WAKEUP") == 0) return KEY_WAKEUP;
-    else if (strcmp(keyString, "KEY_FILE") == 0) return KEY_FILE;
-    else if (strcmp(keyString, "FILE") == 0) return KEY_FILE;
-    else if (strcmp(keyString, "KEY_SENDFILE") == 0) return KEY_SENDFILE;
-    else if (strcmp(keyString, "SENDFILE") == 0) return KEY_SENDFILE;
-    else if (strcmp(keyString, "KEY_DELETEFILE") == 0) return KEY_DELETEFILE;
-    else if (strcmp(keyString, "DELETEFILE") == 0) return KEY_DELETEFILE;
-    else if (strcmp(keyString, "KEY_XFER") == 0) return KEY_XFER;
-    else if (strcmp(keyString, "XFER") == 0) return KEY_XFER;
-    else if (strcmp(keyString, "KEY_PROG1") == 0) return KEY_PROG1;
-    else if (strcmp(keyString, "PROG1") == 0) return KEY_PROG1;
-    else if (strcmp(keyString, "KEY_PROG2") == 0) return KEY_PROG2;
-    else if (strcmp(keyString, "PROG2") == 0) return KEY_PROG2;
-    else if (strcmp(keyString, "KEY_WWW") == 0) return KEY_WWW;
-    else if (strcmp(keyString, "WWW") == 0) return KEY_WWW;
-    else if (strcmp(keyString, "KEY_MSDOS") == 0) return KEY_MSDOS;
-    else if (strcmp(keyString, "MSDOS") == 0) return KEY_MSDOS;
-    else if (strcmp(keyString, "KEY_COFFEE") == 0) return KEY_COFFEE;
-    else if (strcmp(keyString, "COFFEE") == 0) return KEY_COFFEE;
-    else if (strcmp(keyString, "KEY_SCREENLOCK") == 0) return KEY_SCREENLOCK;
-    else if (strcmp(keyString, "SCREENLOCK") == 0) return KEY_SCREENLOCK;
-    else if (strcmp(keyString, "KEY_ROTATE_DISPLAY") == 0) return KEY_ROTATE_DISPLAY;
-    else if (strcmp(keyString, "ROTATE_DISPLAY") == 0) return KEY_ROTATE_DISPLAY;
-    else if (strcmp(keyString, "KEY_DIRECTION") == 0) return KEY_DIRECTION;
-    else if (strcmp(keyString, "DIRECTION") == 0) return KEY_DIRECTION;
-    else if (strcmp(keyString, "KEY_CYCLEWINDOWS") == 0) return KEY_CYCLEWINDOWS;
-    else if (strcmp(keyString, "CYCLEWINDOWS") == 0) return KEY_CYCLEWINDOWS;
-    else if (strcmp(keyString, "KEY_MAIL") == 0) return KEY_MAIL;
-    else if (strcmp(keyString, "MAIL") == 0) return KEY_MAIL;
-    else if (strcmp(keyString, "KEY_BOOKMARKS") == 0) return KEY_BOOKMARKS;
-    else if (strcmp(keyString, "BOOKMARKS") == 0) return KEY_BOOKMARKS;
-    else if (strcmp(keyString, "KEY_COMPUTER") == 0) return KEY_COMPUTER;
-    else if (strcmp(keyString, "COMPUTER") == 0) return KEY_COMPUTER;
-    else if (strcmp(keyString, "KEY_BACK") == 0) return KEY_BACK;
-    else if (strcmp(keyString, "BACK") == 0) return KEY_BACK;
-    else if (strcmp(keyString, "KEY_FORWARD") == 0) return KEY_FORWARD;
-    else if (strcmp(keyString, "FORWARD") == 0) return KEY_FORWARD;
-    else if (strcmp(keyString, "KEY_CLOSECD") == 0) return KEY_CLOSECD;
-    else if (strcmp(keyString, "CLOSECD") == 0) return KEY_CLOSECD;
-    else if (strcmp(keyString, "KEY_EJECTCD") == 0) return KEY_EJECTCD;
-    else if (strcmp(keyString, "EJECTCD") == 0) return KEY_EJECTCD;
-    else if (strcmp(keyString, "KEY_EJECTCLOSECD") == 0) return KEY_EJECTCLOSECD;
-    else if (strcmp(keyString, "EJECTCLOSECD") == 0) return KEY_EJECTCLOSECD;
-    else if (strcmp(keyString, "KEY_NEXTSONG") == 0) return KEY_NEXTSONG;
-    else if (strcmp(keyString, "NEXTSONG") == 0) return KEY_NEXTSONG;
-    else if (strcmp(keyString, "KEY_PLAYPAUSE") == 0) return KEY_PLAYPAUSE;
-    else if (strcmp(keyString, "PLAYPAUSE") == 0) return KEY_PLAYPAUSE;
-    else if (strcmp(keyString, "KEY_PREVIOUSSONG") == 0) return KEY_PREVIOUSSONG;
-    else if (strcmp(keyString, "PREVIOUSSONG") == 0) return KEY_PREVIOUSSONG;
-    else if (strcmp(keyString, "KEY_STOPCD") == 0) return KEY_STOPCD;
-    else if (strcmp(keyString, "STOPCD") == 0) return KEY_STOPCD;
-    else if (strcmp(keyString, "KEY_RECORD") == 0) return KEY_RECORD;
-    else if (strcmp(keyString, "RECORD") == 0) return KEY_RECORD;
-    else if (strcmp(keyString, "KEY_REWIND") == 0) return KEY_REWIND;
-    else if (strcmp(keyString, "REWIND") == 0) return KEY_REWIND;
-    else if (strcmp(keyString, "KEY_PHONE") == 0) return KEY_PHONE;
-    else if (strcmp(keyString, "PHONE") == 0) return KEY_PHONE;
-    else if (strcmp(keyString, "KEY_ISO") == 0) return KEY_ISO;
-    else if (strcmp(keyString, "ISO") == 0) return KEY_ISO;
-    else if (strcmp(keyString, "KEY_CONFIG") == 0) return KEY_CONFIG;
-    else if (strcmp(keyString, "CONFIG") == 0) return KEY_CONFIG;
-    else if (strcmp(keyString, "KEY_HOMEPAGE") == 0) return KEY_HOMEPAGE;
-    else if (strcmp(keyString, "HOMEPAGE") == 0) return KEY_HOMEPAGE;
-    else if (strcmp(keyString, "KEY_REFRESH") == 0) return KEY_REFRESH;
-    else if (strcmp(keyString, "REFRESH") == 0) return KEY_REFRESH;
-    else if (strcmp(keyString, "KEY_EXIT") == 0) return KEY_EXIT;
-    else if (strcmp(keyString, "EXIT") == 0) return KEY_EXIT;
-    else if (strcmp(keyString, "KEY_MOVE") == 0) return KEY_MOVE;
-    else if (strcmp(keyString, "MOVE") == 0) return KEY_MOVE;
-    else if (strcmp(keyString, "KEY_EDIT") == 0) return KEY_EDIT;
-    else if (strcmp(keyString, "EDIT") == 0) return KEY_EDIT;
-    else if (strcmp(keyString, "KEY_SCROLLUP") == 0) return KEY_SCROLLUP;
-    else if (strcmp(keyString, "SCROLLUP") == 0) return KEY_SCROLLUP;
-    else if (strcmp(keyString, "KEY_SCROLLDOWN") == 0) return KEY_SCROLLDOWN;
-    else if (strcmp(keyString, "SCROLLDOWN") == 0) return KEY_SCROLLDOWN;
-    else if (strcmp(keyString, "KEY_KPLEFTPAREN") == 0) return KEY_KPLEFTPAREN;
-    else if (strcmp(keyString, "KPLEFTPAREN") == 0) return KEY_KPLEFTPAREN;
-    else if (strcmp(keyString, "KEY_KPRIGHTPAREN") == 0) return KEY_KPRIGHTPAREN;
-    else if (strcmp(keyString, "KPRIGHTPAREN") == 0) return KEY_KPRIGHTPAREN;
-    else if (strcmp(keyString, "KEY_NEW") == 0) return KEY_NEW;
-    else if (strcmp(keyString, "NEW") == 0) return KEY_NEW;
-    else if (strcmp(keyString, "KEY_REDO") == 0) return KEY_REDO;
-    else if (strcmp(keyString, "REDO") == 0) return KEY_REDO;
-    else if (strcmp(keyString, "KEY_F13") == 0) return KEY_F13;
-    else if (strcmp(keyString, "F13") == 0) return KEY_F13;
-    else if (strcmp(keyString, "KEY_F14") == 0) return KEY_F14;
-    else if (strcmp(keyString, "F14") == 0) return KEY_F14;
-    else if (strcmp(keyString, "KEY_F15") == 0) return KEY_F15;
-    else if (strcmp(keyString, "F15") == 0) return KEY_F15;
-    else if (strcmp(keyString, "KEY_F16") == 0) return KEY_F16;
-    else if (strcmp(keyString, "F16") == 0) return KEY_F16;
-    else if (strcmp(keyString, "KEY_F17") == 0) return KEY_F17;
-    else if (strcmp(keyString, "F17") == 0) return KEY_F17;
-    else if (strcmp(keyString, "KEY_F18") == 0) return KEY_F18;
-    else if (strcmp(keyString, "F18") == 0) return KEY_F18;
-    else if (strcmp(keyString, "KEY_F19") == 0) return KEY_F19;
-    else if (strcmp(keyString, "F19") == 0) return KEY_F19;
-    else if (strcmp(keyString, "KEY_F20") == 0) return KEY_F20;
-    else if (strcmp(keyString, "F20") == 0) return KEY_F20;
-    else if (strcmp(keyString, "KEY_F21") == 0) return KEY_F21;
-    else if (strcmp(keyString, "F21") == 0) return KEY_F21;
-    else if (strcmp(keyString, "KEY_F22") == 0) return KEY_F22;
-    else if (strcmp(keyString, "F22") == 0) return KEY_F22;
-    else if (strcmp(keyString, "KEY_F23") == 0) return KEY_F23;
-    else if (strcmp(keyString, "F23") == 0) return KEY_F23;
-    else if (strcmp(keyString, "KEY_F24") == 0) return KEY_F24;
-    else if (strcmp(keyString, "F24") == 0) return KEY_F24;
-    else if (strcmp(keyString, "KEY_PLAYCD") == 0) return KEY_PLAYCD;
-    else if (strcmp(keyString, "PLAYCD") == 0) return KEY_PLAYCD;
-    else if (strcmp(keyString, "KEY_PAUSECD") == 0) return KEY_PAUSECD;
-    else if (strcmp(keyString, "PAUSECD") == 0) return KEY_PAUSECD;
-    else if (strcmp(keyString, "KEY_PROG3") == 0) return KEY_PROG3;
-    else if (strcmp(keyString, "PROG3") == 0) return KEY_PROG3;
-    else if (strcmp(keyString, "KEY_PROG4") == 0) return KEY_PROG4;
-    else if (strcmp(keyString, "PROG4") == 0) return KEY_PROG4;
-    else if (strcmp(keyString, "KEY_DASHBOARD") == 0) return KEY_DASHBOARD;
-    else if (strcmp(keyString, "DASHBOARD") == 0) return KEY_DASHBOARD;
-    else if (strcmp(keyString, "KEY_SUSPEND") == 0) return KEY_SUSPEND;
-    else if (strcmp(keyString, "SUSPEND") == 0) return KEY_SUSPEND;
-    else if (strcmp(keyString, "KEY_CLOSE") == 0) return KEY_CLOSE;
-    else if (strcmp(keyString, "CLOSE") == 0) return KEY_CLOSE;
-    else if (strcmp(keyString, "KEY_PLAY") == 0) return KEY_PLAY;
-    else if (strcmp(keyString, "PLAY") == 0) return KEY_PLAY;
-    else if (strcmp(keyString, "KEY_FASTFORWARD") == 0) return KEY_FASTFORWARD;
-    else if (strcmp(keyString, "FASTFORWARD") == 0) return KEY_FASTFORWARD;
-    else if (strcmp(keyString, "KEY_BASSBOOST") == 0) return KEY_BASSBOOST;
-    else if (strcmp(keyString, "BASSBOOST") == 0) return KEY_BASSBOOST;
-    else if (strcmp(keyString, "KEY_PRINT") == 0) return KEY_PRINT;
-    else if (strcmp(keyString, "PRINT") == 0) return KEY_PRINT;
-    else if (strcmp(keyString, "KEY_HP") == 0) return KEY_HP;
-    else if (strcmp(keyString, "HP") == 0) return KEY_HP;
-    else if (strcmp(keyString, "KEY_CAMERA") == 0) return KEY_CAMERA;
-    else if (strcmp(keyString, "CAMERA") == 0) return KEY_CAMERA;
-    else if (strcmp(keyString, "KEY_SOUND") == 0) return KEY_SOUND;
-    else if (strcmp(keyString, "SOUND") == 0) return KEY_SOUND;
-    else if (strcmp(keyString, "KEY_QUESTION") == 0) return KEY_QUESTION;
-    else if (strcmp(keyString, "QUESTION") == 0) return KEY_QUESTION;
-    else if (strcmp(keyString, "KEY_EMAIL") == 0) return KEY_EMAIL;
-    else if (strcmp(keyString, "EMAIL") == 0) return KEY_EMAIL;
-    else if (strcmp(keyString, "KEY_CHAT") == 0) return KEY_CHAT;
-    else if (strcmp(keyString, "CHAT") == 0) return KEY_CHAT;
-    else if (strcmp(keyString, "KEY_SEARCH") == 0) return KEY_SEARCH;
-    else if (strcmp(keyString, "SEARCH") == 0) return KEY_SEARCH;
-    else if (strcmp(keyString, "KEY_CONNECT") == 0) return KEY_CONNECT;
-    else if (strcmp(keyString, "CONNECT") == 0) return KEY_CONNECT;
-    else if (strcmp(keyString, "KEY_FINANCE") == 0) return KEY_FINANCE;
-    else if (strcmp(keyString, "FINANCE") == 0) return KEY_FINANCE;
-    else if (strcmp(keyString, "KEY_SPORT") == 0) return KEY_SPORT;
-    else if (strcmp(keyString, "SPORT") == 0) return KEY_SPORT;
-    else if (strcmp(keyString, "KEY_SHOP") == 0) return KEY_SHOP;
-    else if (strcmp(keyString, "SHOP") == 0) return KEY_SHOP;
-    else if (strcmp(keyString, "KEY_ALTERASE") == 0) return KEY_ALTERASE;
-    else if (strcmp(keyString, "ALTERASE") == 0) return KEY_ALTERASE;
-    else if (strcmp(keyString, "KEY_CANCEL") == 0) return KEY_CANCEL;
-    else if (strcmp(keyString, "CANCEL") == 0) return KEY_CANCEL;
-    else if (strcmp(keyString, "KEY_BRIGHTNESSDOWN") == 0) return KEY_BRIGHTNESSDOWN;
-    else if (strcmp(keyString, "BRIGHTNESSDOWN") == 0) return KEY_BRIGHTNESSDOWN;
-    else if (strcmp(keyString, "KEY_BRIGHTNESSUP") == 0) return KEY_BRIGHTNESSUP;
-    else if (strcmp(keyString, "BRIGHTNESSUP") == 0) return KEY_BRIGHTNESSUP;
-    else if (strcmp(keyString, "KEY_MEDIA") == 0) return KEY_MEDIA;
-    else if (strcmp(keyString, "MEDIA") == 0) return KEY_MEDIA;
-    else if (strcmp(keyString, "KEY_SWITCHVIDEOMODE") == 0) return KEY_SWITCHVIDEOMODE;
-    else if (strcmp(keyString, "SWITCHVIDEOMODE") == 0) return KEY_SWITCHVIDEOMODE;
-    else if (strcmp(keyString, "KEY_KBDILLUMTOGGLE") == 0) return KEY_KBDILLUMTOGGLE;
-    else if (strcmp(keyString, "KBDILLUMTOGGLE") == 0) return KEY_KBDILLUMTOGGLE;
-    else if (strcmp(keyString, "KEY_KBDILLUMDOWN") == 0) return KEY_KBDILLUMDOWN;
-    else if (strcmp(keyString, "KBDILLUMDOWN") == 0) return KEY_KBDILLUMDOWN;
-    else if (strcmp(keyString, "KEY_KBDILLUMUP") == 0) return KEY_KBDILLUMUP;
-    else if (strcmp(keyString, "KBDILLUMUP") == 0) return KEY_KBDILLUMUP;
-    else if (strcmp(keyString, "KEY_SEND") == 0) return KEY_SEND;
-    else if (strcmp(keyString, "SEND") == 0) return KEY_SEND;
-    else if (strcmp(keyString, "KEY_REPLY") == 0) return KEY_REPLY;
-    else if (strcmp(keyString, "REPLY") == 0) return KEY_REPLY;
-    else if (strcmp(keyString, "KEY_FORWARDMAIL") == 0) return KEY_FORWARDMAIL;
-    else if (strcmp(keyString, "FORWARDMAIL") == 0) return KEY_FORWARDMAIL;
-    else if (strcmp(keyString, "KEY_SAVE") == 0) return KEY_SAVE;
-    else if (strcmp(keyString, "SAVE") == 0) return KEY_SAVE;
-    else if (strcmp(keyString, "KEY_DOCUMENTS") == 0) return KEY_DOCUMENTS;
-    else if (strcmp(keyString, "DOCUMENTS") == 0) return KEY_DOCUMENTS;
-    else if (strcmp(keyString, "KEY_BATTERY") == 0) return KEY_BATTERY;
-    else if (strcmp(keyString, "BATTERY") == 0) return KEY_BATTERY;
-    else if (strcmp(keyString, "KEY_BLUETOOTH") == 0) return KEY_BLUETOOTH;
-    else if (strcmp(keyString, "BLUETOOTH") == 0) return KEY_BLUETOOTH;
-    else if (strcmp(keyString, "KEY_WLAN") == 0) return KEY_WLAN;
-    else if (strcmp(keyString, "WLAN") == 0) return KEY_WLAN;
-    else if (strcmp(keyString, "KEY_UWB") == 0) return KEY_UWB;
-    else if (strcmp(keyString, "UWB") == 0) return KEY_UWB;
-    else if (strcmp(keyString, "KEY_UNKNOWN") == 0) return KEY_UNKNOWN;
-    else if (strcmp(keyString, "UNKNOWN") == 0) return KEY_UNKNOWN;
-    else if (strcmp(keyString, "KEY_VIDEO_NEXT") == 0) return KEY_VIDEO_NEXT;
-    else if (strcmp(keyString, "VIDEO_NEXT") == 0) return KEY_VIDEO_NEXT;
-    else if (strcmp(keyString, "KEY_VIDEO_PREV") == 0) return KEY_VIDEO_PREV;
-    else if (strcmp(keyString, "VIDEO_PREV") == 0) return KEY_VIDEO_PREV;
-    else if (strcmp(keyString, "KEY_BRIGHTNESS_CYCLE") == 0) return KEY_BRIGHTNESS_CYCLE;
-    else if (strcmp(keyString, "BRIGHTNESS_CYCLE") == 0) return KEY_BRIGHTNESS_CYCLE;
-    else if (strcmp(keyString, "KEY_BRIGHTNESS_AUTO") == 0) return KEY_BRIGHTNESS_AUTO;
-    else if (strcmp(keyString, "BRIGHTNESS_AUTO") == 0) return KEY_BRIGHTNESS_AUTO;
-    else if (strcmp(keyString, "KEY_BRIGHTNESS_ZERO") == 0) return KEY_BRIGHTNESS_ZERO;
-    else if (strcmp(keyString, "BRIGHTNESS_ZERO") == 0) return KEY_BRIGHTNESS_ZERO;
-    else if (strcmp(keyString, "KEY_DISPLAY_OFF") == 0) return KEY_DISPLAY_OFF;
-    else if (strcmp(keyString, "DISPLAY_OFF") == 0) return KEY_DISPLAY_OFF;
-    else if (strcmp(keyString, "KEY_WWAN") == 0) return KEY_WWAN;
-    else if (strcmp(keyString, "WWAN") == 0) return KEY_WWAN;
-    else if (strcmp(keyString, "KEY_WIMAX") == 0) return KEY_WIMAX;
-    else if (strcmp(keyString, "WIMAX") == 0) return KEY_WIMAX;
-    else if (strcmp(keyString, "KEY_RFKILL") == 0) return KEY_RFKILL;
-    else if (strcmp(keyString, "RFKILL") == 0) return KEY_RFKILL;
-    else if (strcmp(keyString, "KEY_MICMUTE") == 0) return KEY_MICMUTE;
-    else if (strcmp(keyString, "MICMUTE") == 0) return KEY_MICMUTE;
-    else if (strcmp(keyString, "BTN_MISC") == 0) return BTN_MISC;
-    else if (strcmp(keyString, "BTN_0") == 0) return BTN_0;
-    else if (strcmp(keyString, "BTN_1") == 0) return BTN_1;
-    else if (strcmp(keyString, "BTN_2") == 0) return BTN_2;
-    else if (strcmp(keyString, "BTN_3") == 0) return BTN_3;
-    else if (strcmp(keyString, "BTN_4") == 0) return BTN_4;
-    else if (strcmp(keyString, "BTN_5") == 0) return BTN_5;
-    else if (strcmp(keyString, "BTN_6") == 0) return BTN_6;
-    else if (strcmp(keyString, "BTN_7") == 0) return BTN_7;
-    else if (strcmp(keyString, "BTN_8") == 0) return BTN_8;
-    else if (strcmp(keyString, "BTN_9") == 0) return BTN_9;
-    else if (strcmp(keyString, "BTN_MOUSE") == 0) return BTN_MOUSE;
-    else if (strcmp(keyString, "BTN_LEFT") == 0) return BTN_LEFT;
-    else if (strcmp(keyString, "BTN_RIGHT") == 0) return BTN_RIGHT;
-    else if (strcmp(keyString, "BTN_MIDDLE") == 0) return BTN_MIDDLE;
-    else if (strcmp(keyString, "BTN_SIDE") == 0) return BTN_SIDE;
-    else if (strcmp(keyString, "BTN_EXTRA") == 0) return BTN_EXTRA;
-    else if (strcmp(keyString, "BTN_FORWARD") == 0) return BTN_FORWARD;
-    else if (strcmp(keyString, "BTN_BACK") == 0) return BTN_BACK;
-    else if (strcmp(keyString, "BTN_TASK") == 0) return BTN_TASK;
-    else if (strcmp(keyString, "BTN_JOYSTICK") == 0) return BTN_JOYSTICK;
-    else if (strcmp(keyString, "BTN_TRIGGER") == 0) return BTN_TRIGGER;
-    else if (strcmp(keyString, "BTN_THUMB") == 0) return BTN_THUMB;
-    else if (strcmp(keyString, "BTN_THUMB2") == 0) return BTN_THUMB2;
-    else if (strcmp(keyString, "BTN_TOP") == 0) return BTN_TOP;
-    else if (strcmp(keyString, "BTN_TOP2") == 0) return BTN_TOP2;
-    else if (strcmp(keyString, "BTN_PINKIE") == 0) return BTN_PINKIE;
-    else if (strcmp(keyString, "BTN_BASE") == 0) return BTN_BASE;
-    else if (strcmp(keyString, "BTN_BASE2") == 0) return BTN_BASE2;
-    else if (strcmp(keyString, "BTN_BASE3") == 0) return BTN_BASE3;
-    else if (strcmp(keyString, "BTN_BASE4") == 0) return BTN_BASE4;
-    else if (strcmp(keyString, "BTN_BASE5") == 0) return BTN_BASE5;
-    else if (strcmp(keyString, "BTN_BASE6") == 0) return BTN_BASE6;
-    else if (strcmp(keyString, "BTN_DEAD") == 0) return BTN_DEAD;
-    else if (strcmp(keyString, "BTN_GAMEPAD") == 0) return BTN_GAMEPAD;
-    else if (strcmp(keyString, "BTN_SOUTH") == 0) return BTN_SOUTH;
-    else if (strcmp(keyString, "BTN_A") == 0) return BTN_A;
-    else if (strcmp(keyString, "BTN_EAST") == 0) return BTN_EAST;
-    else if (strcmp(keyString, "BTN_B") == 0) return BTN_B;
-    else if (strcmp(keyString, "BTN_C") == 0) return BTN_C;
-    else if (strcmp(keyString, "BTN_NORTH") == 0) return BTN_NORTH;
-    else if (strcmp(keyString, "BTN_X") == 0) return BTN_X;
-    else if (strcmp(keyString, "BTN_WEST") == 0) return BTN_WEST;
-    else if (strcmp(keyString, "BTN_Y") == 0) return BTN_Y;
-    else if (strcmp(keyString, "BTN_Z") == 0) return BTN_Z;
-    else if (strcmp(keyString, "BTN_TL") == 0) return BTN_TL;
-    else if (strcmp(keyString, "BTN_TR") == 0) return BTN_TR;
-    else if (strcmp(keyString, "BTN_TL2") == 0) return BTN_TL2;
-    else if (strcmp(keyString, "BTN_TR2") == 0) return BTN_TR2;
-    else if (strcmp(keyString, "BTN_SELECT") == 0) return BTN_SELECT;
-    else if (strcmp(keyString, "BTN_START") == 0) return BTN_START;
-    else if (strcmp(keyString, "BTN_MODE") == 0) return BTN_MODE;
-    else if (strcmp(keyString, "BTN_THUMBL") == 0) return BTN_THUMBL;
-    else if (strcmp(keyString, "BTN_THUMBR") == 0) return BTN_THUMBR;
-    else if (strcmp(keyString, "BTN_DIGI") == 0) return BTN_DIGI;
-    else if (strcmp(keyString, "BTN_TOOL_PEN") == 0) return BTN_TOOL_PEN;
-    else if (strcmp(keyString, "BTN_TOOL_RUBBER") == 0) return BTN_TOOL_RUBBER;
-    else if (strcmp(keyString, "BTN_TOOL_BRUSH") == 0) return BTN_TOOL_BRUSH;
-    else if (strcmp(keyString, "BTN_TOOL_PENCIL") == 0) return BTN_TOOL_PENCIL;
-    else if (strcmp(keyString, "BTN_TOOL_AIRBRUSH") == 0) return BTN_TOOL_AIRBRUSH;
-    else if (strcmp(keyString, "BTN_TOOL_FINGER") == 0) return BTN_TOOL_FINGER;
-    else if (strcmp(keyString, "BTN_TOOL_MOUSE") == 0) return BTN_TOOL_MOUSE;
-    else if (strcmp(keyString, "BTN_TOOL_LENS") == 0) return BTN_TOOL_LENS;
-    else if (strcmp(keyString, "BTN_TOOL_QUINTTAP") == 0) return BTN_TOOL_QUINTTAP;
-    else if (strcmp(keyString, "BTN_STYLUS3") == 0) return BTN_STYLUS3;
-    else if (strcmp(keyString, "BTN_TOUCH") == 0) return BTN_TOUCH;
-    else if (strcmp(keyString, "BTN_STYLUS") == 0) return BTN_STYLUS;
-    else if (strcmp(keyString, "BTN_STYLUS2") == 0) return BTN_STYLUS2;
-    else if (strcmp(keyString, "BTN_TOOL_DOUBLETAP") == 0) return BTN_TOOL_DOUBLETAP;
-    else if (strcmp(keyString, "BTN_TOOL_TRIPLETAP") == 0) return BTN_TOOL_TRIPLETAP;
-    else if (strcmp(keyString, "BTN_TOOL_QUADTAP") == 0) return BTN_TOOL_QUADTAP;
-    else if (strcmp(keyString, "BTN_WHEEL") == 0) return BTN_WHEEL;
-    else if (strcmp(keyString, "BTN_GEAR_DOWN") == 0) return BTN_GEAR_DOWN;
-    else if (strcmp(keyString, "BTN_GEAR_UP") == 0) return BTN_GEAR_UP;
-    else if (strcmp(keyString, "KEY_OK") == 0) return KEY_OK;
-    else if (strcmp(keyString, "OK") == 0) return KEY_OK;
-    else if (strcmp(keyString, "KEY_SELECT") == 0) return KEY_SELECT;
-    else if (strcmp(keyString, "SELECT") == 0) return KEY_SELECT;
-    else if (strcmp(keyString, "KEY_GOTO") == 0) return KEY_GOTO;
-    else if (strcmp(keyString, "GOTO") == 0) return KEY_GOTO;
-    else if (strcmp(keyString, "KEY_CLEAR") == 0) return KEY_CLEAR;
-    else if (strcmp(keyString, "CLEAR") == 0) return KEY_CLEAR;
-    else if (strcmp(keyString, "KEY_POWER2") == 0) return KEY_POWER2;
-    else if (strcmp(keyString, "POWER2") == 0) return KEY_POWER2;
-    else if (strcmp(keyString, "KEY_OPTION") == 0) return KEY_OPTION;
-    else if (strcmp(keyString, "OPTION") == 0) return KEY_OPTION;
-    else if (strcmp(keyString, "KEY_INFO") == 0) return KEY_INFO;
-    else if (strcmp(keyString, "INFO") == 0) return KEY_INFO;
-    else if (strcmp(keyString, "KEY_TIME") == 0) return KEY_TIME;
-    else if (strcmp(keyString, "TIME") == 0) return KEY_TIME;
-    else if (strcmp(keyString, "KEY_VENDOR") == 0) return KEY_VENDOR;
-    else if (strcmp(keyString, "VENDOR") == 0) return KEY_VENDOR;
-    else if (strcmp(keyString, "KEY_ARCHIVE") == 0) return KEY_ARCHIVE;
-    else if (strcmp(keyString, "ARCHIVE") == 0) return KEY_ARCHIVE;
-    else if (strcmp(keyString, "KEY_PROGRAM") == 0) return KEY_PROGRAM;
-    else if (strcmp(keyString, "PROGRAM") == 0) return KEY_PROGRAM;
-    else if (strcmp(keyString, "KEY_CHANNEL") == 0) return KEY_CHANNEL;
-    else if (strcmp(keyString, "CHANNEL") == 0) return KEY_CHANNEL;
-    else if (strcmp(keyString, "KEY_FAVORITES") == 0) return KEY_FAVORITES;
-    else if (strcmp(keyString, "FAVORITES") == 0) return KEY_FAVORITES;
-    else if (strcmp(keyString, "KEY_EPG") == 0) return KEY_EPG;
-    else if (strcmp(keyString, "EPG") == 0) return KEY_EPG;
-    else if (strcmp(keyString, "KEY_PVR") == 0) return KEY_PVR;
-    else if (strcmp(keyString, "PVR") == 0) return KEY_PVR;
-    else if (strcmp(keyString, "KEY_MHP") == 0) return KEY_MHP;
-    else if (strcmp(keyString, "MHP") == 0) return KEY_MHP;
-    else if (strcmp(keyString, "KEY_LANGUAGE") == 0) return KEY_LANGUAGE;
-    else if (strcmp(keyString, "LANGUAGE") == 0) return KEY_LANGUAGE;
-    else if (strcmp(keyString, "KEY_TITLE") == 0) return KEY_TITLE;
-    else if (strcmp(keyString, "TITLE") == 0) return KEY_TITLE;
-    else if (strcmp(keyString, "KEY_SUBTITLE") == 0) return KEY_SUBTITLE;
-    else if (strcmp(keyString, "SUBTITLE") == 0) return KEY_SUBTITLE;
-    else if (strcmp(keyString, "KEY_ANGLE") == 0) return KEY_ANGLE;
-    else if (strcmp(keyString, "ANGLE") == 0) return KEY_ANGLE;
-    else if (strcmp(keyString, "KEY_FULL_SCREEN") == 0) return KEY_FULL_SCREEN;
-    else if (strcmp(keyString, "FULL_SCREEN") == 0) return KEY_FULL_SCREEN;
-    else if (strcmp(keyString, "KEY_ZOOM") == 0) return KEY_ZOOM;
-    else if (strcmp(keyString, "ZOOM") == 0) return KEY_ZOOM;
-    else if (strcmp(keyString, "KEY_MODE") == 0) return KEY_MODE;
-    else if (strcmp(keyString, "MODE") == 0) return KEY_MODE;
-    else if (strcmp(keyString, "KEY_KEYBOARD") == 0) return KEY_KEYBOARD;
-    else if (strcmp(keyString, "KEYBOARD") == 0) return KEY_KEYBOARD;
-    else if (strcmp(keyString, "KEY_ASPECT_RATIO") == 0) return KEY_ASPECT_RATIO;
-    else if (strcmp(keyString, "ASPECT_RATIO") == 0) return KEY_ASPECT_RATIO;
-    else if (strcmp(keyString, "KEY_SCREEN") == 0) return KEY_SCREEN;
-    else if (strcmp(keyString, "SCREEN") == 0) return KEY_SCREEN;
-    else if (strcmp(keyString, "KEY_PC") == 0) return KEY_PC;
-    else if (strcmp(keyString, "PC") == 0) return KEY_PC;
-    else if (strcmp(keyString, "KEY_TV") == 0) return KEY_TV;
-    else if (strcmp(keyString, "TV") == 0) return KEY_TV;
-    else if (strcmp(keyString, "KEY_TV2") == 0) return KEY_TV2;
-    else if (strcmp(keyString, "TV2") == 0) return KEY_TV2;
-    else if (strcmp(keyString, "KEY_VCR") == 0) return KEY_VCR;
-    else if (strcmp(keyString, "VCR") == 0) return KEY_VCR;
-    else if (strcmp(keyString, "KEY_VCR2") == 0) return KEY_VCR2;
-    else if (strcmp(keyString, "VCR2") == 0) return KEY_VCR2;
-    else if (strcmp(keyString, "KEY_SAT") == 0) return KEY_SAT;
-    else if (strcmp(keyString, "SAT") == 0) return KEY_SAT;
-    else if (strcmp(keyString, "KEY_SAT2") == 0) return KEY_SAT2;
-    else if (strcmp(keyString, "SAT2") == 0) return KEY_SAT2;
-    else if (strcmp(keyString, "KEY_CD") == 0) return KEY_CD;
-    else if (strcmp(keyString, "CD") == 0) return KEY_CD;
-    else if (strcmp(keyString, "KEY_TAPE") == 0) return KEY_TAPE;
-    else if (strcmp(keyString, "TAPE") == 0) return KEY_TAPE;
-    else if (strcmp(keyString, "KEY_RADIO") == 0) return KEY_RADIO;
-    else if (strcmp(keyString, "RADIO") == 0) return KEY_RADIO;
-    else if (strcmp(keyString, "KEY_TUNER") == 0) return KEY_TUNER;
-    else if (strcmp(keyString, "TUNER") == 0) return KEY_TUNER;
-    else if (strcmp(keyString, "KEY_PLAYER") == 0) return KEY_PLAYER;
-    else if (strcmp(keyString, "PLAYER") == 0) return KEY_PLAYER;
-    else if (strcmp(keyString, "KEY_TEXT") == 0) return KEY_TEXT;
-    else if (strcmp(keyString, "TEXT") == 0) return KEY_TEXT;
-    else if (strcmp(keyString, "KEY_DVD") == 0) return KEY_DVD;
-    else if (strcmp(keyString, "DVD") == 0) return KEY_DVD;
-    else if (strcmp(keyString, "KEY_AUX") == 0) return KEY_AUX;
-    else if (strcmp(keyString, "AUX") == 0) return KEY_AUX;
-    else if (strcmp(keyString, "KEY_MP3") == 0) return KEY_MP3;
-    else if (strcmp(keyString, "MP3") == 0) return KEY_MP3;
-    else if (strcmp(keyString, "KEY_AUDIO") == 0) return KEY_AUDIO;
-    else if (strcmp(keyString, "AUDIO") == 0) return KEY_AUDIO;
-    else if (strcmp(keyString, "KEY_VIDEO") == 0) return KEY_VIDEO;
-    else if (strcmp(keyString, "VIDEO") == 0) return KEY_VIDEO;
-    else if (strcmp(keyString, "KEY_DIRECTORY") == 0) return KEY_DIRECTORY;
-    else if (strcmp(keyString, "DIRECTORY") == 0) return KEY_DIRECTORY;
-    else if (strcmp(keyString, "KEY_LIST") == 0) return KEY_LIST;
-    else if (strcmp(keyString, "LIST") == 0) return KEY_LIST;
-    else if (strcmp(keyString, "KEY_MEMO") == 0) return KEY_MEMO;
-    else if (strcmp(keyString, "MEMO") == 0) return KEY_MEMO;
-    else if (strcmp(keyString, "KEY_CALENDAR") == 0) return KEY_CALENDAR;
-    else if (strcmp(keyString, "CALENDAR") == 0) return KEY_CALENDAR;
-    else if (strcmp(keyString, "KEY_RED") == 0) return KEY_RED;
-    else if (strcmp(keyString, "RED") == 0) return KEY_RED;
-    else if (strcmp(keyString, "KEY_GREEN") == 0) return KEY_GREEN;
-    else if (strcmp(keyString, "GREEN") == 0) return KEY_GREEN;
-    else if (strcmp(keyString, "KEY_YELLOW") == 0) return KEY_YELLOW;
-    else if (strcmp(keyString, "YELLOW") == 0) return KEY_YELLOW;
-    else if (strcmp(keyString, "KEY_BLUE") == 0) return KEY_BLUE;
-    else if (strcmp(keyString, "BLUE") == 0) return KEY_BLUE;
-    else if (strcmp(keyString, "KEY_CHANNELUP") == 0) return KEY_CHANNELUP;
-    else if (strcmp(keyString, "CHANNELUP") == 0) return KEY_CHANNELUP;
-    else if (strcmp(keyString, "KEY_CHANNELDOWN") == 0) return KEY_CHANNELDOWN;
-    else if (strcmp(keyString, "CHANNELDOWN") == 0) return KEY_CHANNELDOWN;
-    else if (strcmp(keyString, "KEY_FIRST") == 0) return KEY_FIRST;
-    else if (strcmp(keyString, "FIRST") == 0) return KEY_FIRST;
-    else if (strcmp(keyString, "KEY_LAST") == 0) return KEY_LAST;
-    else if (strcmp(keyString, "LAST") == 0) return KEY_LAST;
-    else if (strcmp(keyString, "KEY_AB") == 0) return KEY_AB;
-    else if (strcmp(keyString, "AB") == 0) return KEY_AB;
-    else if (strcmp(keyString, "KEY_NEXT") == 0) return KEY_NEXT;
-    else if (strcmp(keyString, "NEXT") == 0) return KEY_NEXT;
-    else if (strcmp(keyString, "KEY_RESTART") == 0) return KEY_RESTART;
-    else if (strcmp(keyString, "RESTART") == 0) return KEY_RESTART;
-    else if (strcmp(keyString, "KEY_SLOW") == 0) return KEY_SLOW;
-    else if (strcmp(keyString, "SLOW") == 0) return KEY_SLOW;
-    else if (strcmp(keyString, "KEY_SHUFFLE") == 0) return KEY_SHUFFLE;
-    else if (strcmp(keyString, "SHUFFLE") == 0) return KEY_SHUFFLE;
-    else if (strcmp(keyString, "KEY_BREAK") == 0) return KEY_BREAK;
-    else if (strcmp(keyString, "BREAK") == 0) return KEY_BREAK;
-    else if (strcmp(keyString, "KEY_PREVIOUS") == 0) return KEY_PREVIOUS;
-    else if (strcmp(keyString, "PREVIOUS") == 0) return KEY_PREVIOUS;
-    else if (strcmp(keyString, "KEY_DIGITS") == 0) return KEY_DIGITS;
-    else if (strcmp(keyString, "DIGITS") == 0) return KEY_DIGITS;
-    else if (strcmp(keyString, "KEY_TEEN") == 0) return KEY_TEEN;
-    else if (strcmp(keyString, "TEEN") == 0) return KEY_TEEN;
-    else if (strcmp(keyString, "KEY_TWEN") == 0) return KEY_TWEN;
-    else if (strcmp(keyString, "TWEN") == 0) return KEY_TWEN;
-    else if (strcmp(keyString, "KEY_VIDEOPHONE") == 0) return KEY_VIDEOPHONE;
-    else if (strcmp(keyString, "VIDEOPHONE") == 0) return KEY_VIDEOPHONE;
-    else if (strcmp(keyString, "KEY_GAMES") == 0) return KEY_GAMES;
-    else if (strcmp(keyString, "GAMES") == 0) return KEY_GAMES;
-    else if (strcmp(keyString, "KEY_ZOOMIN") == 0) return KEY_ZOOMIN;
-    else if (strcmp(keyString, "ZOOMIN") == 0) return KEY_ZOOMIN;
-    else if (strcmp(keyString, "KEY_ZOOMOUT") == 0) return KEY_ZOOMOUT;
-    else if (strcmp(keyString, "ZOOMOUT") == 0) return KEY_ZOOMOUT;
-    else if (strcmp(keyString, "KEY_ZOOMRESET") == 0) return KEY_ZOOMRESET;
-    else if (strcmp(keyString, "ZOOMRESET") == 0) return KEY_ZOOMRESET;
-    else if (strcmp(keyString, "KEY_WORDPROCESSOR") == 0) return KEY_WORDPROCESSOR;
-    else if (strcmp(keyString, "WORDPROCESSOR") == 0) return KEY_WORDPROCESSOR;
-    else if (strcmp(keyString, "KEY_EDITOR") == 0) return KEY_EDITOR;
-    else if (strcmp(keyString, "EDITOR") == 0) return KEY_EDITOR;
-    else if (strcmp(keyString, "KEY_SPREADSHEET") == 0) return KEY_SPREADSHEET;
-    else if (strcmp(keyString, "SPREADSHEET") == 0) return KEY_SPREADSHEET;
-    else if (strcmp(keyString, "KEY_GRAPHICSEDITOR") == 0) return KEY_GRAPHICSEDITOR;
-    else if (strcmp(keyString, "GRAPHICSEDITOR") == 0) return KEY_GRAPHICSEDITOR;
-    else if (strcmp(keyString, "KEY_PRESENTATION") == 0) return KEY_PRESENTATION;
-    else if (strcmp(keyString, "PRESENTATION") == 0) return KEY_PRESENTATION;
-    else if (strcmp(keyString, "KEY_DATABASE") == 0) return KEY_DATABASE;
-    else if (strcmp(keyString, "DATABASE") == 0) return KEY_DATABASE;
-    else if (strcmp(keyString, "KEY_NEWS") == 0) return KEY_NEWS;
-    else if (strcmp(keyString, "NEWS") == 0) return KEY_NEWS;
-    else if (strcmp(keyString, "KEY_VOICEMAIL") == 0) return KEY_VOICEMAIL;
-    else if (strcmp(keyString, "VOICEMAIL") == 0) return KEY_VOICEMAIL;
-    else if (strcmp(keyString, "KEY_ADDRESSBOOK") == 0) return KEY_ADDRESSBOOK;
-    else if (strcmp(keyString, "ADDRESSBOOK") == 0) return KEY_ADDRESSBOOK;
-    else if (strcmp(keyString, "KEY_MESSENGER") == 0) return KEY_MESSENGER;
-    else if (strcmp(keyString, "MESSENGER") == 0) return KEY_MESSENGER;
-    else if (strcmp(keyString, "KEY_DISPLAYTOGGLE") == 0) return KEY_DISPLAYTOGGLE;
-    else if (strcmp(keyString, "DISPLAYTOGGLE") == 0) return KEY_DISPLAYTOGGLE;
-    else if (strcmp(keyString, "KEY_BRIGHTNESS_TOGGLE") == 0) return KEY_BRIGHTNESS_TOGGLE;
-    else if (strcmp(keyString, "BRIGHTNESS_TOGGLE") == 0) return KEY_BRIGHTNESS_TOGGLE;
-    else if (strcmp(keyString, "KEY_SPELLCHECK") == 0) return KEY_SPELLCHECK;
-    else if (strcmp(keyString, "SPELLCHECK") == 0) return KEY_SPELLCHECK;
-    else if (strcmp(keyString, "KEY_LOGOFF") == 0) return KEY_LOGOFF;
-    else if (strcmp(keyString, "LOGOFF") == 0) return KEY_LOGOFF;
-    else if (strcmp(keyString, "KEY_DOLLAR") == 0) return KEY_DOLLAR;
-    else if (strcmp(keyString, "DOLLAR") == 0) return KEY_DOLLAR;
-    else if (strcmp(keyString, "KEY_EURO") == 0) return KEY_EURO;
-    else if (strcmp(keyString, "EURO") == 0) return KEY_EURO;
-    else if (strcmp(keyString, "KEY_FRAMEBACK") == 0) return KEY_FRAMEBACK;
-    else if (strcmp(keyString, "FRAMEBACK") == 0) return KEY_FRAMEBACK;
-    else if (strcmp(keyString, "KEY_FRAMEFORWARD") == 0) return KEY_FRAMEFORWARD;
-    else if (strcmp(keyString, "FRAMEFORWARD") == 0) return KEY_FRAMEFORWARD;
-    else if (strcmp(keyString, "KEY_CONTEXT_MENU") == 0) return KEY_CONTEXT_MENU;
-    else if (strcmp(keyString, "CONTEXT_MENU") == 0) return KEY_CONTEXT_MENU;
-    else if (strcmp(keyString, "KEY_MEDIA_REPEAT") == 0) return KEY_MEDIA_REPEAT;
-    else if (strcmp(keyString, "MEDIA_REPEAT") == 0) return KEY_MEDIA_REPEAT;
-    else if (strcmp(keyString, "KEY_10CHANNELSUP") == 0) return KEY_10CHANNELSUP;
-    else if (strcmp(keyString, "10CHANNELSUP") == 0) return KEY_10CHANNELSUP;
-    else if (strcmp(keyString, "KEY_10CHANNELSDOWN") == 0) return KEY_10CHANNELSDOWN;
-    else if (strcmp(keyString, "10CHANNELSDOWN") == 0) return KEY_10CHANNELSDOWN;
-    else if (strcmp(keyString, "KEY_IMAGES") == 0) return KEY_IMAGES;
-    else if (strcmp(keyString, "IMAGES") == 0) return KEY_IMAGES;
-    else if (strcmp(keyString, "KEY_NOTIFICATION_CENTER") == 0) return KEY_NOTIFICATION_CENTER;
-    else if (strcmp(keyString, "NOTIFICATION_CENTER") == 0) return KEY_NOTIFICATION_CENTER;
-    else if (strcmp(keyString, "KEY_PICKUP_PHONE") == 0) return KEY_PICKUP_PHONE;
-    else if (strcmp(keyString, "PICKUP_PHONE") == 0) return KEY_PICKUP_PHONE;
-    else if (strcmp(keyString, "KEY_HANGUP_PHONE") == 0) return KEY_HANGUP_PHONE;
-    else if (strcmp(keyString, "HANGUP_PHONE") == 0) return KEY_HANGUP_PHONE;
-    else if (strcmp(keyString, "KEY_DEL_EOL") == 0) return KEY_DEL_EOL;
-    else if (strcmp(keyString, "DEL_EOL") == 0) return KEY_DEL_EOL;
-    else if (strcmp(keyString, "KEY_DEL_EOS") == 0) return KEY_DEL_EOS;
-    else if (strcmp(keyString, "DEL_EOS") == 0) return KEY_DEL_EOS;
-    else if (strcmp(keyString, "KEY_INS_LINE") == 0) return KEY_INS_LINE;
-    else if (strcmp(keyString, "INS_LINE") == 0) return KEY_INS_LINE;
-    else if (strcmp(keyString, "KEY_DEL_LINE") == 0) return KEY_DEL_LINE;
-    else if (strcmp(keyString, "DEL_LINE") == 0) return KEY_DEL_LINE;
-    else if (strcmp(keyString, "KEY_FN") == 0) return KEY_FN;
-    else if (strcmp(keyString, "FN") == 0) return KEY_FN;
-    else if (strcmp(keyString, "KEY_FN_ESC") == 0) return KEY_FN_ESC;
-    else if (strcmp(keyString, "FN_ESC") == 0) return KEY_FN_ESC;
-    else if (strcmp(keyString, "KEY_FN_F1") == 0) return KEY_FN_F1;
-    else if (strcmp(keyString, "FN_F1") == 0) return KEY_FN_F1;
-    else if (strcmp(keyString, "KEY_FN_F2") == 0) return KEY_FN_F2;
-    else if (strcmp(keyString, "FN_F2") == 0) return KEY_FN_F2;
-    else if (strcmp(keyString, "KEY_FN_F3") == 0) return KEY_FN_F3;
-    else if (strcmp(keyString, "FN_F3") == 0) return KEY_FN_F3;
-    else if (strcmp(keyString, "KEY_FN_F4") == 0) return KEY_FN_F4;
-    else if (strcmp(keyString, "FN_F4") == 0) return KEY_FN_F4;
-    else if (strcmp(keyString, "KEY_FN_F5") == 0) return KEY_FN_F5;
-    else if (strcmp(keyString, "FN_F5") == 0) return KEY_FN_F5;
-    else if (strcmp(keyString, "KEY_FN_F6") == 0) return KEY_FN_F6;
-    else if (strcmp(keyString, "FN_F6") == 0) return KEY_FN_F6;
-    else if (strcmp(keyString, "KEY_FN_F7") == 0) return KEY_FN_F7;
-    else if (strcmp(keyString, "FN_F7") == 0) return KEY_FN_F7;
-    else if (strcmp(keyString, "KEY_FN_F8") == 0) return KEY_FN_F8;
-    else if (strcmp(keyString, "FN_F8") == 0) return KEY_FN_F8;
-    else if (strcmp(keyString, "KEY_FN_F9") == 0) return KEY_FN_F9;
-    else if (strcmp(keyString, "FN_F9") == 0) return KEY_FN_F9;
-    else if (strcmp(keyString, "KEY_FN_F10") == 0) return KEY_FN_F10;
-    else if (strcmp(keyString, "FN_F10") == 0) return KEY_FN_F10;
-    else if (strcmp(keyString, "KEY_FN_F11") == 0) return KEY_FN_F11;
-    else if (strcmp(keyString, "FN_F11") == 0) return KEY_FN_F11;
-    else if (strcmp(keyString, "KEY_FN_F12") == 0) return KEY_FN_F12;
-    else if (strcmp(keyString, "FN_F12") == 0) return KEY_FN_F12;
-    else if (strcmp(keyString, "KEY_FN_1") == 0) return KEY_FN_1;
-    else if (strcmp(keyString, "FN_1") == 0) return KEY_FN_1;
-    else if (strcmp(keyString, "KEY_FN_2") == 0) return KEY_FN_2;
-    else if (strcmp(keyString, "FN_2") == 0) return KEY_FN_2;
-    else if (strcmp(keyString, "KEY_FN_D") == 0) return KEY_FN_D;
-    else if (strcmp(keyString, "FN_D") == 0) return KEY_FN_D;
-    else if (strcmp(keyString, "KEY_FN_E") == 0) return KEY_FN_E;
-    else if (strcmp(keyString, "FN_E") == 0) return KEY_FN_E;
-    else if (strcmp(keyString, "KEY_FN_F") == 0) return KEY_FN_F;
-    else if (strcmp(keyString, "FN_F") == 0) return KEY_FN_F;
-    else if (strcmp(keyString, "KEY_FN_S") == 0) return KEY_FN_S;
-    else if (strcmp(keyString, "FN_S") == 0) return KEY_FN_S;
-    else if (strcmp(keyString, "KEY_FN_B") == 0) return KEY_FN_B;
-    else if (strcmp(keyString, "FN_B") == 0) return KEY_FN_B;
-    else if (strcmp(keyString, "KEY_FN_RIGHT_SHIFT") == 0) return KEY_FN_RIGHT_SHIFT;
-    else if (strcmp(keyString, "FN_RIGHT_SHIFT") == 0) return KEY_FN_RIGHT_SHIFT;
-    else if (strcmp(keyString, "KEY_BRL_DOT1") == 0) return KEY_BRL_DOT1;
-    else if (strcmp(keyString, "BRL_DOT1") == 0) return KEY_BRL_DOT1;
-    else if (strcmp(keyString, "KEY_BRL_DOT2") == 0) return KEY_BRL_DOT2;
-    else if (strcmp(keyString, "BRL_DOT2") == 0) return KEY_BRL_DOT2;
-    else if (strcmp(keyString, "KEY_BRL_DOT3") == 0) return KEY_BRL_DOT3;
-    else if (strcmp(keyString, "BRL_DOT3") == 0) return KEY_BRL_DOT3;
-    else if (strcmp(keyString, "KEY_BRL_DOT4") == 0) return KEY_BRL_DOT4;
-    else if (strcmp(keyString, "BRL_DOT4") == 0) return KEY_BRL_DOT4;
-    else if (strcmp(keyString, "KEY_BRL_DOT5") == 0) return KEY_BRL_DOT5;
-    else if (strcmp(keyString, "BRL_DOT5") == 0) return KEY_BRL_DOT5;
-    else if (strcmp(keyString, "KEY_BRL_DOT6") == 0) return KEY_BRL_DOT6;
-    else if (strcmp(keyString, "BRL_DOT6") == 0) return KEY_BRL_DOT6;
-    else if (strcmp(keyString, "KEY_BRL_DOT7") == 0) return KEY_BRL_DOT7;
-    else if (strcmp(keyString, "BRL_DOT7") == 0) return KEY_BRL_DOT7;
-    else if (strcmp(keyString, "KEY_BRL_DOT8") == 0) return KEY_BRL_DOT8;
-    else if (strcmp(keyString, "BRL_DOT8") == 0) return KEY_BRL_DOT8;
-    else if (strcmp(keyString, "KEY_BRL_DOT9") == 0) return KEY_BRL_DOT9;
-    else if (strcmp(keyString, "BRL_DOT9") == 0) return KEY_BRL_DOT9;
-    else if (strcmp(keyString, "KEY_BRL_DOT10") == 0) return KEY_BRL_DOT10;
-    else if (strcmp(keyString, "BRL_DOT10") == 0) return KEY_BRL_DOT10;
-    else if (strcmp(keyString, "KEY_NUMERIC_0") == 0) return KEY_NUMERIC_0;
-    else if (strcmp(keyString, "NUMERIC_0") == 0) return KEY_NUMERIC_0;
-    else if (strcmp(keyString, "KEY_NUMERIC_1") == 0) return KEY_NUMERIC_1;
-    else if (strcmp(keyString, "NUMERIC_1") == 0) return KEY_NUMERIC_1;
-    else if (strcmp(keyString, "KEY_NUMERIC_2") == 0) return KEY_NUMERIC_2;
-    else if (strcmp(keyString, "NUMERIC_2") == 0) return KEY_NUMERIC_2;
-    else if (strcmp(keyString, "KEY_NUMERIC_3") == 0) return KEY_NUMERIC_3;
-    else if (strcmp(keyString, "NUMERIC_3") == 0) return KEY_NUMERIC_3;
-    else if (strcmp(keyString, "KEY_NUMERIC_4") == 0) return KEY_NUMERIC_4;
-    else if (strcmp(keyString, "NUMERIC_4") == 0) return KEY_NUMERIC_4;
-    else if (strcmp(keyString, "KEY_NUMERIC_5") == 0) return KEY_NUMERIC_5;
-    else if (strcmp(keyString, "NUMERIC_5") == 0) return KEY_NUMERIC_5;
-    else if (strcmp(keyString, "KEY_NUMERIC_6") == 0) return KEY_NUMERIC_6;
-    else if (strcmp(keyString, "NUMERIC_6") == 0) return KEY_NUMERIC_6;
-    else if (strcmp(keyString, "KEY_NUMERIC_7") == 0) return KEY_NUMERIC_7;
-    else if (strcmp(keyString, "NUMERIC_7") == 0) return KEY_NUMERIC_7;
-    else if (strcmp(keyString, "KEY_NUMERIC_8") == 0) return KEY_NUMERIC_8;
-    else if (strcmp(keyString, "NUMERIC_8") == 0) return KEY_NUMERIC_8;
-    else if (strcmp(keyString, "KEY_NUMERIC_9") == 0) return KEY_NUMERIC_9;
-    else if (strcmp(keyString, "NUMERIC_9") == 0) return KEY_NUMERIC_9;
-    else if (strcmp(keyString, "KEY_NUMERIC_STAR") == 0) return KEY_NUMERIC_STAR;
-    else if (strcmp(keyString, "NUMERIC_STAR") == 0) return KEY_NUMERIC_STAR;
-    else if (strcmp(keyString, "KEY_NUMERIC_POUND") == 0) return KEY_NUMERIC_POUND;
-    else if (strcmp(keyString, "NUMERIC_POUND") == 0) return KEY_NUMERIC_POUND;
-    else if (strcmp(keyString, "KEY_NUMERIC_A") == 0) return KEY_NUMERIC_A;
-    else if (strcmp(keyString, "NUMERIC_A") == 0) return KEY_NUMERIC_A;
-    else if (strcmp(keyString, "KEY_NUMERIC_B") == 0) return KEY_NUMERIC_B;
-    else if (strcmp(keyString, "NUMERIC_B") == 0) return KEY_NUMERIC_B;
-    else if (strcmp(keyString, "KEY_NUMERIC_C") == 0) return KEY_NUMERIC_C;
-    else if (strcmp(keyString, "NUMERIC_C") == 0) return KEY_NUMERIC_C;
-    else if (strcmp(keyString, "KEY_NUMERIC_D") == 0) return KEY_NUMERIC_D;
-    else if (strcmp(keyString, "NUMERIC_D") == 0) return KEY_NUMERIC_D;
-    else if (strcmp(keyString, "KEY_CAMERA_FOCUS") == 0) return KEY_CAMERA_FOCUS;
-    else if (strcmp(keyString, "CAMERA_FOCUS") == 0) return KEY_CAMERA_FOCUS;
-    else if (strcmp(keyString, "KEY_WPS_BUTTON") == 0) return KEY_WPS_BUTTON;
-    else if (strcmp(keyString, "WPS_BUTTON") == 0) return KEY_WPS_BUTTON;
-    else if (strcmp(keyString, "KEY_TOUCHPAD_TOGGLE") == 0) return KEY_TOUCHPAD_TOGGLE;
-    else if (strcmp(keyString, "TOUCHPAD_TOGGLE") == 0) return KEY_TOUCHPAD_TOGGLE;
-    else if (strcmp(keyString, "KEY_TOUCHPAD_ON") == 0) return KEY_TOUCHPAD_ON;
-    else if (strcmp(keyString, "TOUCHPAD_ON") == 0) return KEY_TOUCHPAD_ON;
-    else if (strcmp(keyString, "KEY_TOUCHPAD_OFF") == 0) return KEY_TOUCHPAD_OFF;
-    else if (strcmp(keyString, "TOUCHPAD_OFF") == 0) return KEY_TOUCHPAD_OFF;
-    else if (strcmp(keyString, "KEY_CAMERA_ZOOMIN") == 0) return KEY_CAMERA_ZOOMIN;
-    else if (strcmp(keyString, "CAMERA_ZOOMIN") == 0) return KEY_CAMERA_ZOOMIN;
-    else if (strcmp(keyString, "KEY_CAMERA_ZOOMOUT") == 0) return KEY_CAMERA_ZOOMOUT;
-    else if (strcmp(keyString, "CAMERA_ZOOMOUT") == 0) return KEY_CAMERA_ZOOMOUT;
-    else if (strcmp(keyString, "KEY_CAMERA_UP") == 0) return KEY_CAMERA_UP;
-    else if (strcmp(keyString, "CAMERA_UP") == 0) return KEY_CAMERA_UP;
-    else if (strcmp(keyString, "KEY_CAMERA_DOWN") == 0) return KEY_CAMERA_DOWN;
-    else if (strcmp(keyString, "CAMERA_DOWN") == 0) return KEY_CAMERA_DOWN;
-    else if (strcmp(keyString, "KEY_CAMERA_LEFT") == 0) return KEY_CAMERA_LEFT;
-    else if (strcmp(keyString, "CAMERA_LEFT") == 0) return KEY_CAMERA_LEFT;
-    else if (strcmp(keyString, "KEY_CAMERA_RIGHT") == 0) return KEY_CAMERA_RIGHT;
-    else if (strcmp(keyString, "CAMERA_RIGHT") == 0) return KEY_CAMERA_RIGHT;
-    else if (strcmp(keyString, "KEY_ATTENDANT_ON") == 0) return KEY_ATTENDANT_ON;
-    else if (strcmp(keyString, "ATTENDANT_ON") == 0) return KEY_ATTENDANT_ON;
-    else if (strcmp(keyString, "KEY_ATTENDANT_OFF") == 0) return KEY_ATTENDANT_OFF;
-    else if (strcmp(keyString, "ATTENDANT_OFF") == 0) return KEY_ATTENDANT_OFF;
-    else if (strcmp(keyString, "KEY_ATTENDANT_TOGGLE") == 0) return KEY_ATTENDANT_TOGGLE;
-    else if (strcmp(keyString, "ATTENDANT_TOGGLE") == 0) return KEY_ATTENDANT_TOGGLE;
-    else if (strcmp(keyString, "KEY_LIGHTS_TOGGLE") == 0) return KEY_LIGHTS_TOGGLE;
-    else if (strcmp(keyString, "LIGHTS_TOGGLE") == 0) return KEY_LIGHTS_TOGGLE;
-    else if (strcmp(keyString, "BTN_DPAD_UP") == 0) return BTN_DPAD_UP;
-    else if (strcmp(keyString, "BTN_DPAD_DOWN") == 0) return BTN_DPAD_DOWN;
-    else if (strcmp(keyString, "BTN_DPAD_LEFT") == 0) return BTN_DPAD_LEFT;
-    else if (strcmp(keyString, "BTN_DPAD_RIGHT") == 0) return BTN_DPAD_RIGHT;
-    else if (strcmp(keyString, "KEY_ALS_TOGGLE") == 0) return KEY_ALS_TOGGLE;
-    else if (strcmp(keyString, "ALS_TOGGLE") == 0) return KEY_ALS_TOGGLE;
-    else if (strcmp(keyString, "KEY_ROTATE_LOCK_TOGGLE") == 0) return KEY_ROTATE_LOCK_TOGGLE;
-    else if (strcmp(keyString, "ROTATE_LOCK_TOGGLE") == 0) return KEY_ROTATE_LOCK_TOGGLE;
-    else if (strcmp(keyString, "KEY_RIGHT_UP") == 0) return KEY_RIGHT_UP;
-    else if (strcmp(keyString, "KEY_RIGHT_DOWN") == 0) return KEY_RIGHT_DOWN;
-    else if (strcmp(keyString, "KEY_LEFT_UP") == 0) return KEY_LEFT_UP;
-    else if (strcmp(keyString, "KEY_LEFT_DOWN") == 0) return KEY_LEFT_DOWN;
-    else return 0;
+    const struct key_name* key = bsearch(keyString, key_names, sizeof(key_names) / sizeof(key_names[0]),
+        sizeof(key_names[0]), compare_key_name);
+    return key != NULL ? key->code : 0;
+}
+
+/**
+ * Converts a key code to its name (e.g. "KEY_I").
+ * Returns NULL if the code has no name.
+ * */
+const char* convertKeyCodeToString(int code)
+{
+    for (size_t i = 0; i < sizeof(key_names) / sizeof(key_names[0]); i++)
+    {
+        if (key_names[i].code == code
+            && (strncmp(key_names[i].name, "KEY_", 4) == 0 || strncmp(key_names[i].name, "BTN_", 4) == 0))
+        {
+            return key_names[i].name;
+        }
+    }
+    return NULL;
 }
 
 /**
@@ -21,6 +21,12 @@
  * */
 int convertKeyStringToCode(char* keyString);
 
+/**
+ * Converts a key code to its name (e.g. "KEY_I").
+ * Returns NULL if the code has no name.
+ * */
+const char* convertKeyCodeToString(int code);
+
 /**
  * Checks if the event is a key down.
  * */
@@ -0,0 +1,259 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "clock.h"
+#include "log.h"
+
+enum log_levels log_level = log_info;
+int log_journal = 0;
+int log_unlimited = 0;
+
+// A held message
+struct log_record
+{
+    enum log_levels level;
+    int length;
+    char text[LOG_RECORD_LENGTH];
+};
+
+// The held messages, written by log_message and read by flush_log on the same thread
+static struct log_record records[LOG_RECORDS];
+static unsigned int head = 0;
+static unsigned int tail = 0;
+static unsigned int dropped = 0;
+static int deferred = 0;
+
+static const char* level_names[] = { "error", "warning", "info", "debug" };
+
+// The journal socket, opened on the first message written to the journal
+static int journal_descriptor = -1;
+
+/**
+ * Writes a message to the journal with the native protocol.
+ * New lines inside the message are replaced with spaces.
+ *
+ * @return int 1 if the message was written, 0 if the journal is busy, -1 if it failed.
+ * */
+static int write_journal(const struct log_record* record, int wait)
+{
+    if (journal_descriptor < 0)
+    {
+        journal_descriptor = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (journal_descriptor < 0)
+        {
+            return -1;
+        }
+    }
+    // The journal priorities are the syslog levels: error 3, warning 4, info 6 and debug 7
+    char datagram[LOG_RECORD_LENGTH + 64];
+    int length = snprintf(datagram, sizeof(datagram), "PRIORITY=%i\nSYSLOG_IDENTIFIER=touchcursor\nMESSAGE=",
+        3 + record->level + (record->level >= log_info));
+    for (int i = 0; i < record->length - 1; i++)
+    {
+        datagram[length++] = record->text[i] == '\n' ? ' ' : record->text[i];
+    }
+    datagram[length++] = '\n';
+    struct sockaddr_un address = { .sun_family = AF_UNIX, .sun_path = "/run/systemd/journal/socket" };
+    if (sendto(journal_descriptor, datagram, length, MSG_NOSIGNAL | (wait ? 0 : MSG_DONTWAIT),
+            (struct sockaddr*)&address, sizeof(address)) < 0)
+    {
+        return errno == EAGAIN ? 0 : -1;
+    }
+    return 1;
+}
+
+/**
+ * Writes a message to stdout, or stderr for errors.
+ * Without waiting, the message is only written if the descriptor is ready,
+ * a message is shorter than PIPE_BUF so a ready pipe takes all of it.
+ * Waiting, the message goes through the stdio stream to keep the order of
+ * other output.
+ *
+ * @return int 1 if the message was written, 0 if the descriptor is busy, -1 if it failed.
+ * */
+static int write_record(const struct log_record* record, int wait)
+{
+    if (log_journal)
+    {
+        int result = write_journal(record, wait);
+        if (result >= 0)
+        {
+            return result;
+        }
+    }
+    FILE* stream = record->level == log_error ? stderr : stdout;
+    if (wait)
+    {
+        fputs(record->text, stream);
+        fflush(stream);
+        return 1;
+    }
+    struct pollfd ready = { .fd = fileno(stream), .events = POLLOUT };
+    if (poll(&ready, 1, 0) == 0)
+    {
+        return 0;
+    }
+    return write(ready.fd, record->text, record->length) < 0 && errno == EAGAIN ? 0 : 1;
+}
+
+/**
+ * Formats a message into a record, ending it with a new line.
+ * */
+static void format_record(struct log_record* record, enum log_levels level, const char* format, va_list arguments)
+{
+    record->level = level;
+    int length = vsnprintf(record->text, sizeof(record->text), format, arguments);
+    if (length < 0)
+    {
+        length = 0;
+    }
+    if (length >= (int)sizeof(record->text))
+    {
+        length = sizeof(record->text) - 1;
+    }
+    if (length == 0 || record->text[length - 1] != '\n')
+    {
+        if (length == (int)sizeof(record->text) - 1)
+        {
+            length--;
+        }
+        record->text[length++] = '\n';
+        record->text[length] = '\0';
+    }
+    record->length = length;
+}
+
+/**
+ * Holds a formatted record, or writes it immediately if messages are not deferred.
+ * */
+static void hold_record(enum log_levels level, const char* format, va_list arguments)
+{
+    if (!deferred)
+    {
+        struct log_record record;
+        format_record(&record, level, format, arguments);
+        write_record(&record, 1);
+    }
+    else if (tail - head >= LOG_RECORDS)
+    {
+        dropped++;
+    }
+    else
+    {
+        format_record(&records[tail++ % LOG_RECORDS], level, format, arguments);
+    }
+}
+
+/**
+ * Holds a record formatted from the arguments.
+ * */
+static void add_record(enum log_levels level, const char* format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    hold_record(level, format, arguments);
+    va_end(arguments);
+}
+
+/**
+ * Checks the rate limit of a call site, reporting the messages it suppressed once a new window starts.
+ *
+ * @return int 1 if the site may log, otherwise 0.
+ * */
+static int check_rate_limit(struct log_site* site, enum log_levels level)
+{
+    uint64_t now = monotonic_time();
+    if (site->window == 0 || now >= site->window + LOG_WINDOW * 1000000ULL)
+    {
+        if (site->suppressed > 0)
+        {
+            add_record(level, "%s: %u similar messages suppressed\n", level_names[level], site->suppressed);
+        }
+        site->window = now;
+        site->count = 0;
+        site->suppressed = 0;
+    }
+    if (site->count >= LOG_BURST)
+    {
+        site->suppressed++;
+        return 0;
+    }
+    site->count++;
+    return 1;
+}
+
+/**
+ * Logs a message for a call site, rate limited per site unless log_unlimited is set.
+ * Messages are written immediately, or held until flush_log is called once defer_log was called.
+ *
+ * @return int 1 if the message was logged, 0 if it was filtered by its level or rate limited.
+ * */
+int log_message(struct log_site* site, enum log_levels level, const char* format, ...)
+{
+    if (level > log_level || (!log_unlimited && !check_rate_limit(site, level)))
+    {
+        return 0;
+    }
+    va_list arguments;
+    va_start(arguments, format);
+    hold_record(level, format, arguments);
+    va_end(arguments);
+    return 1;
+}
+
+/**
+ * Holds the messages until flush_log is called, so logging never blocks the caller.
+ * */
+void defer_log()
+{
+    deferred = 1;
+}
+
+/**
+ * Writes the held messages that can be written without blocking.
+ *
+ * @return int The number of messages still held.
+ * */
+int flush_log()
+{
+    while (head != tail)
+    {
+        if (write_record(&records[head % LOG_RECORDS], 0) == 0)
+        {
+            return tail - head;
+        }
+        head++;
+    }
+    if (dropped > 0)
+    {
+        unsigned int count = dropped;
+        dropped = 0;
+        add_record(log_warning, "warning: %u log messages dropped\n", count);
+        return flush_log();
+    }
+    return 0;
+}
+
+/**
+ * Writes all the held messages, waiting if needed, and stops holding messages.
+ * */
+void stop_log()
+{
+    while (head != tail)
+    {
+        write_record(&records[head++ % LOG_RECORDS], 1);
+    }
+    deferred = 0;
+    if (dropped > 0)
+    {
+        add_record(log_warning, "warning: %u log messages dropped\n", dropped);
+        dropped = 0;
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef log_h
+#define log_h
+
+#include <stdint.h>
+
+// The log levels, a message is written if its level is at most the log level
+enum log_levels
+{
+    log_error,
+    log_warning,
+    log_info,
+    log_debug
+};
+
+// The number of messages a call site may write in a rate limit window, and the window in seconds
+#define LOG_BURST 5
+#define LOG_WINDOW 10
+
+// The number of messages held until the event loop writes them, and the length of a message
+#define LOG_RECORDS 128
+#define LOG_RECORD_LENGTH 256
+
+// The time to wait before retrying to write held messages, in milliseconds
+#define LOG_RETRY_DELAY 50
+
+/**
+ * The rate limit state of a call site of the logging macros.
+ * */
+struct log_site
+{
+    uint64_t window;
+    unsigned int count;
+    unsigned int suppressed;
+};
+
+/**
+ * The log level.
+ * */
+extern enum log_levels log_level;
+
+/**
+ * Writes the messages to the systemd journal instead of stdout and stderr.
+ * */
+extern int log_journal;
+
+/**
+ * Writes every message without the rate limit, set while the configuration is parsed
+ * so a configuration with many bad lines reports all of them.
+ * */
+extern int log_unlimited;
+
+/**
+ * Logs a message for a call site, rate limited per site unless log_unlimited is set.
+ * Messages are written immediately, or held until flush_log is called once defer_log was called.
+ *
+ * @return int 1 if the message was logged, 0 if it was filtered by its level or rate limited.
+ * */
+int log_message(struct log_site* site, enum log_levels level, const char* format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+/**
+ * Holds the messages until flush_log is called, so logging never blocks the caller.
+ * */
+void defer_log();
+
+/**
+ * Writes the held messages that can be written without blocking.
+ *
+ * @return int The number of messages still held.
+ * */
+int flush_log();
+
+/**
+ * Writes all the held messages, waiting if needed, and stops holding messages.
+ * */
+void stop_log();
+
+#endif
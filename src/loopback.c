@@ -0,0 +1,597 @@
+// build
+// make loopback
+// run (needs access to /dev/uinput and /dev/input, usually as root)
+// ./out/touchcursor_loopback [daemon] [events]
+
+#define _GNU_SOURCE
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <linux/uinput.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Measures the latency from a synthetic keyboard to the virtual keyboard of
+ * the daemon. The benchmark creates a source keyboard with uinput, runs the
+ * daemon on a configuration that captures it, injects scripted keystrokes at
+ * increasing rates and reads the output from the event node of the virtual
+ * keyboard. The output events are timestamped by the kernel on the monotonic
+ * clock when the daemon writes them, so the latency covers the input core,
+ * the daemon and the write to uinput.
+ */
+
+// The names of the source keyboard and of the virtual keyboard of the daemon
+#define SOURCE_NAME "TouchCursor Loopback Keyboard"
+#define OUTPUT_NAME "Virtual TouchCursor Keyboard"
+
+// The key tapped to check that the daemon captured the source keyboard
+#define PROBE_KEY KEY_F24
+
+// The time to wait for the daemon to create its keyboard and capture the source, in milliseconds
+#define STARTUP_TIMEOUT 5000
+
+// The time to wait for outstanding output events after the last injection, in milliseconds
+#define DRAIN_TIMEOUT 1000
+
+// The configuration of the daemon
+static const char configuration[] =
+    "[Device]\n"
+    "Name=\"" SOURCE_NAME "\"\n"
+    "[Hyper]\n"
+    "HYPER1=KEY_SPACE\n"
+    "[Bindings]\n"
+    "KEY_J=KEY_LEFT\n";
+
+/*
+ * A scripted keystroke, the key it sends on the output (or 0 if it sends
+ * nothing), and whether its latency is measured.
+ */
+struct keystroke
+{
+    int code;
+    int value;
+    int output;
+    int measured;
+};
+
+/*
+ * A script, replayed until the number of events is injected.
+ */
+struct script
+{
+    const char* name;
+    const struct keystroke* keystrokes;
+    int length;
+};
+
+// Typing an unmapped key
+static const struct keystroke passthrough[] = {
+    { KEY_A, 1, KEY_A, 1 }, { KEY_A, 0, KEY_A, 1 }
+};
+
+// Holding the hyper key and moving the cursor
+// The first mapped key is held back until the next event decides it, so it is not measured
+static const struct keystroke hyper_navigation[] = {
+    { KEY_SPACE, 1, 0, 0 },
+    { KEY_J, 1, KEY_LEFT, 0 }, { KEY_J, 0, KEY_LEFT, 1 }, { KEY_J, 1, KEY_LEFT, 1 }, { KEY_J, 0, KEY_LEFT, 1 },
+    { KEY_J, 1, KEY_LEFT, 1 }, { KEY_J, 0, KEY_LEFT, 1 }, { KEY_J, 1, KEY_LEFT, 1 }, { KEY_J, 0, KEY_LEFT, 1 },
+    { KEY_SPACE, 0, 0, 0 }
+};
+
+#define script(array) { #array, array, sizeof(array) / sizeof(array[0]) }
+static const struct script scripts[] = {
+    script(passthrough),
+    script(hyper_navigation),
+};
+
+// The injection rates in events per second, 0 injects as fast as possible
+static const int rates[] = { 500, 1000, 2000, 5000, 10000, 0 };
+
+/*
+ * A run of a script at a rate, shared by the injecting thread and the reader.
+ */
+struct run
+{
+    const struct script* script;
+    int rate;
+    int length;
+    // The injected keystrokes, and the injection time of each, in nanoseconds
+    struct keystroke* keystrokes;
+    long long* injected;
+    // The number of keystrokes injected
+    int count;
+};
+
+static int source_descriptor = -1;
+static pid_t daemon_pid = -1;
+static char home[64];
+
+/*
+ * Returns the monotonic time in nanoseconds.
+ */
+static long long now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * 1000000000LL + time.tv_nsec;
+}
+
+/*
+ * Creates the source keyboard.
+ */
+static int create_source()
+{
+    source_descriptor = open("/dev/uinput", O_WRONLY | O_NONBLOCK);
+    if (source_descriptor < 0)
+    {
+        fprintf(stderr, "error: failed to open /dev/uinput: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    struct uinput_setup setup;
+    memset(&setup, 0, sizeof(setup));
+    strcpy(setup.name, SOURCE_NAME);
+    setup.id.bustype = BUS_VIRTUAL;
+    setup.id.vendor = 0x01;
+    setup.id.product = 0x02;
+    setup.id.version = 1;
+    if (ioctl(source_descriptor, UI_SET_EVBIT, EV_KEY) < 0)
+    {
+        fprintf(stderr, "error: failed to set EV_KEY on the source keyboard: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    for (int code = 1; code < 256; code++)
+    {
+        if (ioctl(source_descriptor, UI_SET_KEYBIT, code) < 0)
+        {
+            fprintf(stderr, "error: failed to set key bit %i on the source keyboard: %s\n", code, strerror(errno));
+            return EXIT_FAILURE;
+        }
+    }
+    if (ioctl(source_descriptor, UI_DEV_SETUP, &setup) < 0 || ioctl(source_descriptor, UI_DEV_CREATE) < 0)
+    {
+        fprintf(stderr, "error: failed to create the source keyboard: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Finds the event node of an input device by name.
+ */
+static int find_event_path(const char* name, char* path, size_t size)
+{
+    DIR* directory = opendir("/sys/class/input");
+    if (!directory)
+    {
+        return EXIT_FAILURE;
+    }
+    int result = EXIT_FAILURE;
+    struct dirent* entry;
+    while (result != EXIT_SUCCESS && (entry = readdir(directory)) != NULL)
+    {
+        if (strncmp(entry->d_name, "event", 5) != 0)
+        {
+            continue;
+        }
+        char name_path[512];
+        snprintf(name_path, sizeof(name_path), "/sys/class/input/%s/device/name", entry->d_name);
+        FILE* file = fopen(name_path, "r");
+        if (!file)
+        {
+            continue;
+        }
+        char device_name[256];
+        if (fgets(device_name, sizeof(device_name), file))
+        {
+            device_name[strcspn(device_name, "\n")] = '\0';
+            if (strcmp(device_name, name) == 0)
+            {
+                snprintf(path, size, "/dev/input/%s", entry->d_name);
+                result = EXIT_SUCCESS;
+            }
+        }
+        fclose(file);
+    }
+    closedir(directory);
+    return result;
+}
+
+/*
+ * Writes the daemon configuration in a temporary home directory.
+ */
+static int write_configuration()
+{
+    strcpy(home, "/tmp/touchcursor-loopback-XXXXXX");
+    if (!mkdtemp(home))
+    {
+        fprintf(stderr, "error: failed to create a temporary directory: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    char path[128];
+    snprintf(path, sizeof(path), "%s/.config", home);
+    mkdir(path, 0700);
+    snprintf(path, sizeof(path), "%s/.config/touchcursor", home);
+    mkdir(path, 0700);
+    snprintf(path, sizeof(path), "%s/.config/touchcursor/touchcursor.conf", home);
+    FILE* file = fopen(path, "w");
+    if (!file)
+    {
+        fprintf(stderr, "error: failed to write %s: %s\n", path, strerror(errno));
+        return EXIT_FAILURE;
+    }
+    fputs(configuration, file);
+    fclose(file);
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Removes the temporary home directory.
+ */
+static void remove_configuration()
+{
+    char path[128];
+    snprintf(path, sizeof(path), "%s/.config/touchcursor/touchcursor.conf", home);
+    unlink(path);
+    snprintf(path, sizeof(path), "%s/.config/touchcursor", home);
+    rmdir(path);
+    snprintf(path, sizeof(path), "%s/.config", home);
+    rmdir(path);
+    rmdir(home);
+}
+
+/*
+ * Starts the daemon with the temporary home directory, its output is discarded.
+ */
+static int start_daemon(const char* daemon)
+{
+    daemon_pid = fork();
+    if (daemon_pid < 0)
+    {
+        fprintf(stderr, "error: failed to start the daemon: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    if (daemon_pid == 0)
+    {
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, STDOUT_FILENO);
+        dup2(null, STDERR_FILENO);
+        setenv("HOME", home, 1);
+        execl(daemon, daemon, (char*)NULL);
+        _exit(EXIT_FAILURE);
+    }
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Writes a key event to the source keyboard.
+ */
+static void write_key(int code, int value)
+{
+    struct input_event events[2];
+    memset(events, 0, sizeof(events));
+    events[0].type = EV_KEY;
+    events[0].code = code;
+    events[0].value = value;
+    events[1].type = EV_SYN;
+    events[1].code = SYN_REPORT;
+    while (write(source_descriptor, events, sizeof(events)) < 0 && errno == EAGAIN)
+    {
+    }
+}
+
+/*
+ * Waits until the daemon has created its keyboard and captured the source keyboard, then opens the output.
+ * The daemon reads the source keyboard once it has grabbed it, so a probe key
+ * is tapped until it comes out of the virtual keyboard.
+ */
+static int open_output()
+{
+    char output_path[64];
+    long long deadline = now() + STARTUP_TIMEOUT * 1000000LL;
+    int output = -1;
+    while (now() < deadline)
+    {
+        int status;
+        if (waitpid(daemon_pid, &status, WNOHANG) == daemon_pid)
+        {
+            daemon_pid = -1;
+            fprintf(stderr, "error: the daemon exited\n");
+            break;
+        }
+        if (output < 0)
+        {
+            if (find_event_path(OUTPUT_NAME, output_path, sizeof(output_path)) == EXIT_SUCCESS)
+            {
+                output = open(output_path, O_RDONLY | O_NONBLOCK);
+            }
+            usleep(10000);
+            continue;
+        }
+        write_key(PROBE_KEY, 1);
+        write_key(PROBE_KEY, 0);
+        struct pollfd descriptor = { output, POLLIN, 0 };
+        while (poll(&descriptor, 1, 50) > 0)
+        {
+            struct input_event events[64];
+            ssize_t result = read(output, events, sizeof(events));
+            for (int i = 0; i < result / (ssize_t)sizeof(struct input_event); i++)
+            {
+                if (events[i].type == EV_KEY && events[i].code == PROBE_KEY && events[i].value == 0)
+                {
+                    int clock = CLOCK_MONOTONIC;
+                    if (ioctl(output, EVIOCSCLOCKID, &clock) < 0)
+                    {
+                        fprintf(stderr, "error: failed to set the output clock: %s\n", strerror(errno));
+                        close(output);
+                        return -1;
+                    }
+                    return output;
+                }
+            }
+        }
+    }
+    fprintf(stderr, "error: the daemon did not capture the source keyboard\n");
+    if (output >= 0)
+    {
+        close(output);
+    }
+    return -1;
+}
+
+/*
+ * Injects the keystrokes of a run at its rate.
+ */
+static void* inject(void* argument)
+{
+    struct run* run = argument;
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    long long interval = run->rate > 0 ? 1000000000LL / run->rate : 0;
+    for (int i = 0; i < run->length; i++)
+    {
+        if (interval > 0)
+        {
+            next.tv_nsec += interval;
+            while (next.tv_nsec >= 1000000000L)
+            {
+                next.tv_nsec -= 1000000000L;
+                next.tv_sec++;
+            }
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        }
+        // The keystroke is counted before it is written, so its output is never ahead of the count
+        run->injected[i] = now();
+        __atomic_store_n(&run->count, i + 1, __ATOMIC_RELEASE);
+        write_key(run->keystrokes[i].code, run->keystrokes[i].value);
+    }
+    return NULL;
+}
+
+/*
+ * Compares latencies for sorting.
+ */
+static int compare_latencies(const void* a, const void* b)
+{
+    long long x = *(const long long*)a, y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Returns a percentile of sorted latencies in microseconds.
+ */
+static double percentile(const long long* latencies, int count, double fraction)
+{
+    int index = (int)(fraction * (count - 1) + 0.5);
+    return latencies[index] / 1000.0;
+}
+
+/*
+ * Runs a script at a rate, reads the output and prints the latency distribution.
+ * The measured keystrokes are matched in order with the key events of the output.
+ */
+static int measure(int output, const struct script* script, int rate, int length)
+{
+    // Whole repetitions of the script, so every run ends with the keys released
+    struct run run = { script, rate, (length + script->length - 1) / script->length * script->length, NULL, NULL, 0 };
+    run.keystrokes = malloc(run.length * sizeof(struct keystroke));
+    run.injected = calloc(run.length, sizeof(long long));
+    long long* latencies = malloc(run.length * sizeof(long long));
+    if (!run.keystrokes || !run.injected || !latencies)
+    {
+        fprintf(stderr, "error: could not allocate the run\n");
+        free(run.keystrokes);
+        free(run.injected);
+        free(latencies);
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < run.length; i++)
+    {
+        run.keystrokes[i] = script->keystrokes[i % script->length];
+    }
+
+    // Discard the output of previous runs
+    struct input_event events[64];
+    while (read(output, events, sizeof(events)) > 0)
+    {
+    }
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, inject, &run) != 0)
+    {
+        fprintf(stderr, "error: could not start the injecting thread\n");
+        return EXIT_FAILURE;
+    }
+    int expected = 0;
+    int received = 0;
+    int measured = 0;
+    int unexpected = 0;
+    int dropped = 0;
+    long long first = 0;
+    long long last = 0;
+    long long drain = 0;
+    while (1)
+    {
+        // Skip the keystrokes that send nothing
+        while (expected < __atomic_load_n(&run.count, __ATOMIC_ACQUIRE) && run.keystrokes[expected].output == 0)
+        {
+            expected++;
+        }
+        if (expected == run.length)
+        {
+            break;
+        }
+        if (__atomic_load_n(&run.count, __ATOMIC_ACQUIRE) == run.length)
+        {
+            if (drain == 0)
+            {
+                drain = now() + DRAIN_TIMEOUT * 1000000LL;
+            }
+            else if (now() > drain)
+            {
+                break;
+            }
+        }
+        struct pollfd descriptor = { output, POLLIN, 0 };
+        if (poll(&descriptor, 1, 10) <= 0)
+        {
+            continue;
+        }
+        ssize_t result = read(output, events, sizeof(events));
+        for (int i = 0; i < result / (ssize_t)sizeof(struct input_event); i++)
+        {
+            const struct input_event* event = &events[i];
+            if (event->type == EV_SYN && event->code == SYN_DROPPED)
+            {
+                dropped++;
+            }
+            if (event->type != EV_KEY)
+            {
+                continue;
+            }
+            while (expected < __atomic_load_n(&run.count, __ATOMIC_ACQUIRE) && run.keystrokes[expected].output == 0)
+            {
+                expected++;
+            }
+            if (expected >= __atomic_load_n(&run.count, __ATOMIC_ACQUIRE)
+                || event->code != run.keystrokes[expected].output || event->value != run.keystrokes[expected].value)
+            {
+                unexpected++;
+                continue;
+            }
+            long long time = event->input_event_sec * 1000000000LL + event->input_event_usec * 1000LL;
+            long long injected = run.injected[expected];
+            if (first == 0)
+            {
+                first = injected;
+            }
+            last = time;
+            received++;
+            if (run.keystrokes[expected].measured)
+            {
+                latencies[measured++] = time - injected;
+            }
+            expected++;
+        }
+    }
+    pthread_join(thread, NULL);
+
+    int total = 0;
+    for (int i = 0; i < run.length; i++)
+    {
+        total += run.keystrokes[i].output != 0;
+    }
+    // The throughput counts every output key event, measured or not
+    char rate_name[16];
+    if (rate > 0)
+    {
+        snprintf(rate_name, sizeof(rate_name), "%i/s", rate);
+    }
+    else
+    {
+        strcpy(rate_name, "max");
+    }
+    if (measured == 0)
+    {
+        printf("%-18s %8s %8i events, no output\n", script->name, rate_name, total);
+    }
+    else
+    {
+        qsort(latencies, measured, sizeof(long long), compare_latencies);
+        double throughput = last > first ? received * 1e9 / (last - first) : 0;
+        printf("%-18s %8s %8i events %8.0f events/s %8.1f p50 %8.1f p90 %8.1f p99 %8.1f p99.9 %8.1f max us %6i lost %4i unexpected %4i dropped\n",
+            script->name, rate_name, total, throughput,
+            percentile(latencies, measured, 0.5), percentile(latencies, measured, 0.9),
+            percentile(latencies, measured, 0.99), percentile(latencies, measured, 0.999),
+            latencies[measured - 1] / 1000.0, total - received, unexpected, dropped);
+    }
+    free(run.keystrokes);
+    free(run.injected);
+    free(latencies);
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Stops the daemon, removes the source keyboard and the configuration.
+ */
+static void clean_up()
+{
+    if (daemon_pid > 0)
+    {
+        kill(daemon_pid, SIGTERM);
+        waitpid(daemon_pid, NULL, 0);
+    }
+    if (source_descriptor >= 0)
+    {
+        ioctl(source_descriptor, UI_DEV_DESTROY);
+        close(source_descriptor);
+    }
+    if (home[0] != '\0')
+    {
+        remove_configuration();
+    }
+}
+
+/*
+ * Main method.
+ */
+int main(int argc, char* argv[])
+{
+    const char* daemon = argc > 1 ? argv[1] : "./out/touchcursor";
+    int length = argc > 2 ? atoi(argv[2]) : 2000;
+    if (length <= 0)
+    {
+        fprintf(stderr, "error: invalid number of events: %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    int output = -1;
+    if (create_source() != EXIT_SUCCESS
+        || write_configuration() != EXIT_SUCCESS
+        || start_daemon(daemon) != EXIT_SUCCESS
+        || (output = open_output()) < 0)
+    {
+        clean_up();
+        return EXIT_FAILURE;
+    }
+    int result = EXIT_SUCCESS;
+    for (size_t i = 0; i < sizeof(scripts) / sizeof(scripts[0]) && result == EXIT_SUCCESS; i++)
+    {
+        for (size_t j = 0; j < sizeof(rates) / sizeof(rates[0]) && result == EXIT_SUCCESS; j++)
+        {
+            result = measure(output, &scripts[i], rates[j], length);
+        }
+    }
+    close(output);
+    clean_up();
+    return result;
+}
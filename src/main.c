@@ -1,169 +1,1011 @@
 #define _GNU_SOURCE
 #include <errno.h>
-#include <limits.h>
+#include <fcntl.h>
 #include <linux/input.h>
-#include <pthread.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/inotify.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <sys/types.h>
 #include <unistd.h>
 
 #include "binding.h"
 #include "buffers.h"
+#include "clock.h"
 #include "config.h"
+#include "control.h"
 #include "emit.h"
+#include "keys.h"
 #include "mapper.h"
+#include "metrics.h"
+#include "probes.h"
+#include "recorder.h"
+#include "status.h"
+#include "timer.h"
+#include "watch.h"
 
-volatile sig_atomic_t should_reload = 0;
-volatile sig_atomic_t should_exit = 0;
-static int inotify_descriptor;
-static int watch_descriptor;
-static pthread_t main_thread_identifier;
-static pthread_t watch_thread_identifier;
+// The event sources of the event loop, in the order they are handled
+enum event_sources
+{
+    source_signal,
+    source_input,
+    source_timer,
+    source_watch,
+    source_metrics,
+    source_control,
+    source_control_client,
+    source_count
+};
+
+static int should_reload = 0;
+static int should_exit = 0;
+static int epoll_descriptor = -1;
+static int signal_descriptor = -1;
+static int timer_descriptor = -1;
+static uint64_t timer_armed = 0;
+static int paused = 0;
+
+/**
+ * The mapping state of an input device, indexed like input_devices.
+ * Devices with the same profile share its compiled keymap, only the engine
+ * state is kept for each device.
+ * */
+struct device_state
+{
+    struct tc_engine engine;
+    // Set once the device is grabbed and added to the event loop
+    int registered;
+    // The keys held down on the device
+    unsigned char keystate[KEY_CNT];
+    int keys_down;
+};
+static struct device_state devices[MAX_INPUT_DEVICES];
+static struct flight_recorder recorder;
+
+// The minimum time between two dumps of the flight recorder for anomalies, in seconds
+#define ANOMALY_DUMP_INTERVAL 10
+static uint64_t last_anomaly_dump = 0;
+
+// The status page, NULL if it could not be created, and the process id published on it
+static struct tc_status* status_page = NULL;
+static uint32_t status_pid = 0;
+
+static void on_grab_timer(struct timer* timer);
+static void on_reload_timer(struct timer* timer);
+static void on_log_timer(struct timer* timer);
+static struct timer grab_timer = { .callback = on_grab_timer };
+static struct timer reload_timer = { .callback = on_reload_timer };
+static struct timer log_timer = { .callback = on_log_timer };
 
 /**
- * Handles signal events.
+ * Adds a file descriptor to the event loop.
+ * Input devices pass their index in the high 16 bits of the source.
  * */
-static void on_signal(int signal)
+static int add_event_source(int descriptor, uint32_t source)
 {
-    if (signal == SIGHUP)
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u32 = source;
+    if (epoll_ctl(epoll_descriptor, EPOLL_CTL_ADD, descriptor, &event) < 0)
     {
-        should_reload = 1;
+        error("error: failed to add an event source: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Creates the event loop and the signal and timer event sources.
+ *
+ * @remarks
+ * Signals are blocked and delivered through a signalfd, so the daemon runs
+ * on a single thread without asynchronous signal handlers.
+ * All the timers of the daemon run on one timer wheel behind one timerfd.
+ * */
+static int create_event_loop()
+{
+    epoll_descriptor = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_descriptor < 0)
+    {
+        error("error: failed to create the event loop: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGHUP);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGUSR1);
+    if (sigprocmask(SIG_BLOCK, &signals, NULL) < 0)
+    {
+        error("error: failed to block signals: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    signal_descriptor = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signal_descriptor < 0)
+    {
+        error("error: failed to create the signal descriptor: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    timer_descriptor = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_descriptor < 0)
+    {
+        error("error: failed to create the timer descriptor: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    timer_wheel_init(&timers, current_time());
+    if (add_event_source(signal_descriptor, source_signal) != EXIT_SUCCESS
+        || add_event_source(timer_descriptor, source_timer) != EXIT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Releases the event loop descriptors.
+ * */
+static void release_event_loop()
+{
+    if (timer_descriptor >= 0) close(timer_descriptor);
+    if (signal_descriptor >= 0) close(signal_descriptor);
+    if (epoll_descriptor >= 0) close(epoll_descriptor);
+}
+
+/**
+ * Arms the timer descriptor for the next timer of the wheel, or disarms it if no timer is running.
+ * The descriptor is only updated when the next expiry changes, so the daemon
+ * does not wake up while idle.
+ * */
+static void arm_timer()
+{
+    uint64_t next = timer_next(&timers);
+    if (next == timer_armed)
+    {
+        return;
+    }
+    struct itimerspec time;
+    memset(&time, 0, sizeof(time));
+    if (next != 0)
+    {
+        time.it_value.tv_sec = next / 1000000;
+        time.it_value.tv_nsec = (next % 1000000) * 1000;
+    }
+    if (timerfd_settime(timer_descriptor, TFD_TIMER_ABSTIME, &time, NULL) < 0)
+    {
+        error("error: failed to arm the timer: %s\n", strerror(errno));
+        return;
+    }
+    timer_armed = next;
+}
+
+/**
+ * Handles the timer expiration, running the timers that are due.
+ * */
+static void read_timer()
+{
+    uint64_t expirations;
+    read(timer_descriptor, &expirations, sizeof(expirations));
+    timer_armed = 0;
+    recorder.now = current_time();
+    timer_advance(&timers, recorder.now);
+}
+
+/**
+ * Sends the output of the engine to the virtual output device.
+ * */
+static void send_output(void* context, const struct input_event* events, int count)
+{
+    queue_events(events, count);
+}
+
+/**
+ * Marks the flight recorder and writes it to the trace file.
+ * Dumps for anomalies are limited to one every ANOMALY_DUMP_INTERVAL seconds.
+ *
+ * @remarks
+ * The trace is written to $XDG_RUNTIME_DIR/touchcursor-trace.json, or
+ * /run/user/<uid>/touchcursor-trace.json, with the permissions of the real user
+ * since the daemon may run set-user-ID root. The previous trace is removed and
+ * the file is created anew, never through a link.
+ * The trace is written on the event loop, a dump takes a few milliseconds.
+ * */
+static void dump_recorder(enum record_marks reason, int code)
+{
+    record_event(&recorder, record_mark, reason, code);
+    if (reason != mark_dump)
+    {
+        if (last_anomaly_dump != 0 && recorder.now < last_anomaly_dump + ANOMALY_DUMP_INTERVAL * 1000000ULL)
+        {
+            return;
+        }
+        last_anomaly_dump = recorder.now;
+    }
+    char path[256];
+    const char* directory = getenv("XDG_RUNTIME_DIR");
+    int length = directory != NULL && directory[0] == '/'
+        ? snprintf(path, sizeof(path), "%s/touchcursor-trace.json", directory)
+        : snprintf(path, sizeof(path), "/run/user/%u/touchcursor-trace.json", (unsigned int)getuid());
+    if (length < 0 || length >= (int)sizeof(path))
+    {
+        error("error: the trace path is too long\n");
+        return;
+    }
+    uid_t effective_user = geteuid();
+    if (seteuid(getuid()) < 0)
+    {
+        error("error: failed to drop privileges for the trace: %s\n", strerror(errno));
+        return;
     }
-    else if (signal == SIGINT || signal == SIGTERM)
+    unlink(path);
+    int descriptor = open(path, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0600);
+    FILE* file = descriptor >= 0 ? fdopen(descriptor, "w") : NULL;
+    if (file == NULL && descriptor >= 0)
     {
-        should_exit = 1;
+        close(descriptor);
     }
+    int result = file != NULL ? write_trace(&recorder, file) : EXIT_FAILURE;
+    if (file != NULL && fclose(file) != 0)
+    {
+        result = EXIT_FAILURE;
+    }
+    if (seteuid(effective_user) < 0)
+    {
+        error("error: failed to restore privileges after the trace: %s\n", strerror(errno));
+        return;
+    }
+    if (result != EXIT_SUCCESS)
+    {
+        error("error: failed to write the trace %s\n", path);
+        return;
+    }
+    log("info: wrote the trace %s\n", path);
 }
 
 /**
- * Attaches signal event handlers.
+ * Checks for output keys left down by the engine of a device once every key of
+ * the device is released, and dumps the flight recorder if one is stuck.
  * */
-static int attach_signal_handlers()
+static void check_stuck_keys(const struct tc_engine* engine)
 {
-    stack_t signal_stack;
-    if ((signal_stack.ss_sp = malloc(SIGSTKSZ)) == NULL)
+    if (engine->pendingLength != 0 || engine->tapHoldLength != 0)
     {
-        error("error: unable to allocate signal stack: %s\n", strerror(errno));
+        return;
+    }
+    for (int code = 0; code < KEY_CNT; code++)
+    {
+        if (engine->keystate[code])
+        {
+            warn("warning: output key %i is down with no input key down\n", code);
+            dump_recorder(mark_stuck_key, code);
+            return;
+        }
+    }
+}
+
+/**
+ * Creates the status page, with the permissions of the real user.
+ * The daemon runs without a status page if it cannot be created.
+ * */
+static void create_status()
+{
+    char path[256];
+    if (status_page_path(path, sizeof(path)) != EXIT_SUCCESS)
+    {
+        return;
+    }
+    uid_t effective_user = geteuid();
+    if (seteuid(getuid()) < 0)
+    {
+        error("error: failed to drop privileges for the status page: %s\n", strerror(errno));
+        return;
+    }
+    status_page = create_status_page(path);
+    if (seteuid(effective_user) < 0)
+    {
+        error("error: failed to restore privileges after the status page: %s\n", strerror(errno));
+        if (status_page != NULL)
+        {
+            close_status_page(status_page);
+            status_page = NULL;
+        }
+        return;
+    }
+    if (status_page == NULL)
+    {
+        warn("warning: could not create the status page %s\n", path);
+        return;
+    }
+    status_pid = getpid();
+    log("info: publishing the status on %s\n", path);
+}
+
+/**
+ * Sums the counters of the engines, including the engines of devices that were removed.
+ * */
+static struct tc_engine_metrics sum_engine_metrics()
+{
+    struct tc_engine_metrics sum;
+    memset(&sum, 0, sizeof(sum));
+    for (int i = 0; i < MAX_INPUT_DEVICES; i++)
+    {
+        sum.mapped += devices[i].engine.metrics.mapped;
+        sum.passthrough += devices[i].engine.metrics.passthrough;
+        sum.hyper_activations += devices[i].engine.metrics.hyper_activations;
+        sum.queue_overflows += devices[i].engine.metrics.queue_overflows;
+    }
+    return sum;
+}
+
+/**
+ * Publishes the state and the counters on the status page.
+ * Readers never block the daemon, publishing is a copy under the seqlock of the page.
+ * A wakeup that changed nothing but the time leaves the page untouched.
+ * */
+static void publish_status()
+{
+    if (status_page == NULL)
+    {
+        return;
+    }
+    // The state is the state of the first device
+    const struct tc_engine* engine = &devices[0].engine;
+    const int profile = input_device_count > 0 ? input_devices[0].profile : 0;
+    const struct tc_engine_metrics engine_metrics = sum_engine_metrics();
+    struct tc_status values = {
+        .pid = status_pid,
+        .state = engine->state,
+        .hyper_key = engine->keymap->hyperKey,
+        .held_keys = lengthOfQueue(&engine->queue),
+        .updated = recorder.now,
+        .events_read = metrics.events_read,
+        .events_emitted = metrics.events_emitted,
+        .mapped = engine_metrics.mapped,
+        .passthrough = engine_metrics.passthrough,
+        .hyper_activations = engine_metrics.hyper_activations,
+        .queue_overflows = engine_metrics.queue_overflows,
+        .reloads = metrics.reloads,
+        .paused = paused,
+        .profile = profile
+    };
+    strcpy(values.profile_name, profiles[profile].name);
+    update_status(status_page, &values);
+}
+
+/**
+ * Reads pending signals.
+ * */
+static void read_signals()
+{
+    struct signalfd_siginfo info;
+    while (read(signal_descriptor, &info, sizeof(info)) == sizeof(info))
+    {
+        if (info.ssi_signo == SIGHUP)
+        {
+            should_reload = 1;
+        }
+        else if (info.ssi_signo == SIGINT || info.ssi_signo == SIGTERM)
+        {
+            should_exit = 1;
+        }
+        else if (info.ssi_signo == SIGUSR1)
+        {
+            recorder.now = current_time();
+            dump_recorder(mark_dump, 0);
+        }
+    }
+}
+
+/**
+ * Opens the input devices and starts the grab timer.
+ * The devices are added to the event loop once they are grabbed.
+ *
+ * @return int EXIT_SUCCESS if at least one device was opened.
+ * */
+static int start_input()
+{
+    if (input_device_count == 0)
+    {
+        error("error: no input device was configured (or the event path was not found).\n");
         return EXIT_FAILURE;
     }
-    signal_stack.ss_size = SIGSTKSZ;
-    signal_stack.ss_flags = 0;
-    if (sigaltstack(&signal_stack, (stack_t*)0) < 0)
+    int bound = 0;
+    for (int i = 0; i < input_device_count; i++)
+    {
+        if (bind_input(&input_devices[i]) == EXIT_SUCCESS)
+        {
+            bound++;
+        }
+    }
+    if (bound == 0)
     {
-        error("error: sigaltstack: %s\n", strerror(errno));
         return EXIT_FAILURE;
     }
-    struct sigaction signal_action;
-    signal_action.sa_flags = SA_ONSTACK;
-    sigemptyset(&signal_action.sa_mask);
-    signal_action.sa_handler = on_signal;
-    sigaction(SIGHUP, &signal_action, NULL);
-    sigaction(SIGINT, &signal_action, NULL);
-    sigaction(SIGTERM, &signal_action, NULL);
+    timer_start(&timers, &grab_timer, current_time() + INPUT_GRAB_DELAY * 1000ULL);
     return EXIT_SUCCESS;
 }
 
 /**
- * Reads inotify watch events.
+ * Removes the input devices from the event loop and releases them.
+ * */
+static void stop_input()
+{
+    timer_stop(&timers, &grab_timer);
+    for (int i = 0; i < input_device_count; i++)
+    {
+        if (devices[i].registered)
+        {
+            epoll_ctl(epoll_descriptor, EPOLL_CTL_DEL, input_devices[i].file_descriptor, NULL);
+            devices[i].registered = 0;
+        }
+        release_input(&input_devices[i]);
+    }
+}
+
+/**
+ * Handles the end of the grab delay.
  * */
-static void* read_watch_events(void *)
+static void on_grab_timer(struct timer* timer)
 {
-    struct inotify_event event;
-    while (1)
+    for (int i = 0; i < input_device_count; i++)
     {
-        if (should_exit)
+        struct input_device* device = &input_devices[i];
+        if (device->file_descriptor < 0 || devices[i].registered)
         {
-            break;
+            continue;
         }
-        ssize_t result = read(inotify_descriptor, &event, sizeof(event));
-        if (result == (ssize_t)-1)
+        if (grab_input(device) != EXIT_SUCCESS)
         {
-            if (errno == EINTR)
+            error("error: could not capture the input device %s\n", device->event_path);
+            continue;
+        }
+        if (add_event_source(device->file_descriptor, source_input | i << 16) == EXIT_SUCCESS)
+        {
+            devices[i].registered = 1;
+        }
+    }
+}
+
+/**
+ * Points the engine of each device at the keymap of its profile.
+ * */
+static void apply_profiles()
+{
+    for (int i = 0; i < MAX_INPUT_DEVICES; i++)
+    {
+        devices[i].engine.keymap = i < input_device_count ? profiles[input_devices[i].profile].keymap : &keymap;
+    }
+}
+
+/**
+ * Pauses or resumes remapping.
+ * While paused the input frames are forwarded as they are read, in bulk, without
+ * going through the engine.
+ * The output keys are released and the mapper is reset both ways, so no
+ * key pressed before the switch is left down after it.
+ * */
+static void set_paused(int pause)
+{
+    if (pause == paused)
+    {
+        return;
+    }
+    release_output_keys();
+    for (int i = 0; i < MAX_INPUT_DEVICES; i++)
+    {
+        resetMapper(&devices[i].engine);
+    }
+    paused = pause;
+    log("info: remapping %s\n", paused ? "paused" : "resumed");
+}
+
+/**
+ * Switches a device, and the devices of its group, to a profile.
+ * The profiles are compiled when the configuration is read, switching swaps
+ * the keymap of the engine of the group between two events. The output keys
+ * of the engine are released through its output in one frame, and the keys
+ * still held on the group are ignored until they are pressed again.
+ * */
+static void switch_profile(int index, int profile)
+{
+    struct input_device* device = &input_devices[index];
+    struct tc_engine* engine = &devices[index].engine;
+    if (device->profile == profile)
+    {
+        return;
+    }
+    unsigned char held[KEY_CNT] = { 0 };
+    for (int i = 0; i < input_device_count; i++)
+    {
+        if (input_devices[i].group == index)
+        {
+            for (int code = 0; code < KEY_CNT; code++)
             {
-                continue;
+                held[code] |= devices[i].keystate[code];
             }
-            else
+        }
+    }
+    releaseMapper(engine, held);
+    engine->keymap = profiles[profile].keymap;
+    device->profile = profile;
+    log("info: switched %s to profile %s\n", device->event_path, profiles[profile].name);
+}
+
+/**
+ * Checks if a key press on a device completes a key combination.
+ * */
+static int completes_combination(const struct device_state* state, const int* keys, int length, int code)
+{
+    int pressed = 0;
+    for (int i = 0; i < length; i++)
+    {
+        if (state->keystate[keys[i]] == 0)
+        {
+            return 0;
+        }
+        pressed |= keys[i] == code;
+    }
+    return pressed;
+}
+
+/**
+ * Runs the configured key combinations a key press on a device completes, bypass first.
+ * Profile combinations switch the group of the device they are pressed on.
+ * */
+static void check_combinations(int index, int code)
+{
+    const struct device_state* state = &devices[index];
+    if (completes_combination(state, bypass_keys, bypass_keys_length, code))
+    {
+        set_paused(!paused);
+    }
+    for (int i = 0; i < profile_count; i++)
+    {
+        if (completes_combination(state, profiles[i].keys, profiles[i].keys_length, code))
+        {
+            switch_profile(input_devices[index].group, i);
+        }
+    }
+}
+
+/**
+ * Reads the available events of an input device.
+ *
+ * @remarks
+ * read: Read NBYTES into BUF from FD. Return the number read, -1 for errors or 0 for EOF.
+ * EOF doesn't make sense here. Partial events will be ignored.
+ * https://docs.kernel.org/input/uinput.html
+ * https://stackoverflow.com/questions/20943322/accessing-keys-from-linux-input-device
+ *
+ * @return int The number of events read, or -1 if the device failed.
+ * */
+static int read_device_events(int index, struct input_event* events, int length)
+{
+    ssize_t result = read(input_devices[index].file_descriptor, events, length * sizeof(struct input_event));
+    if (result == (ssize_t)-1)
+    {
+        if (errno == EINTR || errno == EAGAIN)
+        {
+            return 0;
+        }
+        error("error: unable to read input event: %s\n", strerror(errno));
+        return -1;
+    }
+    if (result == (ssize_t)0)
+    {
+        error("error: received EOF while reading input events\n");
+        return -1;
+    }
+    if (result % sizeof(struct input_event) != 0)
+    {
+        metrics.partial_reads++;
+        warn("warning: partial input event received\n");
+    }
+    int count = result / sizeof(struct input_event);
+    metrics.events_read += count;
+    PROBE1(input_read, count);
+    return count;
+}
+
+/**
+ * Processes an input event of a device with the engine of its group.
+ *
+ * @remarks
+ * The event is processed at its timestamp: the timers due before it run
+ * first, and the engine decides tap/hold keys and combos by the timestamp.
+ * The timestamps are on the monotonic clock, a timestamp later than now (the
+ * clock of the device could not be set) is taken as now.
+ *
+ * @return int 1 if the event released a key of the device.
+ * */
+static int process_input_event(int index, struct input_event* event, uint64_t now)
+{
+    struct device_state* state = &devices[index];
+    struct tc_engine* engine = &devices[input_devices[index].group].engine;
+    int released = 0;
+    uint64_t time = event->input_event_sec * 1000000ULL + event->input_event_usec;
+    if (time > now)
+    {
+        time = now;
+    }
+    timer_advance(&timers, time);
+    recorder.now = time;
+    PROBE3(input_event, event->type, event->code, event->value);
+    // We only want to manipulate key presses
+    if (event->type == EV_KEY
+        && (event->value == 0 || event->value == 1 || event->value == 2))
+    {
+        if (event->code < KEY_CNT && (event->value == 0) == (state->keystate[event->code] != 0))
+        {
+            state->keystate[event->code] = event->value != 0;
+            state->keys_down += event->value != 0 ? 1 : -1;
+            released = event->value == 0;
+        }
+        if (paused)
+        {
+            queue_events(event, 1);
+        }
+        else
+        {
+            processKey(engine, event->type, event->code, event->value, time);
+        }
+        if (event->value == 1)
+        {
+            check_combinations(index, event->code);
+        }
+    }
+    else
+    {
+        if (event->type == EV_SYN && event->code == SYN_DROPPED)
+        {
+            warn("warning: input events were dropped\n");
+            dump_recorder(mark_dropped, 0);
+        }
+        // While remapping, the engine ends its own frames
+        if (!paused && event->type == EV_SYN && event->code == SYN_REPORT)
+        {
+            end_frame();
+        }
+        else
+        {
+            queue_events(event, 1);
+        }
+    }
+    return released;
+}
+
+/**
+ * Removes a device that failed, unplugged or unreadable, from the event loop and releases it.
+ * The keys it held are released through the engine of its group, unless
+ * another device of the group holds them too, and the other devices carry on.
+ * */
+static void remove_input_device(int index, uint64_t now)
+{
+    struct device_state* state = &devices[index];
+    const int group = input_devices[index].group;
+    warn("warning: removing the input device %s\n", input_devices[index].event_path);
+    epoll_ctl(epoll_descriptor, EPOLL_CTL_DEL, input_devices[index].file_descriptor, NULL);
+    state->registered = 0;
+    release_input(&input_devices[index]);
+    unsigned char held[KEY_CNT];
+    memcpy(held, state->keystate, sizeof(held));
+    for (int i = group; i < input_device_count; i++)
+    {
+        if (i == index || input_devices[i].group != group || !devices[i].registered)
+        {
+            continue;
+        }
+        for (int code = 0; code < KEY_CNT; code++)
+        {
+            held[code] &= !devices[i].keystate[code];
+        }
+    }
+    if (paused)
+    {
+        for (int code = 0; code < KEY_CNT; code++)
+        {
+            if (held[code])
             {
-                error("error: unable to read inotify event: %s\n", strerror(errno));
-                error("error: file events will no longer be processed\n");
-                break;
+                const struct input_event release = { .type = EV_KEY, .code = code, .value = 0 };
+                queue_events(&release, 1);
             }
         }
-        if (result == (ssize_t)0)
+        end_frame();
+    }
+    else
+    {
+        timer_advance(&timers, now);
+        releaseKeys(&devices[group].engine, held, now);
+    }
+    memset(state->keystate, 0, sizeof(state->keystate));
+    state->keys_down = 0;
+}
+
+/**
+ * Reads and processes the available input events of a group of devices.
+ *
+ * @remarks
+ * The devices of a group share one engine, so a foot pedal may hold the hyper
+ * key of a keyboard. Every device of the group is read when one is ready, and
+ * the events are processed in the order of their timestamps, so a key is
+ * mapped by a hyper key pressed before it on another device even when the
+ * devices report in different frames. Events are never held back waiting for
+ * a device that has not reported, which would add latency.
+ * A device that fails is removed after the events read from the others.
+ *
+ * @return int The devices of the group as a mask.
+ * */
+static int read_input_events(int group)
+{
+    static struct input_event events[MAX_INPUT_DEVICES][MAX_INPUT_EVENTS];
+    int counts[MAX_INPUT_DEVICES] = { 0 };
+    int next[MAX_INPUT_DEVICES] = { 0 };
+    int members = 0;
+    int failed = 0;
+    for (int i = group; i < input_device_count; i++)
+    {
+        if (input_devices[i].group != group || !devices[i].registered)
+        {
+            continue;
+        }
+        members |= 1 << i;
+        counts[i] = read_device_events(i, events[i], MAX_INPUT_EVENTS);
+        if (counts[i] < 0)
         {
-            error("error: received eof while reading inotify events\n");
-            error("error: file events will no longer be processed\n");
-            break;
+            counts[i] = 0;
+            failed |= 1 << i;
         }
-        if (result != sizeof(event))
+    }
+    const uint64_t now = current_time();
+    int released = 0;
+    int earliest;
+    while ((earliest = next_input_device(events, counts, next, group, input_device_count)) >= 0)
+    {
+        released |= process_input_event(earliest, &events[earliest][next[earliest]++], now);
+    }
+    for (int i = group; i < input_device_count; i++)
+    {
+        if (failed & (1 << i))
         {
-            warn("warning: partial inotify event received\n");
-            continue;
+            remove_input_device(i, now);
+            released = 1;
         }
-        if (event.mask & IN_MODIFY)
+    }
+    if (released)
+    {
+        int keys_down = 0;
+        for (int i = group; i < input_device_count; i++)
+        {
+            keys_down += (members & (1 << i)) ? devices[i].keys_down : 0;
+        }
+        if (keys_down == 0)
+        {
+            check_stuck_keys(&devices[group].engine);
+        }
+    }
+    return members;
+}
+
+/**
+ * Handles configuration file changes.
+ * Bursts of changes are coalesced by restarting the quiet period timer.
+ * */
+static void on_watch_events()
+{
+    if (!read_watch_events())
+    {
+        return;
+    }
+    if (timer_running(&reload_timer))
+    {
+        suppressed_reloads++;
+    }
+    timer_start(&timers, &reload_timer, current_time() + reload_quiet_period * 1000ULL);
+}
+
+/**
+ * Handles the end of the reload quiet period.
+ * The reload is skipped if the configuration file content did not change.
+ * */
+static void on_reload_timer(struct timer* timer)
+{
+    uint64_t hash;
+    if (hash_configuration_file(&hash) != EXIT_SUCCESS)
+    {
+        error("error: could not read the configuration file, keeping the current configuration\n");
+        suppressed_reloads++;
+        return;
+    }
+    if (hash == configuration_hash)
+    {
+        suppressed_reloads++;
+        log("info: configuration unchanged, skipping reload (%u reloads suppressed)\n", suppressed_reloads);
+        return;
+    }
+    should_reload = 1;
+}
+
+/**
+ * Serves the metrics on the configured socket, rebinding it if the path changed.
+ * A socket that cannot be bound is retried on the next reload.
+ * */
+static void update_metrics_socket()
+{
+    if (strcmp(metrics_socket_path, metrics_bound_path) == 0)
+    {
+        return;
+    }
+    release_metrics_socket();
+    if (metrics_socket_path[0] == '\0')
+    {
+        return;
+    }
+    if (bind_metrics_socket(metrics_socket_path) != EXIT_SUCCESS
+        || add_event_source(metrics_file_descriptor, source_metrics) != EXIT_SUCCESS)
+    {
+        error("error: could not serve the metrics on %s\n", metrics_socket_path);
+        release_metrics_socket();
+    }
+}
+
+/**
+ * Handles the end of the log retry delay, the held messages are written before the next wait.
+ * */
+static void on_log_timer(struct timer* timer)
+{
+}
+
+/**
+ * Writes the held log messages, retrying later if the output is busy.
+ * */
+static void write_log()
+{
+    if (flush_log() > 0 && !timer_running(&log_timer))
+    {
+        timer_start(&timers, &log_timer, current_time() + LOG_RETRY_DELAY * 1000ULL);
+    }
+}
+
+/**
+ * Runs a command of the control client and replies to it.
+ * Commands run between two batches of input events.
+ * */
+static void run_command(char* command)
+{
+    char* arguments = command;
+    char* name = strsep(&arguments, " ");
+    if (strcmp(name, "pause") == 0)
+    {
+        set_paused(1);
+        reply_control("ok\n");
+    }
+    else if (strcmp(name, "resume") == 0)
+    {
+        set_paused(0);
+        reply_control("ok\n");
+    }
+    else if (strcmp(name, "toggle") == 0)
+    {
+        set_paused(!paused);
+        reply_control("ok %s\n", paused ? "paused" : "resumed");
+    }
+    else if (strcmp(name, "reload") == 0)
+    {
+        should_reload = 1;
+        reply_control("ok\n");
+    }
+    else if (strcmp(name, "profile") == 0)
+    {
+        // Every group is switched
+        int profile = arguments != NULL ? find_profile(arguments) : -1;
+        if (profile < 0)
         {
-            pthread_kill(main_thread_identifier, SIGHUP);
+            reply_control("error: unknown profile: %s\n", arguments != NULL ? arguments : "");
         }
-        if (event.mask & IN_DELETE_SELF)
+        else
         {
-            inotify_rm_watch(inotify_descriptor, watch_descriptor);
-            watch_descriptor = inotify_add_watch(inotify_descriptor, configuration_file_path, IN_MODIFY | IN_DELETE_SELF);
-            if (watch_descriptor < 0)
+            for (int i = 0; i < input_device_count; i++)
             {
-                error("error: failed to create the configuration file watch: %s\n", strerror(errno));
-                break;
+                if (input_devices[i].group == i)
+                {
+                    switch_profile(i, profile);
+                }
             }
-            pthread_kill(main_thread_identifier, SIGHUP);
+            reply_control("ok\n");
         }
     }
-    pthread_exit(NULL);
-    return EXIT_SUCCESS;
+    else if (strcmp(name, "profiles") == 0)
+    {
+        char list[MAX_PROFILES * MAX_PROFILE_NAME + 1] = { '\0' };
+        for (int i = 0; i < profile_count; i++)
+        {
+            strcat(list, " ");
+            strcat(list, profiles[i].name);
+        }
+        reply_control("profiles:%s\n", list);
+    }
+    else if (strcmp(name, "state") == 0)
+    {
+        // One line for each device
+        static const char* state_names[] = { "idle", "hyper", "delay", "map" };
+        int count = input_device_count > 0 ? input_device_count : 1;
+        for (int i = 0; i < count; i++)
+        {
+            const int group = i < input_device_count ? input_devices[i].group : 0;
+            const struct tc_engine* engine = &devices[group].engine;
+            const char* hyper = convertKeyCodeToString(engine->keymap->hyperKey);
+            reply_control("paused=%i state=%s hyper_key=%s held_keys=%i profile=%s device=%s\n",
+                paused, state_names[engine->state], hyper != NULL ? hyper : "none", lengthOfQueue(&engine->queue),
+                profiles[i < input_device_count ? input_devices[group].profile : 0].name,
+                i < input_device_count ? input_devices[i].event_path : "none");
+        }
+    }
+    else if (strcmp(name, "trace") == 0)
+    {
+        recorder.now = current_time();
+        dump_recorder(mark_dump, 0);
+        reply_control("ok\n");
+    }
+    else if (strcmp(name, "help") == 0)
+    {
+        reply_control("commands: pause, resume, toggle, reload, profile <name>, profiles, state, trace, help\n");
+    }
+    else if (name[0] != '\0')
+    {
+        reply_control("error: unknown command: %s\n", name);
+    }
 }
 
 /**
- * Starts watching for changes in the configuration file.
+ * Accepts a control client, adding it to the event loop.
  * */
-static int watch_configuration_file()
+static void on_control_connection()
 {
-    inotify_descriptor = inotify_init();
-    if (inotify_descriptor < 0)
+    if (accept_control_client() < 0)
     {
-        error("error: failed to initialize inotify: %s\n", strerror(errno));
-        return EXIT_FAILURE;
+        return;
     }
-    watch_descriptor = inotify_add_watch(inotify_descriptor, configuration_file_path, IN_MODIFY | IN_DELETE_SELF);
-    if (watch_descriptor < 0)
+    if (add_event_source(control_client_descriptor, source_control_client) != EXIT_SUCCESS)
     {
-        error("error: failed to create the configuration file watch: %s\n", strerror(errno));
-        return EXIT_FAILURE;
+        close_control_client();
     }
-    pthread_create(&watch_thread_identifier, NULL, read_watch_events, NULL);
-    return EXIT_SUCCESS;
 }
 
 /**
- * Releases the configuration file watch.
+ * Runs the commands of the control client.
  * */
-static int release_configuration_file_watch()
+static void on_control_commands()
 {
-    if (watch_thread_identifier > 0)
+    int result = read_control_client();
+    char* command;
+    while ((command = next_control_command()) != NULL)
     {
-        pthread_kill(watch_thread_identifier, SIGTERM);
-        pthread_join(watch_thread_identifier, NULL);
+        run_command(command);
     }
-    if (watch_descriptor > 0)
+    if (result != EXIT_SUCCESS)
     {
-        log("info: releasing configuration file watch\n");
-        inotify_rm_watch(inotify_descriptor, watch_descriptor);
+        close_control_client();
     }
-    if (inotify_descriptor > 0)
+}
+
+/**
+ * Creates the control socket and adds it to the event loop.
+ * The daemon runs without a control socket if it cannot be created.
+ * */
+static void create_control()
+{
+    char path[108];
+    if (control_socket_path(path, sizeof(path)) != EXIT_SUCCESS
+        || bind_control_socket(path) != EXIT_SUCCESS
+        || add_event_source(control_file_descriptor, source_control) != EXIT_SUCCESS)
     {
-        close(inotify_descriptor);
+        warn("warning: could not create the control socket\n");
+        release_control_socket();
     }
-    return EXIT_SUCCESS;
 }
 
 /**
@@ -171,19 +1013,87 @@ static int release_configuration_file_watch()
  * */
 static void clean_up()
 {
+    release_control_socket();
+    release_metrics_socket();
     release_configuration_file_watch();
-    release_input();
+    stop_input();
     release_output();
+    release_event_loop();
+    stop_log();
+}
+
+/**
+ * Reloads the configuration and rebinds the input devices.
+ * */
+static int reload()
+{
+    log("info: reloading\n");
+    uint64_t start = monotonic_time();
+    metrics.reloads++;
+    PROBE0(reload_start);
+    release_output_keys();
+    for (int i = 0; i < MAX_INPUT_DEVICES; i++)
+    {
+        resetMapper(&devices[i].engine);
+        memset(devices[i].keystate, 0, sizeof(devices[i].keystate));
+        devices[i].keys_down = 0;
+    }
+    stop_input();
+    // The devices keep their active profile if it is still configured
+    char paths[MAX_INPUT_DEVICES][256];
+    char names[MAX_INPUT_DEVICES][MAX_PROFILE_NAME];
+    int count = input_device_count;
+    for (int i = 0; i < count; i++)
+    {
+        strcpy(paths[i], input_devices[i].event_path);
+        strcpy(names[i], profiles[input_devices[i].profile].name);
+    }
+    if (read_configuration() != EXIT_SUCCESS)
+    {
+        error("error: failed to read the configuration\n");
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < input_device_count; i++)
+    {
+        for (int j = 0; j < count; j++)
+        {
+            int profile = find_profile(names[j]);
+            if (strcmp(paths[j], input_devices[i].event_path) == 0 && profile >= 0)
+            {
+                input_devices[i].profile = profile;
+            }
+        }
+    }
+    apply_profiles();
+    update_configuration_file_watch();
+    PROBE0(reload_parsed);
+    update_metrics_socket();
+    if (start_input() != EXIT_SUCCESS)
+    {
+        error("error: could not capture the keyboard device\n");
+        log("info: you may update the configuration file to have the application attempt discovering the input device again.\n");
+    }
+    uint64_t duration = monotonic_time() - start;
+    metrics.reload_time += duration;
+    PROBE1(reload_done, duration);
+    return EXIT_SUCCESS;
 }
 
 /**
  * Main method.
  *
  * @remarks
- * read: Read NBYTES into BUF from FD. Return the number read, -1 for errors or 0 for EOF.
- * EOF doesn't make sense here. Partial events will be ignored.
- * https://docs.kernel.org/input/uinput.html
- * https://stackoverflow.com/questions/20943322/accessing-keys-from-linux-input-device
+ * The daemon is a single thread waiting on one epoll set for signals, the
+ * timer wheel, the input devices, the configuration file watch, and the
+ * metrics and control sockets.
+ * Each input device is mapped by its own engine, the engines of devices with
+ * the same profile share its keymap.
+ * Ready sources are handled in the order of enum event_sources, and the
+ * timer descriptor is armed for the next timer before each wait. The input
+ * is handled before the timer, so an event stamped before a timer that is
+ * due in the same wakeup is processed before it.
+ * Log messages are held while events are handled and written before each
+ * wait, when the status page is also updated.
  * */
 int main(int argc, char* argv[])
 {
@@ -193,10 +1103,9 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
-    main_thread_identifier = pthread_self();
-    if (attach_signal_handlers() != EXIT_SUCCESS)
+    if (create_event_loop() != EXIT_SUCCESS)
     {
-        error("error: failed to attach signal handlers\n");
+        error("error: failed to create the event loop\n");
         return EXIT_FAILURE;
     }
     if (find_configuration_file() != EXIT_SUCCESS)
@@ -209,14 +1118,23 @@ int main(int argc, char* argv[])
         error("error: failed to read the configuration\n");
         return EXIT_FAILURE;
     }
-    if (watch_configuration_file() != EXIT_SUCCESS)
+    for (int i = 0; i < MAX_INPUT_DEVICES; i++)
+    {
+        initEngine(&devices[i].engine, &keymap, &timers, send_output, NULL);
+        devices[i].engine.recorder = &recorder;
+    }
+    apply_profiles();
+    if (watch_configuration_file() != EXIT_SUCCESS
+        || add_event_source(watch_file_descriptor, source_watch) != EXIT_SUCCESS)
     {
         error("error: failed to watch the configuration file\n");
         return EXIT_FAILURE;
     }
-    if (bind_input() != EXIT_SUCCESS)
+    update_metrics_socket();
+    if (start_input() != EXIT_SUCCESS)
     {
         error("error: could not capture the input device\n");
+        log("info: you may update the configuration file to have the application attempt discovering the input device again.\n");
     }
     if (bind_output() != EXIT_SUCCESS)
     {
@@ -224,76 +1142,81 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
     log("info: running\n");
-    // Read events
-    struct input_event event;
-    ssize_t result;
-    while (1)
+    defer_log();
+    create_status();
+    create_control();
+    struct epoll_event events[source_count + MAX_INPUT_DEVICES];
+    while (!should_exit)
     {
-        if (should_reload)
+        flush_events();
+        publish_status();
+        write_log();
+        arm_timer();
+        int count = epoll_wait(epoll_descriptor, events, source_count + MAX_INPUT_DEVICES, -1);
+        if (count < 0)
         {
-            log("info: reloading\n");
-            release_output_keys();
-            release_input();
-            if (read_configuration() != EXIT_SUCCESS)
-            {
-                error("error: failed to read the configuration\n");
-                clean_up();
-                return EXIT_FAILURE;
-            }
-            if (bind_input() != EXIT_SUCCESS)
+            if (errno == EINTR)
             {
-                error("error: could not capture the keyboard device\n");
+                continue;
             }
-            should_reload = 0;
+            error("error: failed to wait for events: %s\n", strerror(errno));
+            clean_up();
+            return EXIT_FAILURE;
         }
-        if (should_exit)
+        int ready = 0;
+        int ready_inputs = 0;
+        for (int i = 0; i < count; i++)
         {
-            log("info: exiting\n");
-            clean_up();
-            return EXIT_SUCCESS;
+            ready |= 1 << (events[i].data.u32 & 0xffff);
+            if ((events[i].data.u32 & 0xffff) == source_input)
+            {
+                ready_inputs |= 1 << (events[i].data.u32 >> 16);
+            }
         }
-        if (input_event_path[0] == '\0')
+        if (ready & (1 << source_signal))
         {
-            log("info: you may update the configuration file to have the application attempt discovering the input device again.\n");
-            sleep(UINT_MAX); // this can be interrupted
-            continue;
+            read_signals();
         }
-        result = read(input_file_descriptor, &event, sizeof(event));
-        if (result == (ssize_t)-1)
+        for (int i = 0; i < input_device_count; i++)
         {
-            if (errno == EINTR)
+            if (!(ready_inputs & (1 << i)) || !devices[i].registered)
             {
                 continue;
             }
-            else
-            {
-                error("error: unable to read input event: %s\n", strerror(errno));
-                log("info: exiting\n");
-                clean_up();
-                return EXIT_FAILURE;
-            }
+            ready_inputs &= ~read_input_events(input_devices[i].group);
         }
-        if (result == (ssize_t)0)
+        if (ready & (1 << source_timer))
         {
-            error("error: received EOF while reading input events\n");
-            log("info: exiting\n");
-            clean_up();
-            return EXIT_FAILURE;
+            read_timer();
         }
-        if (result != sizeof(event))
+        if (ready & (1 << source_watch))
         {
-            warn("warning: partial input event received\n");
-            continue;
+            on_watch_events();
         }
-        // We only want to manipulate key presses
-        if (event.type == EV_KEY
-            && (event.value == 0 || event.value == 1 || event.value == 2))
+        if (ready & (1 << source_metrics))
         {
-            processKey(event.type, event.code, event.value);
+            const struct tc_engine_metrics engine_metrics = sum_engine_metrics();
+            serve_metrics(&engine_metrics);
         }
-        else
+        if ((ready & (1 << source_control_client)) && control_client_descriptor >= 0)
         {
-            emit(event.type, event.code, event.value);
+            on_control_commands();
+        }
+        if (ready & (1 << source_control))
+        {
+            on_control_connection();
+        }
+        if (should_reload && !should_exit)
+        {
+            should_reload = 0;
+            if (reload() != EXIT_SUCCESS)
+            {
+                clean_up();
+                return EXIT_FAILURE;
+            }
         }
     }
+    log("info: exiting\n");
+    clean_up();
+    return EXIT_SUCCESS;
 }
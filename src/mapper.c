@@ -1,221 +1,871 @@
 #include <linux/input.h>
-#include <linux/uinput.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 
-#include "config.h"
-#include "emit.h"
+#include "clock.h"
 #include "keys.h"
 #include "mapper.h"
-#include "queue.h"
+#include "probes.h"
 
-// The state machine state
-enum states state = idle;
+// The decision for each tap/hold key while it is held
+enum tap_hold_decisions
+{
+    tap_hold_none,
+    tap_hold_tap,
+    tap_hold_hold
+};
 
-// Flag if the hyper key has been emitted
-static int hyperEmitted;
+/**
+ * Sends a batch of events to the output sink of the engine.
+ * The batch must contain its own EV_SYN events to end each frame.
+ * */
+static void send_events(struct tc_engine* engine, const struct input_event* events, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (events[i].type == EV_KEY)
+        {
+            engine->keystate[events[i].code] = events[i].value;
+            if (engine->recorder)
+            {
+                record_event(engine->recorder, record_output, events[i].code, events[i].value);
+            }
+        }
+    }
+    engine->output(engine->context, events, count);
+}
 
 /**
- * Checks if the key is the hyper key.
+ * Sends a key event as one frame.
  * */
-static int isHyper(int code)
+static void send_key(struct tc_engine* engine, int code, int value)
 {
-    return code == hyperKey;
+    struct input_event events[2] = {
+        { .type = EV_KEY, .code = code, .value = value },
+        { .type = EV_SYN, .code = SYN_REPORT }
+    };
+    engine->keystate[code] = value;
+    if (engine->recorder)
+    {
+        record_event(engine->recorder, record_output, code, value);
+    }
+    engine->output(engine->context, events, 2);
 }
 
+static void processKeyEvent(struct tc_engine* engine, int code, int value);
+
 /**
- * Checks if the key has been mapped.
+ * Runs a key event through the hyper key state machine, skipping the combo and tap/hold stages.
  * */
-static int isMapped(int code)
+static void mapKey(struct tc_engine* engine, int code, int value)
 {
-    return keymap[code].sequence[0] != 0;
+    engine->stageBypass = 1;
+    processKeyEvent(engine, code, value);
+    engine->stageBypass = 0;
 }
 
+static void processTapHoldKey(struct tc_engine* engine, int code, int value, uint64_t time);
+
 /**
- * Sends a mapped key sequence.
+ * Decides the first held back tap/hold key, then replays the events held back after it.
  * */
-static void send_mapped_key(int code, int value)
+static void decideTapHold(struct tc_engine* engine, enum tap_hold_decisions decision)
 {
-    struct key_output output = keymap[code];
-    for (int i = 0; i < MAX_SEQUENCE; i++)
+    const struct pending_event key = engine->tapHoldEvents[0];
+    struct pending_event events[MAX_PENDING];
+    int length = engine->tapHoldLength - 1;
+    memcpy(events, &engine->tapHoldEvents[1], length * sizeof(struct pending_event));
+    engine->tapHoldLength = 0;
+    timer_stop(engine->timers, &engine->tapHoldTimer);
+    engine->tapHoldDecisions[key.code] = decision;
+    const struct tap_hold binding = engine->keymap->tap_holds[key.code];
+    mapKey(engine, decision == tap_hold_tap ? binding.tap : binding.hold, 1);
+    for (int i = 0; i < length; i++)
     {
-        if (output.sequence[i] == 0)
+        processTapHoldKey(engine, events[i].code, events[i].value, events[i].time);
+    }
+}
+
+/**
+ * Checks if a key was pressed after the undecided tap/hold key.
+ * */
+static int pressedAfterTapHold(struct tc_engine* engine, int code)
+{
+    for (int i = 1; i < engine->tapHoldLength; i++)
+    {
+        if (engine->tapHoldEvents[i].code == code && engine->tapHoldEvents[i].value == 1)
         {
-            break;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Runs a key event through the tap/hold stage.
+ * A tap/hold key is held back, along with the events that follow it, until
+ * it is released (tap), the tap/hold term ends (hold), or the interrupt
+ * policy decides it. Decisions use the event times, so events replayed
+ * after a decision are decided as if they had not been held back.
+ * */
+static void processTapHoldKey(struct tc_engine* engine, int code, int value, uint64_t time)
+{
+    engine->eventTime = time;
+    if (engine->tapHoldLength > 0)
+    {
+        if (time >= engine->tapHoldDeadline)
+        {
+            // The term ended before the event, its timer has not run yet
+            engine->eventTime = engine->tapHoldDeadline;
+            decideTapHold(engine, tap_hold_hold);
+            processTapHoldKey(engine, code, value, time);
+            return;
+        }
+        const int key = engine->tapHoldEvents[0].code;
+        if (code == key && value == 2)
+        {
+            return;
+        }
+        engine->tapHoldEvents[engine->tapHoldLength++] = (struct pending_event){ time, code, value };
+        if (code == key)
+        {
+            decideTapHold(engine, tap_hold_tap);
+        }
+        else if (engine->keymap->tap_hold_interrupt == interrupt_hold && value == 1)
+        {
+            decideTapHold(engine, tap_hold_hold);
+        }
+        else if (engine->keymap->tap_hold_interrupt == interrupt_permissive && value == 0 && pressedAfterTapHold(engine, code))
+        {
+            decideTapHold(engine, tap_hold_hold);
+        }
+        else if (engine->tapHoldLength == MAX_PENDING)
+        {
+            decideTapHold(engine, tap_hold_hold);
+        }
+        return;
+    }
+    if (engine->keymap->key_actions[code].flags & KEY_ACTION_TAPHOLD)
+    {
+        const enum tap_hold_decisions decision = engine->tapHoldDecisions[code];
+        if (decision == tap_hold_none)
+        {
+            if (value == 1)
+            {
+                engine->tapHoldEvents[0] = (struct pending_event){ time, code, value };
+                engine->tapHoldLength = 1;
+                engine->tapHoldDeadline = time + engine->keymap->tap_hold_term * 1000ULL;
+                timer_start(engine->timers, &engine->tapHoldTimer, engine->tapHoldDeadline);
+                return;
+            }
+        }
+        else
+        {
+            if (value == 0)
+            {
+                engine->tapHoldDecisions[code] = tap_hold_none;
+            }
+            mapKey(engine, decision == tap_hold_tap ? engine->keymap->tap_holds[code].tap : engine->keymap->tap_holds[code].hold, value);
+            return;
+        }
+    }
+    mapKey(engine, code, value);
+}
+
+/**
+ * Adds a key event of a chord modifier to a batch.
+ * Modifiers already held by the user are neither pressed nor released.
+ * */
+static int add_chord_modifier(struct tc_engine* engine, struct input_event* event, int code, int value)
+{
+    if (value == 1)
+    {
+        if (engine->chord_modifiers[code] > 0)
+        {
+            engine->chord_modifiers[code]++;
+            return 0;
+        }
+        if (engine->keystate[code] > 0)
+        {
+            return 0;
+        }
+        engine->chord_modifiers[code] = 1;
+    }
+    else if (value == 0)
+    {
+        if (engine->chord_modifiers[code] == 0 || --engine->chord_modifiers[code] > 0)
+        {
+            return 0;
         }
-        emit(EV_KEY, output.sequence[i], value);
+    }
+    else
+    {
+        return 0;
+    }
+    event->type = EV_KEY;
+    event->code = code;
+    event->value = value;
+    return 1;
+}
+
+/**
+ * Sends a key sequence.
+ * Each key or chord is sent as one frame. Chords press their modifiers
+ * before the key, and release the key before the modifiers.
+ * */
+static void send_sequence(struct tc_engine* engine, const uint16_t* sequence, int length, int value)
+{
+    struct input_event events[64];
+    memset(events, 0, sizeof(events));
+    int count = 0;
+    for (int start = 0; start < length;)
+    {
+        int end = start;
+        while (end < length - 1 && (sequence[end] & SEQUENCE_CHORD)) end++;
+        if (count + (end - start) + 2 > 64)
+        {
+            send_events(engine, events, count);
+            count = 0;
+        }
+        int frame = count;
+        for (int i = 0; i <= end - start; i++)
+        {
+            int index = value == 0 ? end - i : start + i;
+            int code = sequence[index] & ~SEQUENCE_CHORD;
+            if (sequence[index] & SEQUENCE_CHORD)
+            {
+                count += add_chord_modifier(engine, &events[count], code, value);
+            }
+            else
+            {
+                events[count].type = EV_KEY;
+                events[count].code = code;
+                events[count].value = value;
+                count++;
+            }
+        }
+        if (count > frame)
+        {
+            events[count].type = EV_SYN;
+            events[count].code = SYN_REPORT;
+            events[count].value = 0;
+            count++;
+        }
+        start = end + 1;
+    }
+    if (count > 0)
+    {
+        send_events(engine, events, count);
+    }
+}
+
+/**
+ * Finds the key repeat of a mapped key, its delay is 0 if the engine does not repeat it.
+ * */
+static struct key_repeat find_repeat(const struct tc_keymap* keymap, int code)
+{
+    const struct key_repeat repeat = keymap->repeats[code];
+    return repeat.delay != 0 ? repeat : keymap->repeat;
+}
+
+/**
+ * Starts repeating a mapped key, replacing the key that repeated.
+ * Like the input core, the last mapped key pressed repeats.
+ * */
+static void start_repeat(struct tc_engine* engine, int code, struct key_repeat repeat)
+{
+    engine->repeatCode = code;
+    engine->repeatInterval = repeat.interval * 1000ULL;
+    engine->repeatMinimum = (repeat.minimum != 0 && repeat.minimum < repeat.interval ? repeat.minimum : repeat.interval) * 1000ULL;
+    engine->repeatDeadline = engine->eventTime + repeat.delay * 1000ULL;
+    timer_start(engine->timers, &engine->repeatTimer, engine->repeatDeadline);
+}
+
+/**
+ * Stops repeating the mapped key.
+ * */
+static void stop_repeat(struct tc_engine* engine)
+{
+    engine->repeatCode = 0;
+    timer_stop(engine->timers, &engine->repeatTimer);
+}
+
+/**
+ * Sends a mapped key sequence.
+ * The engine repeats mapped keys itself, unless the repeat delay is 0, so
+ * the repeats of the input device are dropped.
+ * */
+static void send_mapped_key(struct tc_engine* engine, int code, int value)
+{
+    const struct key_action action = engine->keymap->key_actions[code];
+    const struct key_repeat repeat = find_repeat(engine->keymap, code);
+    if (value == 2 && repeat.delay != 0)
+    {
+        return;
+    }
+    engine->metrics.mapped++;
+    if (action.length == 1)
+    {
+        send_key(engine, engine->keymap->key_sequences[action.offset], value);
+    }
+    else
+    {
+        send_sequence(engine, &engine->keymap->key_sequences[action.offset], action.length, value);
+    }
+    if (value == 1 && repeat.delay != 0 && action.length != 0)
+    {
+        start_repeat(engine, code, repeat);
     }
     if (value == 0)
     {
-        removeKeyFromQueue(code);
+        removeKeyFromQueue(&engine->queue, code);
+        if (code == engine->repeatCode)
+        {
+            stop_repeat(engine);
+        }
     }
 }
 
 /**
  * Sends all keys in the queue.
  * */
-static void send_mapped_queue(int value)
+static void send_mapped_queue(struct tc_engine* engine, int value)
 {
-    int length = lengthOfQueue();
+    int length = lengthOfQueue(&engine->queue);
     for (int i = 0; i < length; i++)
     {
-        send_mapped_key(dequeue(), value);
+        send_mapped_key(engine, dequeue(&engine->queue), value);
     }
 }
 
 /**
  * Sends a remapped key.
  * */
-static void send_remapped_key(int code, int value)
+static void send_remapped_key(struct tc_engine* engine, int code, int value)
 {
-    if (remap[code] != 0)
-    {
-        code = remap[code];
-    }
-    emit(EV_KEY, code, value);
+    engine->metrics.passthrough++;
+    send_key(engine, engine->keymap->key_actions[code].remap, value);
     if (value == 0)
     {
-        removeKeyFromQueue(code);
+        removeKeyFromQueue(&engine->queue, code);
+        // A key dropped from a full queue repeats but is released as a remapped key
+        if (code == engine->repeatCode)
+        {
+            stop_repeat(engine);
+        }
     }
 }
 
 /**
  * Sends all keys in the queue.
  * */
-static void send_remapped_queue(int value)
+static void send_remapped_queue(struct tc_engine* engine, int value)
 {
-    int length = lengthOfQueue();
+    int length = lengthOfQueue(&engine->queue);
     for (int i = 0; i < length; i++)
     {
-        send_remapped_key(dequeue(), value);
+        send_remapped_key(engine, dequeue(&engine->queue), value);
     }
 }
 
 /**
- * Processes a key input event. Converts and emits events as necessary.
+ * Sends the output of a combo.
+ * */
+static void send_combo(struct tc_engine* engine, int index, int value)
+{
+    const struct combo* combo = &engine->keymap->combos[index];
+    if (combo->length == 1)
+    {
+        send_key(engine, engine->keymap->key_sequences[combo->offset], value);
+    }
+    else
+    {
+        send_sequence(engine, &engine->keymap->key_sequences[combo->offset], combo->length, value);
+    }
+}
+
+/**
+ * Fires a combo for the pending keys.
+ * The keys are consumed, their release events are not sent.
+ * */
+static void fireCombo(struct tc_engine* engine, int index)
+{
+    if (engine->activeCombo >= 0)
+    {
+        send_combo(engine, engine->activeCombo, 0);
+    }
+    send_combo(engine, index, 1);
+    engine->activeCombo = index;
+    engine->consumedKeys |= engine->pendingKeys;
+    engine->pendingLength = 0;
+    engine->pendingKeys = 0;
+    timer_stop(engine->timers, &engine->comboTimer);
+}
+
+/**
+ * Resolves the pending events.
+ * Fires the combo if the pending keys are a combo, otherwise sends the
+ * pending events in their original order.
+ *
+ * @remarks
+ * The events are replayed at once, with their own timestamps: the later
+ * stages decide them as if they had not been held back, only their output
+ * is delayed. Spacing out the output as well would delay the keys typed
+ * after them.
+ * */
+static void resolvePending(struct tc_engine* engine)
+{
+    int index;
+    if (match_combo(engine->keymap, engine->pendingKeys, &index) & COMBO_EXACT)
+    {
+        fireCombo(engine, index);
+        return;
+    }
+    int length = engine->pendingLength;
+    engine->pendingLength = 0;
+    engine->pendingKeys = 0;
+    timer_stop(engine->timers, &engine->comboTimer);
+    for (int i = 0; i < length; i++)
+    {
+        processTapHoldKey(engine, engine->pending[i].code, engine->pending[i].value, engine->pending[i].time);
+    }
+}
+
+/**
+ * Runs a key event through the combo stage.
+ * Combo keys are held back until they match a combo, cannot match one,
+ * or the combo window ends.
  * */
-void processKey(int type, int code, int value)
+static void processComboKey(struct tc_engine* engine, int code, int value, uint64_t time)
 {
-    /* printf("processKey(in): code=%i value=%i state=%i\n", code, value, state); */
-    switch (state)
+    const struct key_action action = engine->keymap->key_actions[code];
+    const uint32_t bit = (action.flags & KEY_ACTION_COMBO) ? 1u << action.combo : 0;
+    if (engine->pendingLength > 0 && time >= engine->comboDeadline)
+    {
+        // The window ended before the event, its timer has not run yet
+        resolvePending(engine);
+    }
+    if (engine->pendingLength > 0)
+    {
+        if (value == 1 && bit && !(bit & engine->pendingKeys) && engine->pendingLength < MAX_PENDING)
+        {
+            int index;
+            int match = match_combo(engine->keymap, engine->pendingKeys | bit, &index);
+            if (match)
+            {
+                engine->pending[engine->pendingLength++] = (struct pending_event){ time, code, value };
+                engine->pendingKeys |= bit;
+                if (match == COMBO_EXACT)
+                {
+                    fireCombo(engine, index);
+                }
+                return;
+            }
+        }
+        resolvePending(engine);
+    }
+    if (bit & engine->consumedKeys)
+    {
+        if (value == 0)
+        {
+            engine->consumedKeys &= ~bit;
+            if (engine->activeCombo >= 0)
+            {
+                send_combo(engine, engine->activeCombo, 0);
+                engine->activeCombo = -1;
+            }
+        }
+        return;
+    }
+    if (value == 1 && bit)
+    {
+        engine->pending[0] = (struct pending_event){ time, code, value };
+        engine->pendingLength = 1;
+        engine->pendingKeys = bit;
+        engine->comboDeadline = time + engine->keymap->combo_window * 1000ULL;
+        timer_start(engine->timers, &engine->comboTimer, engine->comboDeadline);
+        return;
+    }
+    processTapHoldKey(engine, code, value, time);
+}
+
+/**
+ * Processes a key event through the combo and tap/hold stages and the hyper key state machine.
+ * */
+static void processKeyEvent(struct tc_engine* engine, int code, int value)
+{
+    if (engine->recorder && !engine->stageBypass)
+    {
+        record_event(engine->recorder, record_input, code, value);
+    }
+    if ((unsigned int)code >= KEY_CNT)
+    {
+        return;
+    }
+    const struct key_action action = engine->keymap->key_actions[code];
+    // Keys without an action or a remap pass straight through while nothing is held back
+    const int plain = action.flags == 0 && action.remap == code && engine->state == idle
+        && engine->pendingLength == 0 && engine->tapHoldLength == 0;
+    // Keys that are not combo or tap/hold keys skip those stages when nothing is held back
+    if (!plain && ((action.flags & (KEY_ACTION_COMBO | KEY_ACTION_TAPHOLD)) || engine->pendingLength != 0 || engine->tapHoldLength != 0) && !engine->stageBypass)
+    {
+        processComboKey(engine, code, value, engine->eventTime);
+        return;
+    }
+    // A code is pressed by the first key that presses it and released by the last
+    if (value == 1 && engine->presses[code]++ > 0)
+    {
+        return;
+    }
+    if (value == 0 && engine->presses[code] > 0 && --engine->presses[code] > 0)
+    {
+        return;
+    }
+    if (plain)
+    {
+        engine->metrics.passthrough++;
+        send_key(engine, code, value);
+        return;
+    }
+    const int isHyper = action.flags & KEY_ACTION_HYPER;
+    const int isMapped = action.flags & KEY_ACTION_MAPPED;
+    const enum states previous = engine->state;
+    switch (engine->state)
     {
         case idle: // 0
         {
-            if (isHyper(code) && isDown(value))
+            if (isHyper && isDown(value))
             {
-                state = hyper;
-                hyperEmitted = 0;
-                clearQueue();
+                engine->state = hyper;
+                engine->hyperEmitted = 0;
+                engine->metrics.hyper_activations++;
+                clearQueue(&engine->queue);
             }
             else
             {
-                send_remapped_key(code, value);
+                send_remapped_key(engine, code, value);
             }
             break;
         }
         case hyper: // 1
         {
-            if (isHyper(code))
+            if (isHyper)
             {
                 if (!isDown(value))
                 {
-                    state = idle;
-                    if (!hyperEmitted)
+                    engine->state = idle;
+                    if (!engine->hyperEmitted)
                     {
-                        send_remapped_key(code, 1);
+                        send_remapped_key(engine, code, 1);
                     }
-                    send_remapped_key(code, 0);
+                    send_remapped_key(engine, code, 0);
                 }
             }
-            else if (isMapped(code))
+            else if (isMapped)
             {
-                if (isDown(value))
+                if (value == 1)
                 {
-                    state = delay;
-                    enqueue(code);
+                    engine->state = delay;
+                    if (!enqueue(&engine->queue, code))
+                    {
+                        engine->metrics.queue_overflows++;
+                    }
+                    // Holding the key for the repeat delay maps it
+                    const struct key_repeat repeat = find_repeat(engine->keymap, code);
+                    if (repeat.delay != 0 && action.length != 0)
+                    {
+                        start_repeat(engine, code, repeat);
+                    }
                 }
                 else
                 {
-                    send_remapped_key(code, value);
+                    // The key was pressed before the hyper key
+                    send_remapped_key(engine, code, value);
                 }
             }
             else
             {
-                if (!isModifier(code) && isDown(value))
+                if (!(action.flags & KEY_ACTION_MODIFIER) && isDown(value))
                 {
-                    if (!hyperEmitted)
+                    if (!engine->hyperEmitted)
                     {
-                        send_remapped_key(hyperKey, 1);
-                        hyperEmitted = 1;
+                        send_remapped_key(engine, engine->keymap->hyperKey, 1);
+                        engine->hyperEmitted = 1;
                     }
                 }
-                send_remapped_key(code, value);
+                send_remapped_key(engine, code, value);
             }
             break;
         }
         case delay: // 2
         {
-            if (isHyper(code))
+            if (isHyper)
             {
                 if (!isDown(value))
                 {
-                    state = idle;
-                    if (!hyperEmitted)
+                    engine->state = idle;
+                    stop_repeat(engine);
+                    if (!engine->hyperEmitted)
                     {
-                        send_remapped_key(hyperKey, 1);
+                        send_remapped_key(engine, engine->keymap->hyperKey, 1);
                     }
-                    send_remapped_queue(1);
-                    send_remapped_key(hyperKey, 0);
+                    send_remapped_queue(engine, 1);
+                    send_remapped_key(engine, engine->keymap->hyperKey, 0);
                 }
             }
-            else if (isMapped(code))
+            else if (isMapped && value != 1 && !isInQueue(&engine->queue, code))
             {
-                state = map;
+                // The key was pressed before the hyper key
+                send_remapped_key(engine, code, value);
+            }
+            else if (isMapped)
+            {
+                engine->state = map;
                 if (isDown(value))
                 {
-                    if (lengthOfQueue() != 0)
+                    if (lengthOfQueue(&engine->queue) != 0)
+                    {
+                        send_mapped_key(engine, peek(&engine->queue), 1);
+                    }
+                    if (!enqueue(&engine->queue, code))
                     {
-                        send_mapped_key(peek(), 1);
+                        engine->metrics.queue_overflows++;
                     }
-                    enqueue(code);
-                    send_mapped_key(code, value);
+                    send_mapped_key(engine, code, value);
                 }
                 else
                 {
-                    send_mapped_queue(1);
-                    send_mapped_key(code, value);
+                    send_mapped_queue(engine, 1);
+                    send_mapped_key(engine, code, value);
                 }
             }
             else
             {
-                state = map;
-                send_remapped_key(code, value);
+                engine->state = map;
+                send_remapped_key(engine, code, value);
             }
             break;
         }
         case map: // 3
         {
-            if (isHyper(code))
+            if (isHyper)
             {
                 if (!isDown(value))
                 {
-                    state = idle;
-                    send_mapped_queue(0);
+                    engine->state = idle;
+                    stop_repeat(engine);
+                    send_mapped_queue(engine, 0);
+                    if (engine->hyperEmitted)
+                    {
+                        send_remapped_key(engine, code, 0);
+                    }
                 }
             }
-            else if (isMapped(code))
+            else if (isMapped && value != 1 && !isInQueue(&engine->queue, code))
+            {
+                // The key was pressed before the hyper key
+                send_remapped_key(engine, code, value);
+            }
+            else if (isMapped)
             {
                 if (isDown(value))
                 {
-                    enqueue(code);
+                    if (!enqueue(&engine->queue, code))
+                    {
+                        engine->metrics.queue_overflows++;
+                    }
                 }
-                send_mapped_key(code, value);
+                send_mapped_key(engine, code, value);
             }
             else
             {
-                send_remapped_key(code, value);
+                send_remapped_key(engine, code, value);
             }
             break;
         }
     }
-    /* printf("processKey(out): state=%i\n", state); */
+    if (engine->recorder && engine->state != previous)
+    {
+        record_event(engine->recorder, record_state, previous, engine->state);
+    }
+}
+
+/**
+ * Processes a key input event. Converts and emits events as necessary.
+ * */
+void processKey(struct tc_engine* engine, int type, int code, int value, uint64_t time)
+{
+    const enum states previous = engine->state;
+    engine->eventTime = time;
+    // A key held when the mapper was released is pressed again before it counts
+    if ((unsigned int)code < KEY_CNT && engine->releasedKeys[code])
+    {
+        // The mark is kept through the repeats, and cleared by the release
+        engine->releasedKeys[code] = value == 2;
+        if (value != 1)
+        {
+            return;
+        }
+    }
+    PROBE3(process_key_entry, code, value, previous);
+    processKeyEvent(engine, code, value);
+    PROBE3(process_key_exit, code, previous, engine->state);
+}
+
+/**
+ * Handles the end of the combo window.
+ * */
+static void onComboTimer(struct timer* timer)
+{
+    struct tc_engine* engine = (struct tc_engine*)((char*)timer - offsetof(struct tc_engine, comboTimer));
+    engine->eventTime = engine->comboDeadline;
+    resolvePending(engine);
+}
+
+/**
+ * Handles the end of the tap/hold term, the undecided key is held.
+ * */
+static void onTapHoldTimer(struct timer* timer)
+{
+    struct tc_engine* engine = (struct tc_engine*)((char*)timer - offsetof(struct tc_engine, tapHoldTimer));
+    engine->eventTime = engine->tapHoldDeadline;
+    decideTapHold(engine, tap_hold_hold);
+}
+
+/**
+ * Repeats the last key of the sequence of the repeating mapped key.
+ * The modifiers of a chord stay held, only the key repeats. A mapped key
+ * still undecided after the repeat delay is mapped, as a repeat of the input
+ * device would map it, and repeats from then on.
+ * */
+static void onRepeatTimer(struct timer* timer)
+{
+    struct tc_engine* engine = (struct tc_engine*)((char*)timer - offsetof(struct tc_engine, repeatTimer));
+    engine->eventTime = engine->repeatDeadline;
+    const struct key_action action = engine->keymap->key_actions[engine->repeatCode];
+    const int code = engine->keymap->key_sequences[action.offset + action.length - 1] & ~SEQUENCE_CHORD;
+    if (engine->state == delay)
+    {
+        mapKey(engine, engine->repeatCode, 2);
+        if (engine->repeatCode == 0)
+        {
+            return;
+        }
+        engine->repeatDeadline = engine->eventTime;
+    }
+    else if (engine->keystate[code] == 0)
+    {
+        // The key was not sent, or was released by another key
+        engine->repeatCode = 0;
+        return;
+    }
+    else
+    {
+        engine->metrics.mapped++;
+        send_key(engine, code, 2);
+        // Accelerate down to the minimum interval
+        if (engine->repeatInterval > engine->repeatMinimum)
+        {
+            engine->repeatInterval -= engine->repeatInterval / 16 > 0 ? engine->repeatInterval / 16 : 1;
+            if (engine->repeatInterval < engine->repeatMinimum)
+            {
+                engine->repeatInterval = engine->repeatMinimum;
+            }
+        }
+    }
+    // A late repeat catches up without a burst of repeats
+    engine->repeatDeadline += engine->repeatInterval;
+    const uint64_t now = engine->clock();
+    if (engine->repeatDeadline <= now)
+    {
+        engine->repeatDeadline = now + engine->repeatInterval;
+    }
+    timer_start(engine->timers, &engine->repeatTimer, engine->repeatDeadline);
+}
+
+/**
+ * Initializes an engine in the idle state.
+ * */
+void initEngine(struct tc_engine* engine, const struct tc_keymap* keymap, struct timer_wheel* timers,
+    void (*output)(void* context, const struct input_event* events, int count), void* context)
+{
+    memset(engine, 0, sizeof(*engine));
+    engine->keymap = keymap;
+    engine->timers = timers;
+    engine->clock = current_time;
+    engine->output = output;
+    engine->context = context;
+    engine->comboTimer.callback = onComboTimer;
+    engine->tapHoldTimer.callback = onTapHoldTimer;
+    engine->repeatTimer.callback = onRepeatTimer;
+    engine->activeCombo = -1;
+}
+
+/**
+ * Resets the mapper to the idle state, dropping any pending events.
+ * */
+void resetMapper(struct tc_engine* engine)
+{
+    engine->state = idle;
+    engine->hyperEmitted = 0;
+    clearQueue(&engine->queue);
+    engine->pendingLength = 0;
+    engine->pendingKeys = 0;
+    engine->consumedKeys = 0;
+    engine->activeCombo = -1;
+    engine->tapHoldLength = 0;
+    timer_stop(engine->timers, &engine->comboTimer);
+    timer_stop(engine->timers, &engine->tapHoldTimer);
+    stop_repeat(engine);
+    memset(engine->tapHoldDecisions, 0, sizeof(engine->tapHoldDecisions));
+    memset(engine->presses, 0, sizeof(engine->presses));
+    memset(engine->chord_modifiers, 0, sizeof(engine->chord_modifiers));
+    memset(engine->keystate, 0, sizeof(engine->keystate));
+    memset(engine->releasedKeys, 0, sizeof(engine->releasedKeys));
+}
+
+/**
+ * Releases the keys the engine holds down on the output in one frame, and resets the mapper.
+ * The releases go through the output sink and the flight recorder like any other frame.
+ *
+ * @param held The input keys held down, indexed by code. Their repeats and releases
+ * are dropped, the output keys they pressed are already released.
+ * */
+void releaseMapper(struct tc_engine* engine, const unsigned char* held)
+{
+    struct input_event events[KEY_CNT + 1];
+    int count = 0;
+    for (int code = 0; code < KEY_CNT; code++)
+    {
+        if (engine->keystate[code] > 0)
+        {
+            events[count++] = (struct input_event){ .type = EV_KEY, .code = code, .value = 0 };
+        }
+    }
+    if (count > 0)
+    {
+        events[count++] = (struct input_event){ .type = EV_SYN, .code = SYN_REPORT };
+        send_events(engine, events, count);
+    }
+    resetMapper(engine);
+    memcpy(engine->releasedKeys, held, sizeof(engine->releasedKeys));
+}
+
+/**
+ * Releases input keys through the engine, as if they had been released at the time.
+ * A device that fails lets go of the keys it held this way, so the engine it
+ * shares with the other devices of its group carries on mapping them.
+ *
+ * @param held The input keys to release, indexed by code.
+ * */
+void releaseKeys(struct tc_engine* engine, const unsigned char* held, uint64_t time)
+{
+    for (int code = 0; code < KEY_CNT; code++)
+    {
+        if (held[code])
+        {
+            processKey(engine, EV_KEY, code, 0, time);
+        }
+    }
 }
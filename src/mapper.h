@@ -1,6 +1,14 @@
 #ifndef mapper_h
 #define mapper_h
 
+#include <linux/input.h>
+#include <stdint.h>
+
+#include "keymap.h"
+#include "queue.h"
+#include "recorder.h"
+#include "timer.h"
+
 // The state machine states
 enum states
 {
@@ -10,11 +18,141 @@ enum states
     map
 };
 
-extern enum states state;
+// A key event held back while its meaning is undecided
+struct pending_event
+{
+    uint64_t time;
+    uint16_t code;
+    int16_t value;
+};
+
+// The maximum number of events held back by the combo and tap/hold stages
+#define MAX_PENDING 16
+
+/**
+ * The counters of a mapper engine.
+ * They are only written by the thread running the engine, readers on other
+ * threads may see counters that are a few events behind.
+ * */
+struct tc_engine_metrics
+{
+    // The key events sent as bindings of the hyper key
+    uint64_t mapped;
+    // The key events sent as their remapped code
+    uint64_t passthrough;
+    // The number of times the hyper key was pressed
+    uint64_t hyper_activations;
+    // The mapped keys dropped because the queue of held mapped keys was full
+    uint64_t queue_overflows;
+};
+
+/**
+ * A mapper engine: the state of the mapper for one stream of key events.
+ * Engines share nothing but their keymap, which they only read, so any
+ * number of engines can run side by side, on any threads.
+ * */
+struct tc_engine
+{
+    // The compiled key tables
+    const struct tc_keymap* keymap;
+    // The timer wheel of the combo window and tap/hold term timers, and its clock in microseconds
+    struct timer_wheel* timers;
+    uint64_t (*clock)();
+    // The time of the event or the timer being processed, in microseconds
+    uint64_t eventTime;
+    // The output sink, receives frames of key events ended by EV_SYN events
+    void (*output)(void* context, const struct input_event* events, int count);
+    void* context;
+    // The keys held down on the output
+    unsigned char keystate[KEY_CNT];
+
+    // The state machine state
+    enum states state;
+    // Flag if the hyper key has been emitted
+    int hyperEmitted;
+    // The mapped keys held down while the hyper key is held
+    struct queue queue;
+    // The number of chords holding each modifier down
+    unsigned char chord_modifiers[KEY_CNT];
+
+    // The events held back while waiting for the other keys of a combo
+    struct pending_event pending[MAX_PENDING];
+    int pendingLength;
+    uint32_t pendingKeys;
+    uint64_t comboDeadline;
+    struct timer comboTimer;
+    // The keys of the fired combo that are still held, and the combo
+    uint32_t consumedKeys;
+    int activeCombo;
+
+    // The events held back while a tap/hold key is undecided, the first is the undecided key
+    struct pending_event tapHoldEvents[MAX_PENDING];
+    int tapHoldLength;
+    uint64_t tapHoldDeadline;
+    struct timer tapHoldTimer;
+    // The decision for each tap/hold key while it is held
+    unsigned char tapHoldDecisions[KEY_CNT];
+
+    // The mapped key that repeats, 0 if none, the time of its next repeat, and its interval and minimum interval in microseconds
+    int repeatCode;
+    uint64_t repeatDeadline;
+    uint64_t repeatInterval;
+    uint64_t repeatMinimum;
+    struct timer repeatTimer;
+
+    // Set while the combo and tap/hold stages pass events on to the hyper key state machine
+    int stageBypass;
+    // The number of held keys that press each code in the hyper key state machine,
+    // more than one when a tap or hold key is the code of another held key
+    unsigned char presses[KEY_CNT];
+    // The input keys held when the mapper was released, their repeats and release are dropped
+    unsigned char releasedKeys[KEY_CNT];
+
+    // The counters, they are not reset with the mapper
+    struct tc_engine_metrics metrics;
+    // The flight recorder of the input and output key events and the state transitions, NULL if none
+    struct flight_recorder* recorder;
+};
+
+/**
+ * Initializes an engine in the idle state.
+ *
+ * @param keymap The compiled key tables, they must outlive the engine.
+ * @param timers The timer wheel the engine starts its timers on.
+ * @param output The output sink, called with the context and the events to send.
+ * */
+void initEngine(struct tc_engine* engine, const struct tc_keymap* keymap, struct timer_wheel* timers,
+    void (*output)(void* context, const struct input_event* events, int count), void* context);
 
 /**
  * Processes a key input event. Converts and emits events as necessary.
+ *
+ * @param time The time of the event in microseconds, on the clock of the engine.
+ * Decisions are made at the time of the event, not at the time it is processed.
+ * */
+void processKey(struct tc_engine* engine, int type, int code, int value, uint64_t time);
+
+/**
+ * Resets the mapper to the idle state, dropping any pending events.
+ * */
+void resetMapper(struct tc_engine* engine);
+
+/**
+ * Releases the keys the engine holds down on the output in one frame, and resets the mapper.
+ * The releases go through the output sink and the flight recorder like any other frame.
+ *
+ * @param held The input keys held down, indexed by code. Their repeats and releases
+ * are dropped, the output keys they pressed are already released.
+ * */
+void releaseMapper(struct tc_engine* engine, const unsigned char* held);
+
+/**
+ * Releases input keys through the engine, as if they had been released at the time.
+ * A device that fails lets go of the keys it held this way, so the engine it
+ * shares with the other devices of its group carries on mapping them.
+ *
+ * @param held The input keys to release, indexed by code.
  * */
-void processKey(int code, int type, int value);
+void releaseKeys(struct tc_engine* engine, const unsigned char* held, uint64_t time);
 
 #endif
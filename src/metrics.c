@@ -0,0 +1,171 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "buffers.h"
+#include "metrics.h"
+#include "watch.h"
+
+struct metrics metrics;
+int metrics_file_descriptor = -1;
+char metrics_bound_path[108] = { '\0' };
+
+/**
+ * Appends a counter to the metrics text.
+ *
+ * @return int The length of the text with the counter.
+ * */
+static int append_counter(char* buffer, size_t size, int length, const char* name, const char* help, const char* value)
+{
+    size_t offset = (size_t)length < size ? (size_t)length : size;
+    return length + snprintf(buffer + offset, size - offset,
+        "# HELP touchcursor_%s %s\n# TYPE touchcursor_%s counter\ntouchcursor_%s %s\n", name, help, name, name, value);
+}
+
+/**
+ * Formats the metrics in the Prometheus text exposition format.
+ *
+ * @return int The length of the text, the text is truncated to the buffer size.
+ * */
+int format_metrics(char* buffer, size_t size, const struct tc_engine_metrics* engine_metrics)
+{
+    const struct
+    {
+        const char* name;
+        const char* help;
+        uint64_t value;
+    } counters[] = {
+        { "events_read_total", "Events read from the input device.", metrics.events_read },
+        { "events_emitted_total", "Key events written to the output device.", metrics.events_emitted },
+        { "mapped_events_total", "Key events sent as bindings of the hyper key.", engine_metrics->mapped },
+        { "passthrough_events_total", "Key events sent as their remapped key.", engine_metrics->passthrough },
+        { "hyper_activations_total", "Presses of the hyper key.", engine_metrics->hyper_activations },
+        { "queue_overflows_total", "Mapped keys dropped because too many were held.", engine_metrics->queue_overflows },
+        { "partial_reads_total", "Reads from the input device that ended with a partial event.", metrics.partial_reads },
+        { "reloads_total", "Configuration reloads.", metrics.reloads },
+        { "suppressed_reloads_total", "Configuration changes that did not cause a reload.", suppressed_reloads },
+    };
+    if (size > 0)
+    {
+        buffer[0] = '\0';
+    }
+    int length = 0;
+    char value[32];
+    for (size_t i = 0; i < sizeof(counters) / sizeof(counters[0]); i++)
+    {
+        snprintf(value, sizeof(value), "%llu", (unsigned long long)counters[i].value);
+        length = append_counter(buffer, size, length, counters[i].name, counters[i].help, value);
+    }
+    snprintf(value, sizeof(value), "%llu.%06llu",
+        (unsigned long long)(metrics.reload_time / 1000000), (unsigned long long)(metrics.reload_time % 1000000));
+    return append_counter(buffer, size, length, "reload_seconds_total", "Time spent reloading the configuration.", value);
+}
+
+/**
+ * Creates the listening Unix socket serving the metrics at the path.
+ *
+ * @remarks
+ * The daemon may run set-user-ID root, the socket is created with the
+ * permissions of the real user so the configuration cannot be used to
+ * replace files the user could not replace itself.
+ * A stale socket left at the path is replaced, any other file is kept.
+ * */
+int bind_metrics_socket(const char* path)
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path))
+    {
+        error("error: metrics socket path is too long: %s\n", path);
+        return EXIT_FAILURE;
+    }
+    strcpy(address.sun_path, path);
+    metrics_file_descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (metrics_file_descriptor < 0)
+    {
+        error("error: failed to create the metrics socket: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    uid_t effective_user = geteuid();
+    if (seteuid(getuid()) < 0)
+    {
+        error("error: failed to drop privileges for the metrics socket: %s\n", strerror(errno));
+        release_metrics_socket();
+        return EXIT_FAILURE;
+    }
+    struct stat status;
+    if (lstat(path, &status) == 0 && S_ISSOCK(status.st_mode))
+    {
+        unlink(path);
+    }
+    int result = bind(metrics_file_descriptor, (struct sockaddr*)&address, sizeof(address));
+    int bind_error = errno;
+    seteuid(effective_user);
+    if (result < 0)
+    {
+        error("error: failed to bind the metrics socket %s: %s\n", path, strerror(bind_error));
+        release_metrics_socket();
+        return EXIT_FAILURE;
+    }
+    strcpy(metrics_bound_path, path);
+    if (listen(metrics_file_descriptor, 8) < 0)
+    {
+        error("error: failed to listen on the metrics socket: %s\n", strerror(errno));
+        release_metrics_socket();
+        return EXIT_FAILURE;
+    }
+    log("info: serving metrics on %s\n", path);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Accepts the pending connections on the metrics socket, writing the metrics to each and closing it.
+ *
+ * @remarks
+ * The metrics are written without waiting, a client that does not read
+ * them cannot stall the event loop.
+ * */
+void serve_metrics(const struct tc_engine_metrics* engine_metrics)
+{
+    char buffer[4096];
+    int connection;
+    while ((connection = accept4(metrics_file_descriptor, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+    {
+        int length = format_metrics(buffer, sizeof(buffer), engine_metrics);
+        if ((size_t)length >= sizeof(buffer))
+        {
+            length = sizeof(buffer) - 1;
+        }
+        send(connection, buffer, length, MSG_DONTWAIT | MSG_NOSIGNAL);
+        close(connection);
+    }
+}
+
+/**
+ * Closes the metrics socket and removes its path.
+ * */
+void release_metrics_socket()
+{
+    if (metrics_file_descriptor >= 0)
+    {
+        close(metrics_file_descriptor);
+        metrics_file_descriptor = -1;
+    }
+    if (metrics_bound_path[0] != '\0')
+    {
+        uid_t effective_user = geteuid();
+        if (seteuid(getuid()) == 0)
+        {
+            unlink(metrics_bound_path);
+            seteuid(effective_user);
+        }
+        metrics_bound_path[0] = '\0';
+    }
+}
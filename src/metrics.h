@@ -0,0 +1,63 @@
+#ifndef metrics_h
+#define metrics_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mapper.h"
+
+/**
+ * The counters of the daemon, besides the counters of its engine.
+ * They are only written by the event loop thread.
+ * */
+struct metrics
+{
+    // The events read from the input device
+    uint64_t events_read;
+    // The key events written to the output device
+    uint64_t events_emitted;
+    // The reads from the input device that ended with a partial event
+    uint64_t partial_reads;
+    // The number of reloads and their total duration in microseconds
+    uint64_t reloads;
+    uint64_t reload_time;
+};
+
+/**
+ * The counters of the daemon.
+ * */
+extern struct metrics metrics;
+
+/**
+ * The listening socket serving the metrics, -1 if the metrics are not served.
+ * */
+extern int metrics_file_descriptor;
+
+/**
+ * The path the metrics socket is bound to, empty if the metrics are not served.
+ * */
+extern char metrics_bound_path[108];
+
+/**
+ * Formats the metrics in the Prometheus text exposition format.
+ *
+ * @return int The length of the text, the text is truncated to the buffer size.
+ * */
+int format_metrics(char* buffer, size_t size, const struct tc_engine_metrics* engine_metrics);
+
+/**
+ * Creates the listening Unix socket serving the metrics at the path.
+ * */
+int bind_metrics_socket(const char* path);
+
+/**
+ * Accepts the pending connections on the metrics socket, writing the metrics to each and closing it.
+ * */
+void serve_metrics(const struct tc_engine_metrics* engine_metrics);
+
+/**
+ * Closes the metrics socket and removes its path.
+ * */
+void release_metrics_socket();
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef probes_h
+#define probes_h
+
+#include <stdint.h>
+
+/**
+ * Statically defined tracepoints (USDT) of the touchcursor provider.
+ *
+ * @remarks
+ * A probe is a nop in the code and a note in the .note.stapsdt section, in
+ * the format written by the sys/sdt.h header of systemtap, so bpftrace and
+ * perf can attach to a running daemon without it linking or loading
+ * anything. The arguments are passed as signed 64 bit values, and are only
+ * read when a probe is attached.
+ *
+ * bpftrace -l 'usdt:/usr/bin/touchcursor:*'
+ * bpftrace -e 'usdt:/usr/bin/touchcursor:touchcursor:process_key_exit { @[arg1, arg2] = count(); }'
+ * perf buildid-cache --add /usr/bin/touchcursor && perf record -e sdt_touchcursor:process_key_entry
+ *
+ * Define TOUCHCURSOR_NO_PROBES to compile the probes out.
+ * https://sourceware.org/systemtap/wiki/UserSpaceProbeImplementation
+ * */
+#if !defined(TOUCHCURSOR_NO_PROBES) && defined(__GNUC__) && (defined(__x86_64__) || defined(__aarch64__))
+
+#define PROBE_NOTE(name, arguments)                                              \
+    "990: nop\n"                                                                 \
+    ".pushsection .note.stapsdt,\"?\",\"note\"\n"                                \
+    ".balign 4\n"                                                                \
+    ".4byte 992f-991f, 994f-993f, 3\n"                                           \
+    "991: .asciz \"stapsdt\"\n"                                                  \
+    "992: .balign 4\n"                                                           \
+    "993: .8byte 990b\n"                                                         \
+    ".8byte _.stapsdt.base\n"                                                    \
+    ".8byte 0\n"                                                                 \
+    ".asciz \"touchcursor\"\n"                                                   \
+    ".asciz \"" #name "\"\n"                                                     \
+    ".asciz \"" arguments "\"\n"                                                 \
+    "994: .balign 4\n"                                                           \
+    ".popsection\n"                                                              \
+    ".ifndef _.stapsdt.base\n"                                                   \
+    ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"      \
+    ".weak _.stapsdt.base\n"                                                     \
+    ".hidden _.stapsdt.base\n"                                                   \
+    "_.stapsdt.base: .space 1\n"                                                 \
+    ".size _.stapsdt.base, 1\n"                                                  \
+    ".popsection\n"                                                              \
+    ".endif\n"
+
+#define PROBE0(name) \
+    __asm__ __volatile__(PROBE_NOTE(name, "") ::)
+#define PROBE1(name, a) \
+    __asm__ __volatile__(PROBE_NOTE(name, "-8@%0") :: "nor"((int64_t)(a)))
+#define PROBE2(name, a, b) \
+    __asm__ __volatile__(PROBE_NOTE(name, "-8@%0 -8@%1") :: "nor"((int64_t)(a)), "nor"((int64_t)(b)))
+#define PROBE3(name, a, b, c)                                              \
+    __asm__ __volatile__(PROBE_NOTE(name, "-8@%0 -8@%1 -8@%2")             \
+                         :: "nor"((int64_t)(a)), "nor"((int64_t)(b)), "nor"((int64_t)(c)))
+
+#else
+
+#define PROBE0(name) do { } while (0)
+#define PROBE1(name, a) do { } while (0)
+#define PROBE2(name, a, b) do { } while (0)
+#define PROBE3(name, a, b, c) do { } while (0)
+
+#endif
+
+#endif
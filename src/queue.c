@@ -1,104 +1,118 @@
+#include "probes.h"
 #include "queue.h"
 
-#define length 8
-
-// The queue store
-static int store[length];
-
-// The queue indexes
-static int tail = 0;
-static int head = 0;
+#define length QUEUE_LENGTH
 
 /**
  * Clears the queue.
  * */
-void clearQueue()
+void clearQueue(struct queue* queue)
 {
     for (int i = 0; i < length; i++)
     {
-        store[i] = 0;
+        queue->store[i] = 0;
     }
-    head = tail = 0;
+    queue->head = queue->tail = 0;
 }
 
 /**
  * Returns the current length of the queue.
  * */
-int lengthOfQueue()
+int lengthOfQueue(const struct queue* queue)
 {
-    return ((tail + length) - head) % length;
+    return ((queue->tail + length) - queue->head) % length;
+}
+
+/**
+ * Checks if the value is in the queue.
+ * */
+int isInQueue(const struct queue* queue, int value)
+{
+    for (int i = queue->head; i != queue->tail; i = (i + 1) % length)
+    {
+        if (queue->store[i] == value)
+        {
+            return 1;
+        }
+    }
+    return 0;
 }
 
 /**
  * Pushes the value on the queue, if the value does not already exist in the queue.
+ *
+ * @return int 0 if the queue is full and the value was dropped, otherwise 1.
  * */
-void enqueue(int value)
+int enqueue(struct queue* queue, int value)
 {
-    for (int i = head; i != tail; i = (i + 1) % length)
+    for (int i = queue->head; i != queue->tail; i = (i + 1) % length)
     {
-        if (store[i] == value)
+        if (queue->store[i] == value)
         {
-            return;
+            return 1;
         }
     }
-    int index = (tail + 1) % length;
-    if (index == head)
+    int index = (queue->tail + 1) % length;
+    if (index == queue->head)
     {
-        return;
+        PROBE2(enqueue, value, 0);
+        return 0;
     }
-    store[tail] = value;
-    tail = index;
+    queue->store[queue->tail] = value;
+    queue->tail = index;
+    PROBE2(enqueue, value, 1);
+    return 1;
 }
 
 /**
  * Removes the first value from the queue and returns it.
  * */
-int dequeue()
+int dequeue(struct queue* queue)
 {
-    if (head == tail)
+    if (queue->head == queue->tail)
     {
         return 0;
     }
-    int value = store[head];
-    head = (head + 1) % length;
+    int value = queue->store[queue->head];
+    queue->head = (queue->head + 1) % length;
+    PROBE1(dequeue, value);
     return value;
 }
 
 /**
  * Returns the first value in the queue without removing it.
  * */
-int peek()
+int peek(const struct queue* queue)
 {
-    if (head == tail)
+    if (queue->head == queue->tail)
     {
         return 0;
     }
-    return store[head];
+    return queue->store[queue->head];
 }
 
 /**
  * Remove key from the queue.
  * */
-void removeKeyFromQueue(int value)
+void removeKeyFromQueue(struct queue* queue, int value)
 {
-    for (int i = head; i != tail; i = (i + 1) % length)
+    for (int i = queue->head; i != queue->tail; i = (i + 1) % length)
     {
-        if (store[i] == value)
+        if (queue->store[i] == value)
         {
-            if (i == head)
+            if (i == queue->head)
             {
-                head = (head + 1) % length;
+                queue->head = (queue->head + 1) % length;
             }
             else
             {
-                if (i != tail)
+                // Shift the values after it back by one, wrapping around the store
+                for (int j = (i + 1) % length; j != queue->tail; j = (j + 1) % length)
                 {
-                    for (int j = (i + 1) % length; j != tail; j = (j + 1) % length, i++)
-                    {
-                        store[i] = store[j];
-                    }
+                    queue->store[i] = queue->store[j];
+                    i = j;
                 }
-                tail = (length + tail - 1) % length;
+                queue->tail = (length + queue->tail - 1) % length;
             }
             return;
         }
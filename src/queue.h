@@ -1,34 +1,53 @@
 #ifndef queue_h
 #define queue_h
 
+#define QUEUE_LENGTH 8
+
+/**
+ * A queue of key codes, holding up to QUEUE_LENGTH - 1 distinct codes.
+ * */
+struct queue
+{
+    int store[QUEUE_LENGTH];
+    int head;
+    int tail;
+};
+
 /**
  * Clears the queue.
  * */
-void clearQueue();
+void clearQueue(struct queue* queue);
 
 /**
  * Returns the current length of the queue.
  * */
-int lengthOfQueue();
+int lengthOfQueue(const struct queue* queue);
+
+/**
+ * Checks if the value is in the queue.
+ * */
+int isInQueue(const struct queue* queue, int value);
 
 /**
  * Pushes the value on the queue, if the value does not already exist in the queue.
+ *
+ * @return int 0 if the queue is full and the value was dropped, otherwise 1.
  * */
-void enqueue(int value);
+int enqueue(struct queue* queue, int value);
 
 /**
  * Removes the first value from the queue and returns it.
  * */
-int dequeue();
+int dequeue(struct queue* queue);
 
 /**
  * Returns the first value in the queue without removing it.
  * */
-int peek();
+int peek(const struct queue* queue);
 
 /**
  * Remove key from the queue.
  * */
-void removeKeyFromQueue(int value);
+void removeKeyFromQueue(struct queue* queue, int value);
 
 #endif
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "keys.h"
+#include "recorder.h"
+
+// The trace threads of the records
+#define TRACE_INPUT 1
+#define TRACE_OUTPUT 2
+#define TRACE_STATE 3
+
+static const char* state_names[] = { "idle", "hyper", "delay", "map" };
+static const char* value_names[] = { "up", "down", "repeat" };
+static const char* mark_names[] = { "dump", "stuck key", "dropped input" };
+
+/**
+ * Clears the recorder.
+ * */
+void clear_recorder(struct flight_recorder* recorder)
+{
+    memset(recorder, 0, sizeof(*recorder));
+}
+
+/**
+ * Writes the name of a state, or its number if it has no name.
+ * */
+static void write_state(FILE* file, int state)
+{
+    if (state >= 0 && state < (int)(sizeof(state_names) / sizeof(state_names[0])))
+    {
+        fputs(state_names[state], file);
+    }
+    else
+    {
+        fprintf(file, "%i", state);
+    }
+}
+
+/**
+ * Writes a record as a trace event.
+ * */
+static void write_record(FILE* file, const struct record* record)
+{
+    unsigned long long time = record->time;
+    switch (record->kind)
+    {
+        case record_input:
+        case record_output:
+        {
+            const char* name = convertKeyCodeToString(record->code);
+            fputs("{\"name\":\"", file);
+            if (name != NULL)
+            {
+                fputs(name, file);
+            }
+            else
+            {
+                fprintf(file, "KEY %i", record->code);
+            }
+            if (record->value >= 0 && record->value <= 2)
+            {
+                fprintf(file, " %s", value_names[record->value]);
+            }
+            fprintf(file, "\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":1,\"tid\":%i,\"args\":{\"code\":%u,\"value\":%i}}",
+                record->kind == record_input ? "input" : "output", time,
+                record->kind == record_input ? TRACE_INPUT : TRACE_OUTPUT, record->code, record->value);
+            break;
+        }
+        case record_state:
+        {
+            fputs("{\"name\":\"", file);
+            write_state(file, record->code);
+            fputs(" -> ", file);
+            write_state(file, record->value);
+            fprintf(file, "\",\"cat\":\"state\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":1,\"tid\":%i},\n", time, TRACE_STATE);
+            fprintf(file, "{\"name\":\"state\",\"ph\":\"C\",\"ts\":%llu,\"pid\":1,\"args\":{\"state\":%i}}", time, record->value);
+            break;
+        }
+        default:
+        {
+            const char* name = record->code < sizeof(mark_names) / sizeof(mark_names[0]) ? mark_names[record->code] : "mark";
+            fprintf(file, "{\"name\":\"%s\",\"cat\":\"mark\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%llu,\"pid\":1,\"tid\":%i,\"args\":{\"code\":%i}}",
+                name, time, TRACE_INPUT, record->value);
+            break;
+        }
+    }
+}
+
+/**
+ * Writes the records, oldest first, in the Chrome trace event format (also read by Perfetto).
+ *
+ * @remarks
+ * Input and output key events are instant events on their own threads,
+ * state transitions are instant events and a counter track of the state,
+ * and marks are global instant events.
+ * https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+ *
+ * @return int EXIT_SUCCESS, or EXIT_FAILURE if the file could not be written.
+ * */
+int write_trace(const struct flight_recorder* recorder, FILE* file)
+{
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"touchcursor\"}},\n", file);
+    fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%i,\"args\":{\"name\":\"input\"}},\n", TRACE_INPUT);
+    fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%i,\"args\":{\"name\":\"output\"}},\n", TRACE_OUTPUT);
+    fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%i,\"args\":{\"name\":\"state\"}}", TRACE_STATE);
+    uint64_t start = recorder->head > RECORDER_LENGTH ? recorder->head - RECORDER_LENGTH : 0;
+    for (uint64_t i = start; i < recorder->head; i++)
+    {
+        fputs(",\n", file);
+        write_record(file, &recorder->records[i & (RECORDER_LENGTH - 1)]);
+    }
+    fputs("\n]}\n", file);
+    return ferror(file) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
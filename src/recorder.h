@@ -0,0 +1,79 @@
+#ifndef recorder_h
+#define recorder_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+// The number of records kept by a flight recorder, a power of two
+#define RECORDER_LENGTH 16384
+
+// The kinds of records
+enum record_kinds
+{
+    // A key event read from the input device, or a dropped input (SYN_DROPPED)
+    record_input,
+    // A key event sent to the output
+    record_output,
+    // A state machine transition, from the state in the code to the state in the value
+    record_state,
+    // A dump request or an anomaly, the code is one of enum record_marks
+    record_mark
+};
+
+// The reasons for a mark record
+enum record_marks
+{
+    mark_dump,
+    mark_stuck_key,
+    mark_dropped
+};
+
+// A record of the flight recorder
+struct record
+{
+    uint64_t time;
+    uint16_t kind;
+    uint16_t code;
+    int32_t value;
+};
+
+/**
+ * A flight recorder: a ring of the last RECORDER_LENGTH records.
+ * The recorder has one writer and no locks, records are written in place and
+ * the oldest records are overwritten. It is read on the thread writing it.
+ * */
+struct flight_recorder
+{
+    struct record records[RECORDER_LENGTH];
+    // The number of records written since the recorder was cleared
+    uint64_t head;
+    // The time of the new records in microseconds, set by the owner before it feeds events,
+    // so recording does not read the clock
+    uint64_t now;
+};
+
+/**
+ * Records an event at the current time of the recorder.
+ * */
+static inline void record_event(struct flight_recorder* recorder, int kind, int code, int value)
+{
+    struct record* record = &recorder->records[recorder->head++ & (RECORDER_LENGTH - 1)];
+    record->time = recorder->now;
+    record->kind = kind;
+    record->code = code;
+    record->value = value;
+}
+
+/**
+ * Clears the recorder.
+ * */
+void clear_recorder(struct flight_recorder* recorder);
+
+/**
+ * Writes the records, oldest first, in the Chrome trace event format (also read by Perfetto).
+ *
+ * @return int EXIT_SUCCESS, or EXIT_FAILURE if the file could not be written.
+ * */
+int write_trace(const struct flight_recorder* recorder, FILE* file);
+
+#endif
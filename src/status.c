@@ -0,0 +1,187 @@
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "status.h"
+
+// The number of times a reader retries while the page is written
+#define STATUS_READ_ATTEMPTS 1000
+
+// The first field after the header, fields from here on are written by write_status
+#define STATUS_VALUES offsetof(struct tc_status, pid)
+
+/**
+ * Finds the default status page path: $XDG_RUNTIME_DIR/touchcursor.status, or /run/user/<uid>/touchcursor.status.
+ * */
+int status_page_path(char* path, size_t size)
+{
+    const char* directory = getenv("XDG_RUNTIME_DIR");
+    int length = directory != NULL && directory[0] == '/'
+        ? snprintf(path, size, "%s/touchcursor.status", directory)
+        : snprintf(path, size, "/run/user/%u/touchcursor.status", (unsigned int)getuid());
+    return length > 0 && (size_t)length < size ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * Creates (or reuses) the status page file at the path and maps it for writing.
+ *
+ * @remarks
+ * Readers that mapped the file before keep seeing the updates, the file is
+ * reused in place rather than replaced.
+ *
+ * @return struct tc_status* The page, or NULL if it could not be created.
+ * */
+struct tc_status* create_status_page(const char* path)
+{
+    int descriptor = open(path, O_RDWR | O_CREAT | O_NOFOLLOW | O_CLOEXEC, 0644);
+    if (descriptor < 0)
+    {
+        return NULL;
+    }
+    struct tc_status* page = NULL;
+    if (ftruncate(descriptor, sizeof(struct tc_status)) == 0)
+    {
+        page = mmap(NULL, sizeof(struct tc_status), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    }
+    close(descriptor);
+    if (page == NULL || page == MAP_FAILED)
+    {
+        return NULL;
+    }
+    if (page->magic != STATUS_MAGIC || page->version != STATUS_VERSION)
+    {
+        memset(page, 0, sizeof(*page));
+    }
+    // A writer that stopped while writing left the sequence odd
+    page->sequence += page->sequence & 1;
+    page->size = sizeof(struct tc_status);
+    page->version = STATUS_VERSION;
+    __atomic_store_n(&page->magic, STATUS_MAGIC, __ATOMIC_RELEASE);
+    return page;
+}
+
+/**
+ * Writes the values to the page under its seqlock, readers never wait for the writer.
+ * The header of the values is ignored.
+ * */
+void write_status(struct tc_status* page, const struct tc_status* values)
+{
+    uint32_t sequence = page->sequence;
+    __atomic_store_n(&page->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy((char*)page + STATUS_VALUES, (const char*)values + STATUS_VALUES, sizeof(*page) - STATUS_VALUES);
+    __atomic_store_n(&page->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+/**
+ * Writes the values to the page only if a value other than the update time changed.
+ * The daemon is the only writer, so the page is compared without its seqlock.
+ *
+ * @return int 1 if the page was written, otherwise 0.
+ * */
+int update_status(struct tc_status* page, const struct tc_status* values)
+{
+    struct tc_status current = *page;
+    current.updated = values->updated;
+    if (memcmp((const char*)&current + STATUS_VALUES, (const char*)values + STATUS_VALUES, sizeof(current) - STATUS_VALUES) == 0)
+    {
+        return 0;
+    }
+    write_status(page, values);
+    return 1;
+}
+
+/**
+ * Maps the status page at the path for reading.
+ *
+ * @return const struct tc_status* The page, or NULL if it is missing or is not a status page of this version.
+ * */
+const struct tc_status* open_status_page(const char* path)
+{
+    int descriptor = open(path, O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0)
+    {
+        return NULL;
+    }
+    struct stat status;
+    const struct tc_status* page = NULL;
+    if (fstat(descriptor, &status) == 0 && status.st_size >= (off_t)sizeof(struct tc_status))
+    {
+        page = mmap(NULL, sizeof(struct tc_status), PROT_READ, MAP_SHARED, descriptor, 0);
+    }
+    close(descriptor);
+    if (page == NULL || page == MAP_FAILED)
+    {
+        return NULL;
+    }
+    if (__atomic_load_n(&page->magic, __ATOMIC_ACQUIRE) != STATUS_MAGIC || page->version != STATUS_VERSION
+        || page->size < sizeof(struct tc_status))
+    {
+        close_status_page(page);
+        return NULL;
+    }
+    return page;
+}
+
+/**
+ * Reads a consistent snapshot of the page without a system call.
+ *
+ * @return int EXIT_SUCCESS, or EXIT_FAILURE if the writer kept the page busy.
+ * */
+int read_status(const struct tc_status* page, struct tc_status* snapshot)
+{
+    for (int attempt = 0; attempt < STATUS_READ_ATTEMPTS; attempt++)
+    {
+        uint32_t sequence = __atomic_load_n(&page->sequence, __ATOMIC_ACQUIRE);
+        if (sequence & 1)
+        {
+            continue;
+        }
+        memcpy(snapshot, page, sizeof(*snapshot));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&page->sequence, __ATOMIC_RELAXED) == sequence)
+        {
+            snapshot->sequence = sequence;
+            return EXIT_SUCCESS;
+        }
+    }
+    return EXIT_FAILURE;
+}
+
+/**
+ * Copies the profile name of a status, escaping the quotes, backslashes and control characters for a JSON string.
+ * */
+void escape_profile_name(const struct tc_status* status, char escaped[STATUS_ESCAPED_NAME_LENGTH])
+{
+    for (size_t i = 0; i < sizeof(status->profile_name) && status->profile_name[i] != '\0'; i++)
+    {
+        unsigned char character = status->profile_name[i];
+        if (character == '"' || character == '\\')
+        {
+            *escaped++ = '\\';
+            *escaped++ = character;
+        }
+        else if (character < 0x20)
+        {
+            escaped += sprintf(escaped, "\\u%04x", character);
+        }
+        else
+        {
+            *escaped++ = character;
+        }
+    }
+    *escaped = '\0';
+}
+
+/**
+ * Unmaps a status page.
+ * */
+void close_status_page(const struct tc_status* page)
+{
+    munmap((void*)page, sizeof(struct tc_status));
+}
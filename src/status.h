@@ -0,0 +1,102 @@
+#ifndef status_h
+#define status_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The magic number and layout version of the status page, readers check both
+#define STATUS_MAGIC 0x54435354
+#define STATUS_VERSION 1
+
+// The length of the profile name, and of the name escaped for a JSON string with six bytes per byte and the terminator
+#define STATUS_NAME_LENGTH 32
+#define STATUS_ESCAPED_NAME_LENGTH (STATUS_NAME_LENGTH * 6 + 1)
+
+/**
+ * The status page the daemon publishes in a memory-mapped file.
+ * Fields are only added at the end, in place of the reserved space, and the
+ * version is raised when the meaning of a field changes.
+ * */
+struct tc_status
+{
+    uint32_t magic;
+    uint32_t version;
+    // The size of the page, readers ignore fields beyond it
+    uint32_t size;
+    // The sequence of the seqlock, odd while the page is written
+    uint32_t sequence;
+    // The process id of the daemon
+    uint32_t pid;
+    // The state of the hyper key state machine, see enum states
+    uint32_t state;
+    // The hyper key code, and the number of mapped keys held down with it
+    uint32_t hyper_key;
+    uint32_t held_keys;
+    // The monotonic time of the last update in microseconds
+    uint64_t updated;
+    // The counters, as served by the metrics socket
+    uint64_t events_read;
+    uint64_t events_emitted;
+    uint64_t mapped;
+    uint64_t passthrough;
+    uint64_t hyper_activations;
+    uint64_t queue_overflows;
+    uint64_t reloads;
+    // Set while remapping is paused
+    uint32_t paused;
+    // The index and the name of the active profile
+    uint32_t profile;
+    char profile_name[STATUS_NAME_LENGTH];
+    uint64_t reserved[1];
+};
+
+/**
+ * Finds the default status page path: $XDG_RUNTIME_DIR/touchcursor.status, or /run/user/<uid>/touchcursor.status.
+ * */
+int status_page_path(char* path, size_t size);
+
+/**
+ * Creates (or reuses) the status page file at the path and maps it for writing.
+ *
+ * @return struct tc_status* The page, or NULL if it could not be created.
+ * */
+struct tc_status* create_status_page(const char* path);
+
+/**
+ * Writes the values to the page under its seqlock, readers never wait for the writer.
+ * The header of the values is ignored.
+ * */
+void write_status(struct tc_status* page, const struct tc_status* values);
+
+/**
+ * Writes the values to the page only if a value other than the update time changed.
+ *
+ * @return int 1 if the page was written, otherwise 0.
+ * */
+int update_status(struct tc_status* page, const struct tc_status* values);
+
+/**
+ * Maps the status page at the path for reading.
+ *
+ * @return const struct tc_status* The page, or NULL if it is missing or is not a status page of this version.
+ * */
+const struct tc_status* open_status_page(const char* path);
+
+/**
+ * Reads a consistent snapshot of the page without a system call.
+ *
+ * @return int EXIT_SUCCESS, or EXIT_FAILURE if the writer kept the page busy.
+ * */
+int read_status(const struct tc_status* page, struct tc_status* snapshot);
+
+/**
+ * Copies the profile name of a status, escaping the quotes, backslashes and control characters for a JSON string.
+ * */
+void escape_profile_name(const struct tc_status* status, char escaped[STATUS_ESCAPED_NAME_LENGTH]);
+
+/**
+ * Unmaps a status page.
+ * */
+void close_status_page(const struct tc_status* page);
+
+#endif
@@ -0,0 +1,123 @@
+// build
+// make status
+// run
+// ./out/touchcursor-status [-w] [-j] [path]
+//   -w prints the status again each time the state changes
+//   -j prints one JSON object per status
+// the path defaults to $XDG_RUNTIME_DIR/touchcursor.status
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "keys.h"
+#include "status.h"
+
+// The time between two reads of the page while watching, in milliseconds
+#define WATCH_INTERVAL 20
+
+static const char* state_names[] = { "idle", "hyper", "delay", "map" };
+
+/*
+ * Prints a status, as key=value pairs or as JSON.
+ */
+static void print_status(const struct tc_status* status, int json)
+{
+    const char* state = status->state < sizeof(state_names) / sizeof(state_names[0]) ? state_names[status->state] : "unknown";
+    const char* hyper = convertKeyCodeToString(status->hyper_key);
+    if (hyper == NULL)
+    {
+        hyper = "none";
+    }
+    char profile[STATUS_ESCAPED_NAME_LENGTH];
+    if (json)
+    {
+        escape_profile_name(status, profile);
+    }
+    else
+    {
+        snprintf(profile, sizeof(profile), "%.*s", (int)sizeof(status->profile_name), status->profile_name);
+    }
+    const char* format = json
+        ? "{\"pid\":%u,\"paused\":%u,\"profile\":\"%s\",\"state\":\"%s\",\"hyper_key\":\"%s\",\"held_keys\":%u,\"events_read\":%llu,\"events_emitted\":%llu,"
+          "\"mapped\":%llu,\"passthrough\":%llu,\"hyper_activations\":%llu,\"queue_overflows\":%llu,\"reloads\":%llu}\n"
+        : "pid=%u paused=%u profile=%s state=%s hyper_key=%s held_keys=%u events_read=%llu events_emitted=%llu "
+          "mapped=%llu passthrough=%llu hyper_activations=%llu queue_overflows=%llu reloads=%llu\n";
+    printf(format, status->pid, status->paused, profile, state, hyper, status->held_keys,
+        (unsigned long long)status->events_read, (unsigned long long)status->events_emitted,
+        (unsigned long long)status->mapped, (unsigned long long)status->passthrough,
+        (unsigned long long)status->hyper_activations, (unsigned long long)status->queue_overflows,
+        (unsigned long long)status->reloads);
+    fflush(stdout);
+}
+
+/*
+ * Main method.
+ */
+int main(int argc, char* argv[])
+{
+    int watch = 0;
+    int json = 0;
+    int option;
+    while ((option = getopt(argc, argv, "wj")) != -1)
+    {
+        switch (option)
+        {
+            case 'w':
+                watch = 1;
+                break;
+            case 'j':
+                json = 1;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-w] [-j] [path]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    char path[256];
+    if (optind < argc)
+    {
+        snprintf(path, sizeof(path), "%s", argv[optind]);
+    }
+    else if (status_page_path(path, sizeof(path)) != EXIT_SUCCESS)
+    {
+        fprintf(stderr, "error: could not find the status page path\n");
+        return EXIT_FAILURE;
+    }
+    const struct tc_status* page = open_status_page(path);
+    if (page == NULL)
+    {
+        fprintf(stderr, "error: %s is not a status page, is the daemon running?\n", path);
+        return EXIT_FAILURE;
+    }
+
+    struct tc_status status;
+    if (read_status(page, &status) != EXIT_SUCCESS)
+    {
+        fprintf(stderr, "error: could not read the status page\n");
+        close_status_page(page);
+        return EXIT_FAILURE;
+    }
+    print_status(&status, json);
+    struct tc_status previous = status;
+    const struct timespec interval = { 0, WATCH_INTERVAL * 1000000L };
+    while (watch)
+    {
+        nanosleep(&interval, NULL);
+        if (read_status(page, &status) != EXIT_SUCCESS)
+        {
+            continue;
+        }
+        if (status.pid != previous.pid || status.paused != previous.paused || status.profile != previous.profile
+            || status.state != previous.state
+            || status.hyper_key != previous.hyper_key || status.held_keys != previous.held_keys)
+        {
+            print_status(&status, json);
+            previous = status;
+        }
+    }
+    close_status_page(page);
+    return EXIT_SUCCESS;
+}
@@ -3,13 +3,27 @@
 // run
 // ./out/test
 
+#define _GNU_SOURCE
+#include <fcntl.h>
 #include <linux/input.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
+#include "clock.h"
+#include "binding.h"
 #include "config.h"
+#include "control.h"
+#include "emit.h"
 #include "keys.h"
+#include "log.h"
+#include "mapper.h"
+#include "metrics.h"
+#include "recorder.h"
+#include "status.h"
+#include "timer.h"
 
 // minunit http://www.jera.com/techinfo/jtns/jtn002.html
 #define mu_assert(message, test)     \
@@ -27,23 +41,64 @@
 static int tests_run;
 
 // String for the full key event output
-static char output[256];
+static char output[1024];
 
 // String for the emit function output
-static char emitString[8];
+static char emitString[16];
 
 /*
- * Override of the emit function(s).
+ * The output sink of the test engines, appends to the string in the context.
+ * Keys sent in the same frame are joined with '+'.
  */
-int emit(int type, int code, int value)
+static void testOutput(void* context, const struct input_event* events, int count)
 {
-    sprintf(emitString, "%i:%i ", code, value);
-    strcat(output, emitString);
-    return 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (events[i].type != EV_KEY) continue;
+        int joined = i + 1 < count && events[i + 1].type == EV_KEY;
+        sprintf(emitString, "%i:%i%c", events[i].code, events[i].value, joined ? '+' : ' ');
+        strcat((char*)context, emitString);
+    }
 }
 
-// Now include the mapper
-#include "mapper.h"
+/*
+ * Binds a key to a single output key.
+ */
+static void bind(int code, int output)
+{
+    bind_key_sequence(&keymap, code, &output, 1);
+}
+
+// The engine under test
+static struct tc_engine engine;
+
+// The virtual time in microseconds
+static uint64_t virtualTime = 1000000;
+
+/*
+ * The virtual clock of the tests.
+ */
+static uint64_t virtualClock()
+{
+    return virtualTime;
+}
+
+/*
+ * Advances the virtual time, expiring the timers that are due instantly.
+ */
+static void elapse(int milliseconds)
+{
+    virtualTime += milliseconds * 1000ULL;
+    timer_advance(&timers, virtualTime);
+}
+
+/*
+ * Sends a key event at the current virtual time, appending to the output.
+ */
+static void key(int code, int value)
+{
+    processKey(&engine, EV_KEY, code, value, virtualTime);
+}
 
 /*
  * Simulates typing keys.
@@ -51,14 +106,14 @@ int emit(int type, int code, int value)
  */
 static void type(int num, ...)
 {
-    for (int i = 0; i < 256; i++) output[i] = 0;
+    memset(output, 0, sizeof(output));
     va_list arguments;
     va_start(arguments, num);
     for (int i = 0; i < num; i += 2)
     {
         int code = va_arg(arguments, int);
         int value = va_arg(arguments, int);
-        processKey(EV_KEY, code, value);
+        processKey(&engine, EV_KEY, code, value, virtualTime);
     }
     va_end(arguments);
 }
@@ -263,36 +318,1941 @@ static int testSpecialTyping()
         printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
     }
 
+    // Mapped key down, space down, other mapped key down, mapped key up, space up, other mapped key up
+    // The mapped key pressed before space should be released as itself
+    description = "md, sd, m2d, mu, su, m2u";
+    expected = "36:1 36:0 57:1 32:1 57:0 32:0 ";
+    type(12, KEY_J, 1, KEY_SPACE, 1, KEY_D, 1, KEY_J, 0, KEY_SPACE, 0, KEY_D, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Space down, mapped key down, other mapped key down, key remapped to it down, up, space up, mapped keys up
+    // The release of the remapped key should not drop the other mapped key
+    description = "sd, md, m2d, rd, ru, su, mu, m2u";
+    expected = "103:1 105:1 36:1 36:0 103:0 105:0 23:0 36:0 ";
+    type(16, KEY_SPACE, 1, KEY_I, 1, KEY_J, 1, KEY_G, 1, KEY_G, 0, KEY_SPACE, 0, KEY_I, 0, KEY_J, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Space down, mapped keys down, key remapped to one of them down, up, mapped keys up, space up
+    // The mapped key should be released as mapped, not as itself
+    description = "sd, md, m2d, rd, ru, m2u, mu, su";
+    expected = "103:1 105:1 36:1 36:0 105:0 103:0 ";
+    type(16, KEY_SPACE, 1, KEY_I, 1, KEY_J, 1, KEY_G, 1, KEY_G, 0, KEY_J, 0, KEY_I, 0, KEY_SPACE, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Mapped key down, space down, mapped key repeat, up, space up
+    // The repeat of the mapped key pressed before space should be sent as itself
+    description = "md, sd, mr, mu, su";
+    expected = "36:1 36:2 36:0 57:1 57:0 ";
+    type(10, KEY_J, 1, KEY_SPACE, 1, KEY_J, 2, KEY_J, 0, KEY_SPACE, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Mapped key down, space down, other mapped key down, mapped key repeat, up, other up, space up
+    // The repeat should be sent as itself and leave the other mapped key undecided
+    description = "md, sd, m2d, mr, mu, m2u, su";
+    expected = "36:1 36:2 36:0 108:1 108:0 ";
+    type(14, KEY_J, 1, KEY_SPACE, 1, KEY_K, 1, KEY_J, 2, KEY_J, 0, KEY_K, 0, KEY_SPACE, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Space down, other down, mapped key down, up, space up, other up
+    // The space emitted for the other key should be released
+    description = "sd, od, md, mu, su, ou";
+    expected = "57:1 30:1 105:1 105:0 57:0 30:0 ";
+    type(12, KEY_SPACE, 1, KEY_A, 1, KEY_J, 1, KEY_J, 0, KEY_SPACE, 0, KEY_A, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
     return 0;
 }
 
 /*
- * Simple method for running all tests.
+ * Tests for bindings with long output sequences.
  */
-static int runTests()
+static int testLongSequences()
 {
-    // default config
-    hyperKey = KEY_SPACE;
-    keymap[KEY_I].sequence[0] = KEY_UP;
-    keymap[KEY_J].sequence[0] = KEY_LEFT;
-    keymap[KEY_K].sequence[0] = KEY_DOWN;
-    keymap[KEY_L].sequence[0] = KEY_RIGHT;
-    keymap[KEY_H].sequence[0] = KEY_PAGEUP;
-    keymap[KEY_N].sequence[0] = KEY_PAGEDOWN;
-    keymap[KEY_U].sequence[0] = KEY_HOME;
-    keymap[KEY_O].sequence[0] = KEY_END;
-    keymap[KEY_M].sequence[0] = KEY_DELETE;
-    keymap[KEY_P].sequence[0] = KEY_BACKSPACE;
-    keymap[KEY_Y].sequence[0] = KEY_INSERT;
+    // Space down, mapped (5 key sequence) down, up, Space up
+    // Every key of the sequence should be sent
+    char* description = "sd, md, mu, su";
+    char* expected = "35:1 18:1 38:1 38:1 24:1 35:0 18:0 38:0 38:0 24:0 ";
+    type(8, KEY_SPACE, 1, KEY_B, 1, KEY_B, 0, KEY_SPACE, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
 
-    mu_run_test(testNormalTyping);
-    printf("Normal typing tests passed.\n");
+    return 0;
+}
 
-    mu_run_test(testFastTyping);
-    printf("Fast typing tests passed.\n");
+/*
+ * Tests for chord bindings.
+ */
+static int testChords()
+{
+    // Space down, chord mapped (C-LEFT) down, up, Space up
+    // The modifier and key should be pressed in one frame and released in reverse order
+    char* description = "sd, cd, cu, su";
+    char* expected = "29:1+105:1 105:0+29:0 ";
+    type(8, KEY_SPACE, 1, KEY_D, 1, KEY_D, 0, KEY_SPACE, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
 
-    mu_run_test(testSpecialTyping);
-    printf("Special typing tests passed.\n");
+    // Ctrl down, Space down, chord mapped (C-LEFT) down, up, Space up, Ctrl up
+    // The held modifier should not be pressed or released by the chord
+    description = "ctrld, sd, cd, cu, su, ctrlu";
+    expected = "29:1 105:1 105:0 29:0 ";
+    type(12, KEY_LEFTCTRL, 1, KEY_SPACE, 1, KEY_D, 1, KEY_D, 0, KEY_SPACE, 0, KEY_LEFTCTRL, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Space down, two chords sharing a modifier down, up, Space up
+    // The shared modifier should be released only by the last chord
+    description = "sd, c1d, c2d, c1u, c2u, su";
+    expected = "29:1+105:1 106:1 105:0 106:0+29:0 ";
+    type(12, KEY_SPACE, 1, KEY_D, 1, KEY_F, 1, KEY_D, 0, KEY_F, 0, KEY_SPACE, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    return 0;
+}
+
+/*
+ * Tests for combos.
+ */
+static int testCombos()
+{
+    // Combo key 1 down, combo key 2 down, up, combo key 1 up
+    // The combo output should be sent, released with the first key
+    char* description = "c1d, c2d, c2u, c1u";
+    char* expected = "1:1 1:0 ";
+    type(8, KEY_W, 1, KEY_Q, 1, KEY_Q, 0, KEY_W, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Combo key down, up
+    // The key should be sent unchanged
+    description = "c1d, c1u";
+    expected = "17:1 17:0 ";
+    type(4, KEY_W, 1, KEY_W, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Combo key down, other down, combo key up, other up
+    // The keys should be sent in their original order
+    description = "c1d, od, c1u, ou";
+    expected = "17:1 30:1 17:0 30:0 ";
+    type(8, KEY_W, 1, KEY_A, 1, KEY_W, 0, KEY_A, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Combo key 1 down, combo key 3 (not a combo with key 1) down, up, combo key 1 up
+    // The keys should be sent in their original order
+    description = "c1d, c3d, c3u, c1u";
+    expected = "17:1 44:1 44:0 17:0 ";
+    type(8, KEY_W, 1, KEY_Z, 1, KEY_Z, 0, KEY_W, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Three key combo, of which the first two keys are also a combo
+    // The larger combo should be sent
+    description = "c3d, c4d, c5d, c3u, c4u, c5u";
+    expected = "28:1 28:0 ";
+    type(12, KEY_Z, 1, KEY_X, 1, KEY_C, 1, KEY_Z, 0, KEY_X, 0, KEY_C, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Two key combo that is part of a larger combo, released early
+    // The smaller combo should be sent
+    description = "c3d, c4d, c4u, c3u";
+    expected = "15:1 15:0 ";
+    type(8, KEY_Z, 1, KEY_X, 1, KEY_X, 0, KEY_Z, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    return 0;
+}
+
+/*
+ * Tests for tap/hold keys.
+ * These tests are faster than the tap/hold term.
+ */
+static int testTapHold()
+{
+    char* description;
+    char* expected;
+
+    // Tap/hold key down, up
+    // The tap key should be sent
+    keymap.tap_hold_interrupt = interrupt_permissive;
+    description = "thd, thu";
+    expected = "19:1 19:0 ";
+    type(4, KEY_R, 1, KEY_R, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Tap/hold key down, other down, up, tap/hold key up
+    // The permissive policy should send the hold key
+    keymap.tap_hold_interrupt = interrupt_permissive;
+    description = "thd, od, ou, thu";
+    expected = "56:1 24:1 24:0 56:0 ";
+    type(8, KEY_R, 1, KEY_O, 1, KEY_O, 0, KEY_R, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Tap/hold key down, other down, tap/hold key up, other up
+    // The permissive policy should send the tap key for rolled keys
+    keymap.tap_hold_interrupt = interrupt_permissive;
+    description = "thd, od, thu, ou";
+    expected = "19:1 24:1 19:0 24:0 ";
+    type(8, KEY_R, 1, KEY_O, 1, KEY_R, 0, KEY_O, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Tap/hold key down, other down, tap/hold key up, other up
+    // The hold policy should send the hold key when another key is pressed
+    keymap.tap_hold_interrupt = interrupt_hold;
+    description = "thd, od, thu, ou";
+    expected = "56:1 24:1 56:0 24:0 ";
+    type(8, KEY_R, 1, KEY_O, 1, KEY_R, 0, KEY_O, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Tap/hold key down, other down, up, tap/hold key up
+    // The tap policy should send the tap key before the term ends
+    keymap.tap_hold_interrupt = interrupt_tap;
+    description = "thd, od, ou, thu";
+    expected = "19:1 24:1 24:0 19:0 ";
+    type(8, KEY_R, 1, KEY_O, 1, KEY_O, 0, KEY_R, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Tap/hold key 1 down, tap/hold key 2 down, other down, up, tap/hold key 2 up, tap/hold key 1 up
+    // Both tap/hold keys should be held
+    keymap.tap_hold_interrupt = interrupt_permissive;
+    description = "th1d, th2d, od, ou, th2u, th1u";
+    expected = "56:1 42:1 24:1 24:0 42:0 56:0 ";
+    type(12, KEY_R, 1, KEY_T, 1, KEY_O, 1, KEY_O, 0, KEY_T, 0, KEY_R, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+    keymap.tap_hold_interrupt = interrupt_permissive;
+
+    return 0;
+}
+
+/*
+ * Appends the index of an expired test timer to the output.
+ */
+static struct timer testTimers[4];
+static void onTestTimer(struct timer* timer)
+{
+    sprintf(emitString, "%i ", (int)(timer - testTimers));
+    strcat(output, emitString);
+}
+
+/*
+ * Tests for timing dependent behavior, on the virtual clock.
+ * The sweeps run each case for every delay around the combo window and the tap/hold term.
+ */
+static int testTiming()
+{
+    char* description;
+    char* expected;
+
+    // Tap/hold key down, term ends, tap/hold key up
+    // The hold key should be sent when the term ends
+    description = "thd, term, thu";
+    expected = "56:1 ";
+    memset(output, 0, sizeof(output));
+    key(KEY_R, 1);
+    elapse(keymap.tap_hold_term);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    expected = "56:1 56:0 ";
+    key(KEY_R, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Shift down, tap/hold key down, term ends, shift up, tap/hold key up
+    // The hold key is shift too, shift should be released with the last key that holds it
+    description = "shiftd, thd, term, shiftu, thu";
+    expected = "42:1 42:0 ";
+    memset(output, 0, sizeof(output));
+    key(KEY_LEFTSHIFT, 1);
+    key(KEY_T, 1);
+    elapse(keymap.tap_hold_term);
+    key(KEY_LEFTSHIFT, 0);
+    if (strcmp("42:1 ", output) != 0)
+    {
+        printf("[%s] failed before the release. expected: '42:1 ', output: '%s'\n", description, output);
+        return 1;
+    }
+    key(KEY_T, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Combo key down, window ends, combo key up
+    // The key should be sent when the window ends
+    description = "cd, window, cu";
+    expected = "17:1 ";
+    memset(output, 0, sizeof(output));
+    key(KEY_W, 1);
+    elapse(keymap.combo_window);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    expected = "17:1 17:0 ";
+    key(KEY_W, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Tap/hold key down, tap/hold key up stamped before the term but processed after it, term timer
+    // The release decides the key at its timestamp, the tap key should be sent
+    description = "thd, thu stamped before the term, term";
+    expected = "19:1 19:0 ";
+    memset(output, 0, sizeof(output));
+    key(KEY_R, 1);
+    virtualTime += keymap.tap_hold_term * 1000ULL;
+    processKey(&engine, EV_KEY, KEY_R, 0, virtualTime - 1000);
+    elapse(0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Combo key 1 down, combo key 2 down stamped within the window but processed after it, window timer
+    // The combo should be sent
+    description = "c1d, c2d stamped within the window, window, c2u, c1u";
+    expected = "1:1 1:0 ";
+    memset(output, 0, sizeof(output));
+    key(KEY_W, 1);
+    virtualTime += keymap.combo_window * 1000ULL;
+    processKey(&engine, EV_KEY, KEY_Q, 1, virtualTime - 1000);
+    elapse(0);
+    key(KEY_Q, 0);
+    key(KEY_W, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Combo key 1 down, combo key 2 down stamped after the window but processed before its timer
+    // The window ends before the second key, the keys should be sent
+    description = "c1d, c2d stamped after the window, window, c2u, c1u";
+    expected = "17:1 16:1 16:0 17:0 ";
+    memset(output, 0, sizeof(output));
+    key(KEY_W, 1);
+    virtualTime += keymap.combo_window * 1000ULL;
+    processKey(&engine, EV_KEY, KEY_Q, 1, virtualTime);
+    elapse(0);
+    key(KEY_Q, 0);
+    key(KEY_W, 0);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Combo and tap/hold key down, window, term, key up
+    // The key is replayed at the end of the window with its timestamp, its term counts from the press
+    description = "cthd, window, term, cthu";
+    static struct tc_keymap replayedKeymap;
+    init_keymap(&replayedKeymap);
+    int jk[] = { KEY_J, KEY_K }, escape[] = { KEY_ESC };
+    add_combo(&replayedKeymap, jk, 2, add_key_sequence(&replayedKeymap, escape, 1), 1);
+    replayedKeymap.tap_holds[KEY_J] = (struct tap_hold){ KEY_J, KEY_LEFTCTRL };
+    compile_key_actions(&replayedKeymap);
+    struct tc_engine replayed;
+    initEngine(&replayed, &replayedKeymap, &timers, testOutput, output);
+    memset(output, 0, sizeof(output));
+    processKey(&replayed, EV_KEY, KEY_J, 1, virtualTime);
+    elapse(replayedKeymap.combo_window);
+    elapse(replayedKeymap.tap_hold_term - replayedKeymap.combo_window - 1);
+    expected = "";
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed before the term. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    elapse(1);
+    processKey(&replayed, EV_KEY, KEY_J, 0, virtualTime);
+    free_keymap(&replayedKeymap);
+    expected = "29:1 29:0 ";
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    int cases = 0;
+
+    // Combo key 1 down, delay, combo key 2 down, up, combo key 1 up
+    // The combo should be sent when the second key is pressed within the window
+    description = "c1d, delay, c2d, c2u, c1u";
+    for (int delay = 0; delay <= 2 * keymap.combo_window; delay++, cases++)
+    {
+        expected = delay < keymap.combo_window ? "1:1 1:0 " : "17:1 16:1 16:0 17:0 ";
+        memset(output, 0, sizeof(output));
+        key(KEY_W, 1);
+        elapse(delay);
+        key(KEY_Q, 1);
+        key(KEY_Q, 0);
+        key(KEY_W, 0);
+        elapse(keymap.combo_window);
+        if (strcmp(expected, output) != 0)
+        {
+            printf("[%s] failed for a delay of %i ms. expected: '%s', output: '%s'\n", description, delay, expected, output);
+            return 1;
+        }
+    }
+
+    // Tap/hold key down, delay, tap/hold key up
+    // The tap key should be sent when the key is released within the term
+    description = "thd, delay, thu";
+    for (int delay = 0; delay <= 2 * keymap.tap_hold_term; delay++, cases++)
+    {
+        expected = delay < keymap.tap_hold_term ? "19:1 19:0 " : "56:1 56:0 ";
+        memset(output, 0, sizeof(output));
+        key(KEY_R, 1);
+        elapse(delay);
+        key(KEY_R, 0);
+        if (strcmp(expected, output) != 0)
+        {
+            printf("[%s] failed for a delay of %i ms. expected: '%s', output: '%s'\n", description, delay, expected, output);
+            return 1;
+        }
+    }
+
+    // Tap/hold key down, delay 1, other down, delay 2, tap/hold key up, other up
+    // The permissive policy should send the tap key for keys rolled within the term
+    description = "thd, delay 1, od, delay 2, thu, ou";
+    keymap.tap_hold_interrupt = interrupt_permissive;
+    for (int first = 0; first <= 2 * keymap.tap_hold_term; first += 5)
+    {
+        for (int second = 0; second <= 2 * keymap.tap_hold_term; second += 5, cases++)
+        {
+            expected = first + second < keymap.tap_hold_term ? "19:1 24:1 19:0 24:0 " : "56:1 24:1 56:0 24:0 ";
+            memset(output, 0, sizeof(output));
+            key(KEY_R, 1);
+            elapse(first);
+            key(KEY_O, 1);
+            elapse(second);
+            key(KEY_R, 0);
+            key(KEY_O, 0);
+            if (strcmp(expected, output) != 0)
+            {
+                printf("[%s] failed for delays of %i and %i ms. expected: '%s', output: '%s'\n", description, first, second, expected, output);
+                return 1;
+            }
+        }
+    }
+    printf("[timing sweeps] passed. %i cases\n", cases);
+
+    return 0;
+}
+
+/*
+ * Tests for the key repeat of mapped keys, on the virtual clock.
+ */
+static int testRepeat()
+{
+    char* description;
+    char* expected;
+
+    // Space down, j down, delay, interval, repeat of j, interval, j up, space up
+    // The held key should be mapped after the delay and repeat faster each interval, the repeat of the device is dropped
+    description = "sd, jd, delay, interval, jr, interval, ju, su";
+    expected = "105:1 105:2 105:2 105:0 ";
+    keymap.repeat.minimum = keymap.repeat.interval / 2;
+    memset(output, 0, sizeof(output));
+    key(KEY_SPACE, 1);
+    key(KEY_J, 1);
+    elapse(keymap.repeat.delay);
+    elapse(keymap.repeat.interval);
+    key(KEY_J, 2);
+    elapse(keymap.repeat.interval - keymap.repeat.interval / 16);
+    key(KEY_J, 0);
+    key(KEY_SPACE, 0);
+    elapse(keymap.repeat.delay);
+    keymap.repeat.minimum = 0;
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Space down, d down, delay, interval, d up, space up
+    // Only the last key of the chord should repeat
+    description = "sd, dd, delay, interval, du, su";
+    expected = "29:1+105:1 105:2 105:0+29:0 ";
+    memset(output, 0, sizeof(output));
+    key(KEY_SPACE, 1);
+    key(KEY_D, 1);
+    elapse(keymap.repeat.delay);
+    elapse(keymap.repeat.interval);
+    key(KEY_D, 0);
+    key(KEY_SPACE, 0);
+    elapse(keymap.repeat.delay);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Space down, j down, space up, j up, delay
+    // A key typed over the hyper key should not repeat, its repeat stops with the hyper key
+    description = "sd, jd, su, ju, delay";
+    expected = "57:1 36:1 57:0 36:0 ";
+    memset(output, 0, sizeof(output));
+    key(KEY_SPACE, 1);
+    key(KEY_J, 1);
+    key(KEY_SPACE, 0);
+    int running = timer_running(&engine.repeatTimer);
+    key(KEY_J, 0);
+    elapse(keymap.repeat.delay);
+    if (strcmp(expected, output) != 0 || running)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Space down, j down, delay, space up, interval, j up
+    // Releasing the hyper key first should stop the repeat
+    description = "sd, jd, delay, su, interval, ju";
+    expected = "105:1 105:0 36:0 ";
+    memset(output, 0, sizeof(output));
+    key(KEY_SPACE, 1);
+    key(KEY_J, 1);
+    elapse(keymap.repeat.delay);
+    key(KEY_SPACE, 0);
+    elapse(keymap.repeat.interval * 2);
+    key(KEY_J, 0);
+    if (strcmp(expected, output) != 0 || timer_running(&engine.repeatTimer))
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Space down, 8 mapped keys down, 8th up
+    // The key dropped from the full queue is released as a remapped key and should stop repeating
+    description = "sd, 8 mapped keys down, 8th up";
+    const int mapped[] = { KEY_I, KEY_J, KEY_K, KEY_L, KEY_H, KEY_N, KEY_U, KEY_O };
+    const int count = sizeof(mapped) / sizeof(mapped[0]);
+    key(KEY_SPACE, 1);
+    for (int i = 0; i < count; i++)
+    {
+        key(mapped[i], 1);
+    }
+    key(mapped[count - 1], 0);
+    running = timer_running(&engine.repeatTimer);
+    for (int i = 0; i < count - 1; i++)
+    {
+        key(mapped[i], 0);
+    }
+    key(KEY_SPACE, 0);
+    if (running)
+    {
+        printf("[%s] failed. the repeat timer is running\n", description);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. the repeat timer is stopped\n", description);
+    }
+
+    // With a repeat delay of 0, the repeat of the device should be mapped
+    description = "no delay: sd, jd, jr, ju, su";
+    expected = "105:1 105:2 105:0 ";
+    keymap.repeat.delay = 0;
+    type(10, KEY_SPACE, 1, KEY_J, 1, KEY_J, 2, KEY_J, 0, KEY_SPACE, 0);
+    elapse(DEFAULT_REPEAT_DELAY);
+    keymap.repeat.delay = DEFAULT_REPEAT_DELAY;
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    return 0;
+}
+
+/*
+ * Tests for the queue of held mapped keys.
+ * The queue is a ring, removing a key shifts the keys after it back across the end of the store.
+ */
+static int testQueue()
+{
+    char* description;
+    char* expected;
+    struct queue queue;
+
+    description = "wrapped, remove from the middle";
+    expected = "7 9 10 ";
+    clearQueue(&queue);
+    for (int i = 1; i <= 7; i++)
+    {
+        enqueue(&queue, i);
+    }
+    for (int i = 1; i <= 6; i++)
+    {
+        dequeue(&queue);
+    }
+    // 8 is the last of the store, 9 and 10 wrap around to its start
+    for (int i = 8; i <= 10; i++)
+    {
+        enqueue(&queue, i);
+    }
+    removeKeyFromQueue(&queue, 8);
+    const int inRange = queue.head >= 0 && queue.head < QUEUE_LENGTH && queue.tail >= 0 && queue.tail < QUEUE_LENGTH;
+    memset(output, 0, sizeof(output));
+    while (inRange && lengthOfQueue(&queue) > 0)
+    {
+        sprintf(emitString, "%i ", dequeue(&queue));
+        strcat(output, emitString);
+    }
+    if (!inRange || strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s', head: %i, tail: %i\n", description, expected, output, queue.head, queue.tail);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    return 0;
+}
+
+/*
+ * Tests for engines sharing a keymap.
+ * Each engine has its own state and output.
+ */
+static int testEngines()
+{
+    char* description;
+    char* expected;
+    char* expectedOther;
+    static char otherOutput[1024];
+    struct tc_engine other;
+    initEngine(&other, &keymap, &timers, testOutput, otherOutput);
+
+    // Engine 1 space down, engine 2 j down, up, engine 1 j down, up, space up
+    // Only the first engine should map the key
+    description = "e1 sd, e2 jd, e2 ju, e1 jd, e1 ju, e1 su";
+    expected = "105:1 105:0 ";
+    expectedOther = "36:1 36:0 ";
+    memset(output, 0, sizeof(output));
+    memset(otherOutput, 0, sizeof(otherOutput));
+    processKey(&engine, EV_KEY, KEY_SPACE, 1, virtualTime);
+    processKey(&other, EV_KEY, KEY_J, 1, virtualTime);
+    processKey(&other, EV_KEY, KEY_J, 0, virtualTime);
+    processKey(&engine, EV_KEY, KEY_J, 1, virtualTime);
+    processKey(&engine, EV_KEY, KEY_J, 0, virtualTime);
+    processKey(&engine, EV_KEY, KEY_SPACE, 0, virtualTime);
+    if (strcmp(expected, output) != 0 || strcmp(expectedOther, otherOutput) != 0)
+    {
+        printf("[%s] failed. expected: '%s' and '%s', output: '%s' and '%s'\n", description, expected, expectedOther, output, otherOutput);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s' and '%s', output: '%s' and '%s'\n", description, expected, expectedOther, output, otherOutput);
+    }
+
+    return 0;
+}
+
+/*
+ * The output sink of the engines whose frames go to the output device, as in the daemon.
+ */
+static void queueOutput(void* context, const struct input_event* events, int count)
+{
+    (void)context;
+    queue_events(events, count);
+}
+
+/*
+ * Formats the events written to a pipe, key events as code:value and frame ends as '|'.
+ */
+static void readWritten(int descriptor, char* text)
+{
+    struct input_event written[32];
+    ssize_t length = read(descriptor, written, sizeof(written));
+    text[0] = '\0';
+    for (int i = 0; i < length / (ssize_t)sizeof(struct input_event); i++)
+    {
+        if (written[i].type == EV_KEY)
+        {
+            sprintf(emitString, "%i:%i ", written[i].code, written[i].value);
+            strcat(text, emitString);
+        }
+        else if (written[i].type == EV_SYN && written[i].code == SYN_REPORT)
+        {
+            strcat(text, "| ");
+        }
+        else
+        {
+            sprintf(emitString, "%i/%i:%i ", written[i].type, written[i].code, written[i].value);
+            strcat(text, emitString);
+        }
+    }
+}
+
+/*
+ * Tests for the fast path of keys without an action, and for bypassing the engine.
+ * The keys of the slow engine are flagged as modifiers, which only matters in
+ * the map state, so they take the hyper key state machine in every state.
+ */
+static int testFastPath()
+{
+    char* description;
+    char* expected;
+    static char slowOutput[1024];
+    static struct tc_keymap slowKeymap;
+    slowKeymap = keymap;
+    slowKeymap.key_actions[KEY_1].flags |= KEY_ACTION_MODIFIER;
+    slowKeymap.key_actions[KEY_2].flags |= KEY_ACTION_MODIFIER;
+    struct tc_engine fast;
+    struct tc_engine slow;
+    initEngine(&fast, &keymap, &timers, testOutput, output);
+    initEngine(&slow, &slowKeymap, &timers, testOutput, slowOutput);
+    const int sequences[][12] = {
+        // Unmapped keys typed in idle
+        { KEY_1, 1, KEY_2, 1, KEY_1, 0, KEY_2, 0 },
+        // A key pressed in idle and released after the hyper key is pressed
+        { KEY_1, 1, KEY_SPACE, 1, KEY_1, 0, KEY_SPACE, 0 },
+        // A key pressed in idle and released after a mapped key was typed
+        { KEY_1, 1, KEY_SPACE, 1, KEY_J, 1, KEY_J, 0, KEY_1, 0, KEY_SPACE, 0 }
+    };
+    const char* descriptions[] = { "1d, 2d, 1u, 2u", "1d, sd, 1u, su", "1d, sd, jd, ju, 1u, su" };
+    const char* expectations[] = { "2:1 3:1 2:0 3:0 ", "2:1 2:0 57:1 57:0 ", "2:1 105:1 105:0 2:0 " };
+    for (int i = 0; i < (int)(sizeof(sequences) / sizeof(sequences[0])); i++)
+    {
+        description = (char*)descriptions[i];
+        expected = (char*)expectations[i];
+        memset(output, 0, sizeof(output));
+        memset(slowOutput, 0, sizeof(slowOutput));
+        for (int j = 0; j < 12 && sequences[i][j] != 0; j += 2)
+        {
+            processKey(&fast, EV_KEY, sequences[i][j], sequences[i][j + 1], virtualTime);
+            processKey(&slow, EV_KEY, sequences[i][j], sequences[i][j + 1], virtualTime);
+        }
+        if (strcmp(expected, output) != 0 || strcmp(expected, slowOutput) != 0)
+        {
+            printf("[%s] failed. expected: '%s', fast: '%s', slow: '%s'\n", description, expected, output, slowOutput);
+            return 1;
+        }
+        else
+        {
+            printf("[%s] passed. expected: '%s', fast: '%s', slow: '%s'\n", description, expected, output, slowOutput);
+        }
+    }
+    if (fast.metrics.passthrough != slow.metrics.passthrough)
+    {
+        printf("[passthrough] failed. fast: %llu, slow: %llu\n",
+            (unsigned long long)fast.metrics.passthrough, (unsigned long long)slow.metrics.passthrough);
+        return 1;
+    }
+    else
+    {
+        printf("[passthrough] passed. fast and slow: %llu\n", (unsigned long long)fast.metrics.passthrough);
+    }
+
+    // Toggling the bypass releases the held output keys and resets the engine,
+    // then the input frames are written as they are read
+    description = "sd, jd, delay, bypass, ju, su";
+    expected = "105:1 | 105:0 | 4/4:36 36:0 | 57:0 | ";
+    int pipe_descriptors[2];
+    if (pipe(pipe_descriptors) != 0)
+    {
+        printf("[%s] failed. no pipe\n", description);
+        return 1;
+    }
+    output_file_descriptor = pipe_descriptors[1];
+    struct tc_engine bypassed;
+    initEngine(&bypassed, &keymap, &timers, queueOutput, NULL);
+    processKey(&bypassed, EV_KEY, KEY_SPACE, 1, virtualTime);
+    processKey(&bypassed, EV_KEY, KEY_J, 1, virtualTime);
+    elapse(keymap.repeat.delay);
+    release_output_keys();
+    resetMapper(&bypassed);
+    const struct input_event frames[] = {
+        { .type = EV_MSC, .code = MSC_SCAN, .value = KEY_J },
+        { .type = EV_KEY, .code = KEY_J, .value = 0 },
+        { .type = EV_SYN, .code = SYN_REPORT },
+        { .type = EV_KEY, .code = KEY_SPACE, .value = 0 },
+        { .type = EV_SYN, .code = SYN_REPORT }
+    };
+    queue_events(frames, 5);
+    flush_events();
+    elapse(keymap.repeat.delay);
+    char written[256];
+    readWritten(pipe_descriptors[0], written);
+    output_file_descriptor = -1;
+    close(pipe_descriptors[0]);
+    close(pipe_descriptors[1]);
+    if (strcmp(expected, written) != 0 || bypassed.state != idle || bypassed.repeatCode != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, written);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, written);
+    }
+
+    return 0;
+}
+
+/*
+ * Tests for merging the events of a group of devices by their timestamps.
+ * Times are in milliseconds.
+ */
+static int testDeviceGroups()
+{
+    char* description;
+    char* expected;
+    static struct input_event events[MAX_INPUT_DEVICES][MAX_INPUT_EVENTS];
+    const struct
+    {
+        int device;
+        int milliseconds;
+        int code;
+        int value;
+    } read[] = {
+        // The keyboard reports after the pedal that held the hyper key before it
+        { 0, 20, KEY_J, 1 }, { 0, 40, KEY_J, 0 }, { 0, 50, KEY_A, 1 },
+        { 2, 10, KEY_SPACE, 1 }, { 2, 45, KEY_SPACE, 0 }, { 2, 50, KEY_B, 1 }
+    };
+    int counts[MAX_INPUT_DEVICES] = { 0 };
+    int next[MAX_INPUT_DEVICES] = { 0 };
+    for (int i = 0; i < (int)(sizeof(read) / sizeof(read[0])); i++)
+    {
+        struct input_event* event = &events[read[i].device][counts[read[i].device]++];
+        memset(event, 0, sizeof(*event));
+        event->input_event_sec = read[i].milliseconds / 1000;
+        event->input_event_usec = read[i].milliseconds % 1000 * 1000;
+        event->type = EV_KEY;
+        event->code = read[i].code;
+        event->value = read[i].value;
+    }
+
+    // Interleaved timestamps are taken in order, and ties go to the device listed first
+    description = "interleaved, tie";
+    expected = "2 0 0 2 0 2 ";
+    struct tc_engine shared;
+    initEngine(&shared, &keymap, &timers, testOutput, output);
+    static char order[64];
+    order[0] = '\0';
+    memset(output, 0, sizeof(output));
+    int device;
+    while ((device = next_input_device(events, counts, next, 0, MAX_INPUT_DEVICES)) >= 0)
+    {
+        const struct input_event* event = &events[device][next[device]++];
+        sprintf(emitString, "%i ", device);
+        strcat(order, emitString);
+        processKey(&shared, EV_KEY, event->code, event->value, event->input_event_sec * 1000000ULL + event->input_event_usec);
+    }
+    if (strcmp(expected, order) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, order);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, order);
+    }
+
+    // The engine of the group maps the key of the keyboard with the hyper key of the pedal
+    description = "shared engine";
+    expected = "105:1 105:0 30:1 48:1 ";
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // The pedal holding the hyper key is unplugged while the keyboard holds a mapped key,
+    // the mapped key is released like on a release of the hyper key
+    description = "pd(space), kd(j), ku(j), kd(j), pedal removed, ku(j), kd(j), ku(j)";
+    expected = "105:1 105:0 105:1 105:0 36:0 36:1 36:0 ";
+    struct tc_engine remaining;
+    initEngine(&remaining, &keymap, &timers, testOutput, output);
+    unsigned char pedal[KEY_CNT] = { 0 };
+    memset(output, 0, sizeof(output));
+    processKey(&remaining, EV_KEY, KEY_SPACE, 1, virtualTime);
+    pedal[KEY_SPACE] = 1;
+    processKey(&remaining, EV_KEY, KEY_J, 1, virtualTime);
+    processKey(&remaining, EV_KEY, KEY_J, 0, virtualTime);
+    processKey(&remaining, EV_KEY, KEY_J, 1, virtualTime);
+    releaseKeys(&remaining, pedal, virtualTime);
+    processKey(&remaining, EV_KEY, KEY_J, 0, virtualTime);
+    processKey(&remaining, EV_KEY, KEY_J, 1, virtualTime);
+    processKey(&remaining, EV_KEY, KEY_J, 0, virtualTime);
+    if (strcmp(expected, output) != 0 || remaining.state != idle)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    return 0;
+}
+
+/*
+ * Tests for the engine counters and their text format.
+ * The queue of held mapped keys holds seven keys, the eighth is dropped and
+ * its release passes through like a key pressed before the hyper key.
+ */
+static int testMetrics()
+{
+    char* description;
+    static char text[4096];
+    struct tc_engine counted;
+    initEngine(&counted, &keymap, &timers, testOutput, output);
+    const int mapped[] = { KEY_I, KEY_J, KEY_K, KEY_L, KEY_H, KEY_N, KEY_U, KEY_O };
+    const int count = sizeof(mapped) / sizeof(mapped[0]);
+
+    description = "xd, xu, sd, 8 mapped keys down and up, su";
+    memset(output, 0, sizeof(output));
+    processKey(&counted, EV_KEY, KEY_X, 1, virtualTime);
+    processKey(&counted, EV_KEY, KEY_X, 0, virtualTime);
+    processKey(&counted, EV_KEY, KEY_SPACE, 1, virtualTime);
+    for (int i = 0; i < count; i++)
+    {
+        processKey(&counted, EV_KEY, mapped[i], 1, virtualTime);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        processKey(&counted, EV_KEY, mapped[i], 0, virtualTime);
+    }
+    processKey(&counted, EV_KEY, KEY_SPACE, 0, virtualTime);
+    format_metrics(text, sizeof(text), &counted.metrics);
+    if (counted.metrics.hyper_activations != 1 || counted.metrics.queue_overflows != 1
+        || counted.metrics.passthrough != 3 || counted.metrics.mapped == 0
+        || strstr(text, "# TYPE touchcursor_queue_overflows_total counter\ntouchcursor_queue_overflows_total 1\n") == NULL
+        || strstr(text, "\ntouchcursor_hyper_activations_total 1\n") == NULL)
+    {
+        printf("[%s] failed. hyper: %llu, overflows: %llu, passthrough: %llu, mapped: %llu\n%s", description,
+            (unsigned long long)counted.metrics.hyper_activations, (unsigned long long)counted.metrics.queue_overflows,
+            (unsigned long long)counted.metrics.passthrough, (unsigned long long)counted.metrics.mapped, text);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. hyper: 1, overflows: 1, passthrough: 3, mapped: %llu\n", description,
+            (unsigned long long)counted.metrics.mapped);
+    }
+
+    // A truncated text reports its full length
+    if (format_metrics(text, 16, &counted.metrics) <= 16 || strlen(text) != 15)
+    {
+        printf("[truncated metrics] failed. text: '%s'\n", text);
+        return 1;
+    }
+
+    // Key events passed through to the output, as while paused, are counted where they are queued
+    description = "passed through events";
+    int pipe_descriptors[2];
+    if (pipe(pipe_descriptors) != 0)
+    {
+        printf("[%s] failed. no pipe\n", description);
+        return 1;
+    }
+    output_file_descriptor = pipe_descriptors[1];
+    const uint64_t emitted = metrics.events_emitted;
+    const struct input_event frame[] = {
+        { .type = EV_MSC, .code = MSC_SCAN, .value = 30 },
+        { .type = EV_KEY, .code = KEY_A, .value = 1 },
+        { .type = EV_SYN, .code = SYN_REPORT }
+    };
+    queue_events(frame, 3);
+    emit(EV_KEY, KEY_A, 0);
+    struct input_event written[8];
+    ssize_t length = read(pipe_descriptors[0], written, sizeof(written));
+    output_file_descriptor = -1;
+    close(pipe_descriptors[0]);
+    close(pipe_descriptors[1]);
+    if (metrics.events_emitted - emitted != 2 || length != 5 * sizeof(struct input_event))
+    {
+        printf("[%s] failed. counted: %llu, written: %zi\n", description,
+            (unsigned long long)(metrics.events_emitted - emitted), length);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. counted: 2\n", description);
+    }
+
+    return 0;
+}
+
+/*
+ * Tests for the flight recorder and its trace.
+ * The recorder wraps around, keeping the last RECORDER_LENGTH records.
+ */
+static int testRecorder()
+{
+    char* description;
+    static struct flight_recorder recorder;
+    clear_recorder(&recorder);
+    engine.recorder = &recorder;
+
+    description = "sd, jd, ju, su";
+    recorder.now = 42;
+    type(8, KEY_SPACE, 1, KEY_J, 1, KEY_J, 0, KEY_SPACE, 0);
+    char* text = NULL;
+    size_t length = 0;
+    FILE* file = open_memstream(&text, &length);
+    int result = write_trace(&recorder, file);
+    fclose(file);
+    if (result != EXIT_SUCCESS || recorder.head != 10
+        || recorder.records[1].kind != record_state || recorder.records[1].code != idle || recorder.records[1].value != hyper
+        || strstr(text, "{\"name\":\"KEY_LEFT down\",\"cat\":\"output\",\"ph\":\"i\",\"s\":\"t\",\"ts\":42,") == NULL
+        || strstr(text, "{\"name\":\"map -> idle\"") == NULL)
+    {
+        printf("[%s] failed. records: %llu, trace:\n%s", description, (unsigned long long)recorder.head, text);
+        free(text);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. records: %llu\n", description, (unsigned long long)recorder.head);
+    }
+    free(text);
+
+    description = "wrap around";
+    // Each key makes an input and an output record
+    for (int i = 0; i < RECORDER_LENGTH / 2; i++)
+    {
+        recorder.now = 1000 + i;
+        memset(output, 0, sizeof(output));
+        key(KEY_X, i % 2 == 0);
+    }
+    const struct record* oldest = &recorder.records[recorder.head & (RECORDER_LENGTH - 1)];
+    if (oldest->time != 1000 || oldest->kind != record_input)
+    {
+        printf("[%s] failed. oldest record time: %llu\n", description, (unsigned long long)oldest->time);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. oldest record time: %llu\n", description, (unsigned long long)oldest->time);
+    }
+    engine.recorder = NULL;
+
+    return 0;
+}
+
+/*
+ * Tests for the log levels and the rate limit of a call site.
+ */
+static int testLog()
+{
+    char* description;
+    struct log_site site = { 0 };
+    struct log_site other = { 0 };
+
+    description = "rate limit";
+    int logged = 0;
+    for (int i = 0; i < LOG_BURST * 2; i++)
+    {
+        logged += log_message(&site, log_info, "info: rate limited message %i\n", i);
+    }
+    if (logged != LOG_BURST || site.suppressed != LOG_BURST || !log_message(&other, log_info, "info: other site\n"))
+    {
+        printf("[%s] failed. logged: %i, suppressed: %u\n", description, logged, site.suppressed);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. logged: %i, suppressed: %u\n", description, logged, site.suppressed);
+    }
+
+    description = "log level";
+    struct log_site levels = { 0 };
+    log_level = log_warning;
+    logged = log_message(&levels, log_info, "info: filtered\n") + log_message(&levels, log_debug, "debug: filtered\n");
+    logged += log_message(&levels, log_warning, "warning: not filtered\n");
+    log_level = log_info;
+    if (logged != 1 || levels.count != 1)
+    {
+        printf("[%s] failed. logged: %i\n", description, logged);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. logged: %i\n", description, logged);
+    }
+
+    // Configuration diagnostics are not rate limited
+    description = "unlimited";
+    struct log_site diagnostics = { 0 };
+    log_unlimited = 1;
+    logged = 0;
+    for (int i = 0; i < LOG_BURST * 2; i++)
+    {
+        logged += log_message(&diagnostics, log_info, "info: unlimited message %i\n", i);
+    }
+    log_unlimited = 0;
+    if (logged != LOG_BURST * 2 || diagnostics.suppressed != 0)
+    {
+        printf("[%s] failed. logged: %i, suppressed: %u\n", description, logged, diagnostics.suppressed);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. logged: %i\n", description, logged);
+    }
+
+    return 0;
+}
+
+/*
+ * Tests for the status page, written and read through two mappings of its file.
+ */
+static int testStatusPage()
+{
+    char* description;
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/touchcursor_test_%i.status", (int)getpid());
+
+    description = "write, read";
+    struct tc_status* page = create_status_page(path);
+    const struct tc_status* reader = open_status_page(path);
+    struct tc_status values = { .pid = 42, .state = map, .hyper_key = KEY_SPACE, .held_keys = 2, .mapped = 7 };
+    struct tc_status snapshot;
+    int result = EXIT_FAILURE;
+    if (page != NULL && reader != NULL)
+    {
+        write_status(page, &values);
+        write_status(page, &values);
+        result = read_status(reader, &snapshot);
+    }
+    if (result != EXIT_SUCCESS || snapshot.magic != STATUS_MAGIC || snapshot.sequence != 4
+        || snapshot.pid != 42 || snapshot.state != map || snapshot.hyper_key != KEY_SPACE
+        || snapshot.held_keys != 2 || snapshot.mapped != 7)
+    {
+        printf("[%s] failed. page: %p, reader: %p\n", description, (void*)page, (const void*)reader);
+        unlink(path);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. sequence: %u\n", description, snapshot.sequence);
+    }
+
+    // An update that only changes the time leaves the page alone
+    description = "unchanged update";
+    values.updated = 1000;
+    int written = update_status(page, &values);
+    values.mapped++;
+    written += update_status(page, &values) * 2;
+    read_status(reader, &snapshot);
+    if (written != 2 || snapshot.sequence != 6 || snapshot.mapped != 8 || snapshot.updated != 1000)
+    {
+        printf("[%s] failed. written: %i, sequence: %u\n", description, written, snapshot.sequence);
+        close_status_page(page);
+        close_status_page(reader);
+        unlink(path);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. sequence: %u\n", description, snapshot.sequence);
+    }
+
+    // The profile name is escaped for JSON
+    description = "escaped name";
+    char* expected = "a\\\"b\\\\c\\u0009";
+    char escaped[STATUS_ESCAPED_NAME_LENGTH];
+    strcpy(values.profile_name, "a\"b\\c\t");
+    escape_profile_name(&values, escaped);
+    if (strcmp(expected, escaped) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, escaped);
+        close_status_page(page);
+        close_status_page(reader);
+        unlink(path);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, escaped);
+    }
+
+    // A page of another version is not read
+    description = "version";
+    page->version = STATUS_VERSION + 1;
+    const struct tc_status* other = open_status_page(path);
+    close_status_page(page);
+    close_status_page(reader);
+    unlink(path);
+    if (other != NULL)
+    {
+        printf("[%s] failed. the page was opened\n", description);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. the page was not opened\n", description);
+    }
+
+    return 0;
+}
+
+/*
+ * Tests for the command lines of a control client, read from a pipe.
+ */
+static int testControlCommands()
+{
+    char* description;
+    int descriptors[2];
+    if (pipe2(descriptors, O_NONBLOCK) < 0)
+    {
+        printf("[control] failed. could not create a pipe\n");
+        return 1;
+    }
+    control_client_descriptor = descriptors[0];
+
+    description = "pause, state, partial line";
+    const char input[] = "pause\nstate\r\nres";
+    write(descriptors[1], input, sizeof(input) - 1);
+    memset(output, 0, sizeof(output));
+    char* command;
+    read_control_client();
+    while ((command = next_control_command()) != NULL)
+    {
+        strcat(output, command);
+        strcat(output, ",");
+    }
+    write(descriptors[1], "ume\n", 4);
+    read_control_client();
+    while ((command = next_control_command()) != NULL)
+    {
+        strcat(output, command);
+        strcat(output, ",");
+    }
+    if (strcmp(output, "pause,state,resume,") != 0)
+    {
+        printf("[%s] failed. expected: 'pause,state,resume,', output: '%s'\n", description, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: 'pause,state,resume,', output: '%s'\n", description, output);
+    }
+
+    description = "disconnect";
+    close(descriptors[1]);
+    if (read_control_client() != EXIT_FAILURE)
+    {
+        printf("[%s] failed. the client is still connected\n", description);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. the client disconnected\n", description);
+    }
+    close_control_client();
+
+    return 0;
+}
+
+/*
+ * Parses a configuration from a string into the keymap and options.
+ */
+static void parse(const char* text)
+{
+    static char configuration[1024];
+    strcpy(configuration, text);
+    FILE* file = fmemopen(configuration, strlen(configuration), "r");
+    parse_configuration(file);
+    fclose(file);
+}
+
+/*
+ * Tests for the configuration parser.
+ * Parsing replaces the keymap of the other tests, so this test runs after them.
+ */
+static int testConfiguration()
+{
+    char* description;
+    char* expected;
+
+    // Keys above code 255 are bound like other keys, codes beyond the key tables are ignored
+    description = "high codes";
+    expected = "30:1 30:0 ";
+    parse("[Remap]\nKEY_FN=KEY_A\n");
+    struct tc_engine configured;
+    initEngine(&configured, &keymap, &timers, testOutput, output);
+    memset(output, 0, sizeof(output));
+    processKey(&configured, EV_KEY, KEY_FN, 1, virtualTime);
+    processKey(&configured, EV_KEY, KEY_CNT, 1, virtualTime);
+    processKey(&configured, EV_KEY, 0xffff, 1, virtualTime);
+    processKey(&configured, EV_KEY, KEY_FN, 0, virtualTime);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Section names match exactly, and a parse starts outside of any section
+    description = "sections";
+    parse("[Remap]\nKEY_A=KEY_B\n[\nKEY_C=KEY_D\n[Remap\nKEY_E=KEY_F\n");
+    int exact = keymap.remap[KEY_A] == KEY_B && keymap.remap[KEY_C] == 0 && keymap.remap[KEY_E] == 0;
+    parse("KEY_A=KEY_B\n");
+    if (!exact || keymap.remap[KEY_A] != 0)
+    {
+        printf("[%s] failed. a: %i, c: %i, e: %i\n", description, keymap.remap[KEY_A], keymap.remap[KEY_C], keymap.remap[KEY_E]);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed\n", description);
+    }
+
+    // Lines with unknown key names are ignored rather than bound to code 0
+    description = "unknown keys";
+    parse("[Remap]\nKEY_NOPE=KEY_B\nKEY_C=KEY_NOPE\n[Bindings]\nKEY_NOPE=KEY_LEFT\n[Combos]\nKEY_J+KEY_NOPE=KEY_ESC\n");
+    if (keymap.remap[0] != 0 || keymap.remap[KEY_C] != 0 || keymap.key_actions[0].flags != 0 || keymap.combo_count != 0)
+    {
+        printf("[%s] failed. remap 0: %i, remap c: %i, flags 0: %i, combos: %i\n", description,
+            keymap.remap[0], keymap.remap[KEY_C], keymap.key_actions[0].flags, keymap.combo_count);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed\n", description);
+    }
+
+    // A binding or combo with a bad token is skipped and leaves nothing in the sequence arena
+    description = "bad binding tokens";
+    parse("[Bindings]\nKEY_J=KEY_LEFT,KEY_NOPE\nKEY_K=KEY_DOWN\n[Combos]\nKEY_W+KEY_Q=KEY_ESC,KEY_NOPE\nKEY_A+KEY_S=KEY_TAB\n");
+    if (keymap.key_actions[KEY_J].length != 0 || keymap.key_actions[KEY_K].offset != 0 || keymap.key_sequences_length != 2
+        || keymap.combo_count != 1 || keymap.combos[0].offset != 1)
+    {
+        printf("[%s] failed. j: %i, k: %i, arena: %i, combos: %i\n", description,
+            keymap.key_actions[KEY_J].length, keymap.key_actions[KEY_K].offset, keymap.key_sequences_length, keymap.combo_count);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed\n", description);
+    }
+
+    // Combos that repeat a key or have a single key are rejected, the valid combo is kept
+    description = "repeated combo keys";
+    parse("[Combos]\nKEY_W+KEY_W=KEY_ESC\nKEY_A+KEY_S+KEY_A=KEY_TAB\nKEY_Q=KEY_ENTER\nKEY_W+KEY_Q=KEY_ESC\n");
+    if (keymap.combo_count != 1 || keymap.combos[0].codes[0] != KEY_W || keymap.combos[0].codes[1] != KEY_Q)
+    {
+        printf("[%s] failed. combos: %i\n", description, keymap.combo_count);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed\n", description);
+    }
+
+    // Every key name is found by the binary search, which needs the name table sorted
+    description = "key names";
+    int names = 0;
+    for (int code = 0; code < KEY_CNT; code++)
+    {
+        char name[64];
+        const char* found = convertKeyCodeToString(code);
+        if (found == NULL)
+        {
+            continue;
+        }
+        strcpy(name, found);
+        if (convertKeyStringToCode(name) != code)
+        {
+            printf("[%s] failed. %s: %i, expected: %i\n", description, name, convertKeyStringToCode(name), code);
+            return 1;
+        }
+        names++;
+    }
+    char escape[] = "ESC", minus[] = "-", unknown[] = "KEY_NOPE", empty[] = "";
+    if (names < 400 || convertKeyStringToCode(escape) != KEY_ESC || convertKeyStringToCode(minus) != KEY_MINUS
+        || convertKeyStringToCode(unknown) != 0 || convertKeyStringToCode(empty) != 0 || convertKeyStringToCode(NULL) != 0)
+    {
+        printf("[%s] failed. names: %i\n", description, names);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. %i names\n", description, names);
+    }
+
+    // Negative or malformed times keep the defaults
+    description = "milliseconds";
+    parse("[Options]\nTapHoldTerm=-5\nComboWindow=12x\nReloadQuietPeriod=\n");
+    if (keymap.tap_hold_term != DEFAULT_TAP_HOLD_TERM || keymap.combo_window != DEFAULT_COMBO_WINDOW
+        || reload_quiet_period != DEFAULT_RELOAD_QUIET_PERIOD)
+    {
+        printf("[%s] failed. term: %i, window: %i, quiet period: %i\n", description,
+            keymap.tap_hold_term, keymap.combo_window, reload_quiet_period);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed\n", description);
+    }
+
+    return 0;
+}
+
+/*
+ * Tests for the named profiles of a configuration.
+ * Parsing replaces the keymap of the other tests, so this test runs after them.
+ */
+static int testProfiles()
+{
+    char* description;
+    char* expected;
+    static char configuration[] =
+        "[Hyper]\nHYPER1=KEY_SPACE\n[Bindings]\nKEY_J=KEY_LEFT\n[TapHold]\nKEY_F=KEY_F,KEY_LEFTCTRL\n"
+        "[Options]\nProfileKeys=KEY_RIGHTCTRL+KEY_F1\n"
+        "[Profile gaming]\n[Remap]\nKEY_CAPSLOCK=KEY_ESC\n[Options]\nProfileKeys=KEY_RIGHTCTRL+KEY_F2\n"
+        "[Profile gaming]\n[Hyper]\nHYPER1=KEY_A\n";
+    FILE* file = fmemopen(configuration, strlen(configuration), "r");
+    parse_configuration(file);
+    fclose(file);
+
+    description = "profiles";
+    if (profile_count != 2 || find_profile("default") != 0 || find_profile("gaming") != 1
+        || profiles[0].keymap != &keymap || profiles[1].keymap->hyperKey != 0
+        || profiles[0].keys_length != 2 || profiles[1].keys[1] != KEY_F2)
+    {
+        printf("[%s] failed. count: %i, gaming: %i\n", description, profile_count, find_profile("gaming"));
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. count: 2, gaming: 1\n", description);
+    }
+
+    // Switching swaps the keymap of the engine between two events
+    struct tc_engine switched;
+    initEngine(&switched, profiles[0].keymap, &timers, testOutput, output);
+    description = "sd, jd, ju, su, switch, sd, jd, ju, su, capsd, capsu";
+    expected = "105:1 105:0 57:1 36:1 36:0 57:0 1:1 1:0 ";
+    memset(output, 0, sizeof(output));
+    processKey(&switched, EV_KEY, KEY_SPACE, 1, virtualTime);
+    processKey(&switched, EV_KEY, KEY_J, 1, virtualTime);
+    processKey(&switched, EV_KEY, KEY_J, 0, virtualTime);
+    processKey(&switched, EV_KEY, KEY_SPACE, 0, virtualTime);
+    resetMapper(&switched);
+    switched.keymap = profiles[find_profile("gaming")].keymap;
+    processKey(&switched, EV_KEY, KEY_SPACE, 1, virtualTime);
+    processKey(&switched, EV_KEY, KEY_J, 1, virtualTime);
+    processKey(&switched, EV_KEY, KEY_J, 0, virtualTime);
+    processKey(&switched, EV_KEY, KEY_SPACE, 0, virtualTime);
+    processKey(&switched, EV_KEY, KEY_CAPSLOCK, 1, virtualTime);
+    processKey(&switched, EV_KEY, KEY_CAPSLOCK, 0, virtualTime);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Switching with a tap/hold key and a mapped key held releases their output in one frame,
+    // the held keys are ignored until they are pressed again
+    description = "fd, term, sd, jd, delay, switch, ju, fu, su, jd, ju";
+    expected = "29:1 105:1 29:0+105:0 36:1 36:0 ";
+    unsigned char held[KEY_CNT] = { 0 };
+    held[KEY_F] = held[KEY_SPACE] = held[KEY_J] = 1;
+    switched.keymap = profiles[0].keymap;
+    resetMapper(&switched);
+    memset(output, 0, sizeof(output));
+    processKey(&switched, EV_KEY, KEY_F, 1, virtualTime);
+    elapse(switched.keymap->tap_hold_term);
+    processKey(&switched, EV_KEY, KEY_SPACE, 1, virtualTime);
+    processKey(&switched, EV_KEY, KEY_J, 1, virtualTime);
+    elapse(switched.keymap->repeat.delay);
+    releaseMapper(&switched, held);
+    switched.keymap = profiles[find_profile("gaming")].keymap;
+    elapse(profiles[0].keymap->repeat.delay);
+    processKey(&switched, EV_KEY, KEY_J, 2, virtualTime);
+    processKey(&switched, EV_KEY, KEY_J, 0, virtualTime);
+    processKey(&switched, EV_KEY, KEY_F, 0, virtualTime);
+    processKey(&switched, EV_KEY, KEY_SPACE, 0, virtualTime);
+    processKey(&switched, EV_KEY, KEY_J, 1, virtualTime);
+    processKey(&switched, EV_KEY, KEY_J, 0, virtualTime);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Devices take the profile of their section or of their Profile= line, an unknown profile is the default one
+    description = "device profiles";
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/touchcursor_test_%i.devices", (int)getpid());
+    FILE* list = fopen(path, "w");
+    if (list == NULL)
+    {
+        printf("[%s] failed. could not write %s\n", description, path);
+        return 1;
+    }
+    // Like the kernel, each handler is followed by a space
+    fputs("N: Name=\"Keyboard\"\nH: Handlers=sysrq kbd event3 leds \n\n"
+          "N: Name=\"Pad\"\nH: Handlers=kbd event4 \n\n"
+          "N: Name=\"Pedal\"\nH: Handlers=kbd event5 \n\n"
+          "N: Name=\"Laptop\"\nH: Handlers=kbd event6 \n", list);
+    fclose(list);
+    input_devices_file = path;
+    parse("[Device]\nName=\"Keyboard\"\n"
+          "[Device]\nName=\"Pad\"\nProfile=gaming\nGroup=desk\n"
+          "[Device]\nName=\"Missing\"\n"
+          "[Device]\nName=\"Pedal\"\nProfile=missing\nGroup=desk\n"
+          "[Profile gaming]\n[Device]\nName=\"Laptop\"\n");
+    input_devices_file = "/proc/bus/input/devices";
+    unlink(path);
+    if (input_device_count != 4 || strcmp(input_devices[0].event_path, "/dev/input/event3") != 0
+        || strcmp(input_devices[3].event_path, "/dev/input/event6") != 0
+        || input_devices[0].profile != 0 || input_devices[1].profile != 1 || input_devices[2].profile != 0 || input_devices[3].profile != 1
+        || input_devices[0].group != 0 || input_devices[1].group != 1 || input_devices[2].group != 1 || input_devices[3].group != 3)
+    {
+        printf("[%s] failed. devices: %i\n", description, input_device_count);
+        for (int i = 0; i < input_device_count; i++)
+        {
+            printf("  %s profile: %i, group: %i\n", input_devices[i].event_path, input_devices[i].profile, input_devices[i].group);
+        }
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. devices: 4\n", description);
+    }
+    parse("");
+
+    return 0;
+}
+
+/*
+ * Tests for the timer wheel.
+ * Times are in microseconds, the wheel has millisecond ticks.
+ */
+static int testTimerWheel()
+{
+    char* description;
+    char* expected;
+    struct timer_wheel wheel;
+    const uint64_t start = 1000000000ULL;
+    for (int i = 0; i < 4; i++)
+    {
+        testTimers[i].callback = onTestTimer;
+    }
+
+    // Timers on different levels expire in order
+    description = "order";
+    expected = "2 0 3 1 ";
+    memset(output, 0, sizeof(output));
+    timer_wheel_init(&wheel, start);
+    timer_start(&wheel, &testTimers[0], start + 5000);
+    timer_start(&wheel, &testTimers[1], start + 3600000000ULL);
+    timer_start(&wheel, &testTimers[2], start + 1000);
+    timer_start(&wheel, &testTimers[3], start + 250000);
+    timer_advance(&wheel, start + 4000000000ULL);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // A timer expires at its tick, not before
+    description = "exact";
+    expected = "0 ";
+    memset(output, 0, sizeof(output));
+    timer_wheel_init(&wheel, start);
+    timer_start(&wheel, &testTimers[0], start + 70000);
+    timer_advance(&wheel, start + 69999);
+    if (output[0] != 0 || timer_next(&wheel) != start + 70000)
+    {
+        printf("[%s] failed. the timer expired early\n", description);
+        return 1;
+    }
+    timer_advance(&wheel, start + 70000);
+    if (strcmp(expected, output) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    // Stopped and restarted timers
+    description = "stop, restart";
+    expected = "1 0 ";
+    memset(output, 0, sizeof(output));
+    timer_wheel_init(&wheel, start);
+    timer_start(&wheel, &testTimers[0], start + 2000);
+    timer_start(&wheel, &testTimers[1], start + 3000);
+    timer_start(&wheel, &testTimers[2], start + 4000);
+    timer_stop(&wheel, &testTimers[2]);
+    timer_start(&wheel, &testTimers[0], start + 100000);
+    timer_advance(&wheel, start + 200000);
+    if (strcmp(expected, output) != 0 || timer_running(&testTimers[2]) || timer_next(&wheel) != 0)
+    {
+        printf("[%s] failed. expected: '%s', output: '%s'\n", description, expected, output);
+        return 1;
+    }
+    else
+    {
+        printf("[%s] passed. expected: '%s', output: '%s'\n", description, expected, output);
+    }
+
+    return 0;
+}
+
+/*
+ * Simple method for running all tests.
+ */
+static int runTests()
+{
+    // The mapper and its timers run on the virtual clock
+    current_time = virtualClock;
+    timer_wheel_init(&timers, virtualTime);
+
+    // default config
+    init_keymap(&keymap);
+    keymap.hyperKey = KEY_SPACE;
+    keymap.remap[KEY_G] = KEY_J;
+    bind(KEY_I, KEY_UP);
+    bind(KEY_J, KEY_LEFT);
+    bind(KEY_K, KEY_DOWN);
+    bind(KEY_L, KEY_RIGHT);
+    bind(KEY_H, KEY_PAGEUP);
+    bind(KEY_N, KEY_PAGEDOWN);
+    bind(KEY_U, KEY_HOME);
+    bind(KEY_O, KEY_END);
+    bind(KEY_M, KEY_DELETE);
+    bind(KEY_P, KEY_BACKSPACE);
+    bind(KEY_Y, KEY_INSERT);
+    int hello[] = { KEY_H, KEY_E, KEY_L, KEY_L, KEY_O };
+    bind_key_sequence(&keymap, KEY_B, hello, 5);
+    int ctrlLeft[] = { KEY_LEFTCTRL | SEQUENCE_CHORD, KEY_LEFT };
+    bind_key_sequence(&keymap, KEY_D, ctrlLeft, 2);
+    int ctrlRight[] = { KEY_LEFTCTRL | SEQUENCE_CHORD, KEY_RIGHT };
+    bind_key_sequence(&keymap, KEY_F, ctrlRight, 2);
+    int wq[] = { KEY_W, KEY_Q }, esc[] = { KEY_ESC };
+    add_combo(&keymap, wq, 2, add_key_sequence(&keymap, esc, 1), 1);
+    int zx[] = { KEY_Z, KEY_X }, tab[] = { KEY_TAB };
+    add_combo(&keymap, zx, 2, add_key_sequence(&keymap, tab, 1), 1);
+    int zxc[] = { KEY_Z, KEY_X, KEY_C }, enter[] = { KEY_ENTER };
+    add_combo(&keymap, zxc, 3, add_key_sequence(&keymap, enter, 1), 1);
+    keymap.tap_holds[KEY_R] = (struct tap_hold){ KEY_R, KEY_LEFTALT };
+    keymap.tap_holds[KEY_T] = (struct tap_hold){ KEY_T, KEY_LEFTSHIFT };
+    compile_key_actions(&keymap);
+    initEngine(&engine, &keymap, &timers, testOutput, output);
+
+    mu_run_test(testNormalTyping);
+    printf("Normal typing tests passed.\n");
+
+    mu_run_test(testFastTyping);
+    printf("Fast typing tests passed.\n");
+
+    mu_run_test(testSpecialTyping);
+    printf("Special typing tests passed.\n");
+
+    mu_run_test(testLongSequences);
+    printf("Long sequence tests passed.\n");
+
+    mu_run_test(testChords);
+    printf("Chord tests passed.\n");
+
+    mu_run_test(testCombos);
+    printf("Combo tests passed.\n");
+
+    mu_run_test(testTapHold);
+    printf("Tap/hold tests passed.\n");
+
+    mu_run_test(testTiming);
+    printf("Timing tests passed.\n");
+
+    mu_run_test(testRepeat);
+    printf("Repeat tests passed.\n");
+
+    mu_run_test(testQueue);
+    printf("Queue tests passed.\n");
+
+    mu_run_test(testEngines);
+    printf("Engine tests passed.\n");
+
+    mu_run_test(testFastPath);
+    printf("Fast path tests passed.\n");
+
+    mu_run_test(testDeviceGroups);
+    printf("Device group tests passed.\n");
+
+    mu_run_test(testMetrics);
+    printf("Metrics tests passed.\n");
+
+    mu_run_test(testRecorder);
+    printf("Recorder tests passed.\n");
+
+    mu_run_test(testLog);
+    printf("Log tests passed.\n");
+
+    mu_run_test(testStatusPage);
+    printf("Status page tests passed.\n");
+
+    mu_run_test(testControlCommands);
+    printf("Control command tests passed.\n");
+
+    mu_run_test(testConfiguration);
+    printf("Configuration tests passed.\n");
+
+    mu_run_test(testProfiles);
+    printf("Profile tests passed.\n");
+
+    mu_run_test(testTimerWheel);
+    printf("Timer wheel tests passed.\n");
 
     return 0;
 }
@@ -0,0 +1,220 @@
+#include <string.h>
+
+#include "timer.h"
+
+#define TICK 1000  // One millisecond, in microseconds
+#define BITS 6     // The number of tick bits per level
+#define SPAN ((uint64_t)1 << (BITS * TIMER_LEVELS)) // The number of ticks covered by the wheel
+
+struct timer_wheel timers;
+
+/**
+ * Returns the index of the lowest set bit.
+ * */
+static int lowest_bit(uint64_t value)
+{
+    return __builtin_ctzll(value);
+}
+
+/**
+ * Adds a timer to the slot for its expiry.
+ * The level is the highest group of tick bits in which the expiry differs from
+ * the current tick, so every timer in a slot is due, or cascades to a lower
+ * level, when the current tick reaches the start of the slot.
+ * The top level wraps around: its slots before the current one belong to the
+ * next rotation, and expiries beyond that are placed in the last slot and
+ * cascade again until they are in range.
+ * */
+static void place(struct timer_wheel* wheel, struct timer* timer)
+{
+    uint64_t expires = timer->expires;
+    if (expires - wheel->current >= SPAN)
+    {
+        expires = wheel->current + SPAN - 1;
+    }
+    uint64_t difference = expires ^ wheel->current;
+    int level = difference ? (63 - __builtin_clzll(difference)) / BITS : 0;
+    if (level >= TIMER_LEVELS)
+    {
+        level = TIMER_LEVELS - 1;
+    }
+    int slot = (expires >> (BITS * level)) & (TIMER_SLOTS - 1);
+    struct timer** head = &wheel->slots[level][slot];
+    timer->level = level;
+    timer->slot = slot;
+    timer->next = *head;
+    timer->previous = head;
+    if (*head)
+    {
+        (*head)->previous = &timer->next;
+    }
+    *head = timer;
+    wheel->occupied[level] |= (uint64_t)1 << slot;
+}
+
+/**
+ * Removes the timers of a slot and returns them as a list.
+ * */
+static struct timer* take_slot(struct timer_wheel* wheel, int level, int slot)
+{
+    struct timer* list = wheel->slots[level][slot];
+    wheel->slots[level][slot] = NULL;
+    wheel->occupied[level] &= ~((uint64_t)1 << slot);
+    return list;
+}
+
+/**
+ * Returns the tick of the next slot that is due or has to cascade, or 0 if the wheel is empty.
+ * The lowest occupied level always holds the earliest slot.
+ * */
+static uint64_t next_slot_tick(const struct timer_wheel* wheel, int* level)
+{
+    for (int i = 0; i < TIMER_LEVELS; i++)
+    {
+        if (wheel->occupied[i])
+        {
+            int shift = BITS * i;
+            uint64_t block = wheel->current >> (shift + BITS) << (shift + BITS);
+            uint64_t occupied = wheel->occupied[i];
+            if (i == TIMER_LEVELS - 1)
+            {
+                // Slots up to the current one are in the next rotation
+                int current = (wheel->current >> shift) & (TIMER_SLOTS - 1);
+                uint64_t later = current == TIMER_SLOTS - 1 ? 0 : occupied & ~(((uint64_t)2 << current) - 1);
+                if (later)
+                {
+                    occupied = later;
+                }
+                else
+                {
+                    block += SPAN;
+                }
+            }
+            *level = i;
+            return block | ((uint64_t)lowest_bit(occupied) << shift);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Initializes a timer wheel at a time in microseconds.
+ * */
+void timer_wheel_init(struct timer_wheel* wheel, uint64_t time)
+{
+    memset(wheel, 0, sizeof(*wheel));
+    wheel->current = time / TICK;
+}
+
+/**
+ * Starts (or restarts) a timer to expire at a time in microseconds.
+ * Times in the past expire at the next advance.
+ * */
+void timer_start(struct timer_wheel* wheel, struct timer* timer, uint64_t time)
+{
+    timer_stop(wheel, timer);
+    uint64_t expires = (time + TICK - 1) / TICK;
+    timer->expires = expires > wheel->current ? expires : wheel->current;
+    place(wheel, timer);
+}
+
+/**
+ * Stops a timer. Stopping a timer that is not running does nothing.
+ * */
+void timer_stop(struct timer_wheel* wheel, struct timer* timer)
+{
+    if (!timer->previous)
+    {
+        return;
+    }
+    *timer->previous = timer->next;
+    if (timer->next)
+    {
+        timer->next->previous = timer->previous;
+    }
+    if (!wheel->slots[timer->level][timer->slot])
+    {
+        wheel->occupied[timer->level] &= ~((uint64_t)1 << timer->slot);
+    }
+    timer->next = NULL;
+    timer->previous = NULL;
+}
+
+/**
+ * Checks if a timer is running.
+ * */
+int timer_running(const struct timer* timer)
+{
+    return timer->previous != NULL;
+}
+
+/**
+ * Returns the time in microseconds of the next timer expiry, or 0 if no timer is running.
+ * Timers more than two years away are reported at an earlier time where they cascade.
+ * */
+uint64_t timer_next(const struct timer_wheel* wheel)
+{
+    int level;
+    uint64_t tick = next_slot_tick(wheel, &level);
+    if (tick == 0 || level == 0)
+    {
+        return tick * TICK;
+    }
+    // The earliest timer is in the slot that starts at this tick
+    int slot = (tick >> (BITS * level)) & (TIMER_SLOTS - 1);
+    uint64_t expires = UINT64_MAX;
+    for (const struct timer* timer = wheel->slots[level][slot]; timer; timer = timer->next)
+    {
+        if (timer->expires < expires)
+        {
+            expires = timer->expires;
+        }
+    }
+    // Timers beyond the range of the wheel only need it to advance to the slot
+    if (expires - tick >= (uint64_t)1 << (BITS * level))
+    {
+        expires = tick;
+    }
+    return expires * TICK;
+}
+
+/**
+ * Advances the wheel to a time in microseconds, running the callbacks of the expired timers.
+ *
+ * @remarks
+ * The wheel is tickless: it jumps directly to the next occupied slot, so the
+ * cost depends on the number of timers and not on the time elapsed.
+ * */
+void timer_advance(struct timer_wheel* wheel, uint64_t time)
+{
+    uint64_t target = time / TICK;
+    int level;
+    uint64_t tick;
+    while ((tick = next_slot_tick(wheel, &level)) != 0 && tick <= target)
+    {
+        wheel->current = tick;
+        if (level > 0)
+        {
+            // Cascade the slot that starts at this tick to the lower levels
+            struct timer* list = take_slot(wheel, level, (tick >> (BITS * level)) & (TIMER_SLOTS - 1));
+            while (list)
+            {
+                struct timer* timer = list;
+                list = timer->next;
+                place(wheel, timer);
+            }
+            continue;
+        }
+        // Run the timers that are due, one at a time so callbacks may stop any timer
+        struct timer* timer;
+        while ((timer = wheel->slots[0][tick & (TIMER_SLOTS - 1)]) != NULL)
+        {
+            timer_stop(wheel, timer);
+            timer->callback(timer);
+        }
+    }
+    if (target > wheel->current)
+    {
+        wheel->current = target;
+    }
+}
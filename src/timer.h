@@ -0,0 +1,70 @@
+#ifndef timer_h
+#define timer_h
+
+#include <stdint.h>
+
+#define TIMER_LEVELS 6
+#define TIMER_SLOTS 64
+
+/**
+ * A timer, embedded in the structure that owns it.
+ * */
+struct timer
+{
+    struct timer* next;
+    struct timer** previous; // The next field (or list head) that points to this timer
+    uint64_t expires;        // The expiry tick
+    uint8_t level;
+    uint8_t slot;
+    void (*callback)(struct timer* timer);
+};
+
+/**
+ * A hierarchical timer wheel with millisecond ticks.
+ * Level n has 64 slots of 64^n ticks each, six levels cover more than two years.
+ * */
+struct timer_wheel
+{
+    uint64_t current; // The current tick
+    uint64_t occupied[TIMER_LEVELS];
+    struct timer* slots[TIMER_LEVELS][TIMER_SLOTS];
+};
+
+/**
+ * The timer wheel of the daemon.
+ * */
+extern struct timer_wheel timers;
+
+/**
+ * Initializes a timer wheel at a time in microseconds.
+ * */
+void timer_wheel_init(struct timer_wheel* wheel, uint64_t time);
+
+/**
+ * Starts (or restarts) a timer to expire at a time in microseconds.
+ * Times in the past expire at the next advance.
+ * */
+void timer_start(struct timer_wheel* wheel, struct timer* timer, uint64_t time);
+
+/**
+ * Stops a timer. Stopping a timer that is not running does nothing.
+ * */
+void timer_stop(struct timer_wheel* wheel, struct timer* timer);
+
+/**
+ * Checks if a timer is running.
+ * */
+int timer_running(const struct timer* timer);
+
+/**
+ * Returns the time in microseconds of the next timer expiry, or 0 if no timer is running.
+ * Timers more than two years away are reported at an earlier time where they cascade.
+ * */
+uint64_t timer_next(const struct timer_wheel* wheel);
+
+/**
+ * Advances the wheel to a time in microseconds, running the callbacks of the expired timers.
+ * */
+void timer_advance(struct timer_wheel* wheel, uint64_t time);
+
+#endif
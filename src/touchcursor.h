@@ -0,0 +1,24 @@
+#ifndef touchcursor_h
+#define touchcursor_h
+
+/**
+ * The public API of libtouchcursor, the mapper engine of the daemon.
+ *
+ * A keymap holds the key tables: fill it with init_keymap, bind_key_sequence,
+ * add_combo and the tap/hold fields, then compile it with compile_key_actions.
+ * An engine maps one stream of key events with a keymap: initialize it with
+ * initEngine and feed it with processKey. The engine sends its output to the
+ * sink it was given, and starts its combo and tap/hold timers on the given
+ * timer wheel, which the caller advances with timer_advance.
+ *
+ * Engines share nothing but the keymap they read, so an embedder can run an
+ * engine per device or per thread. A timer wheel must only be used by the
+ * engines of one thread.
+ * */
+
+#include "clock.h"
+#include "keymap.h"
+#include "mapper.h"
+#include "timer.h"
+
+#endif
@@ -0,0 +1,164 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <libgen.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "buffers.h"
+#include "config.h"
+#include "watch.h"
+
+int watch_file_descriptor = -1;
+unsigned int suppressed_reloads = 0;
+
+static int watch_descriptor = -1;
+static char watch_directory[256];
+static char watch_name[256];
+// The watch of the directory of the file the configuration file links to, if it is a symbolic link
+static int target_watch_descriptor = -1;
+static char target_directory[PATH_MAX];
+static char target_name[256];
+
+/**
+ * Splits a path into its directory and its file name.
+ * */
+static void split_path(const char* path, char* directory, char* name)
+{
+    char copy[PATH_MAX];
+    strcpy(copy, path);
+    strcpy(directory, dirname(copy));
+    strcpy(copy, path);
+    strcpy(name, basename(copy));
+}
+
+/**
+ * Starts watching the directory of the configuration file.
+ *
+ * @remarks
+ * The directory is watched instead of the file so that editors saving with
+ * a rename over the original file are seen as a single IN_MOVED_TO event,
+ * and the watch survives the original inode being deleted.
+ * The directory of the file the configuration file links to is watched too,
+ * see update_configuration_file_watch.
+ * */
+int watch_configuration_file()
+{
+    split_path(configuration_file_path, watch_directory, watch_name);
+    watch_file_descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watch_file_descriptor < 0)
+    {
+        error("error: failed to initialize inotify: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    watch_descriptor = inotify_add_watch(watch_file_descriptor, watch_directory, IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watch_descriptor < 0)
+    {
+        error("error: failed to create the configuration file watch: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    update_configuration_file_watch();
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Resolves the configuration file path and watches the directory of its target.
+ *
+ * @remarks
+ * Edits through a symbolic link, like a configuration kept in a dotfiles
+ * repository, write the target in its own directory, the directory of the
+ * link sees no event. The target may change when the link is replaced, so it
+ * is resolved again after each reload.
+ * */
+void update_configuration_file_watch()
+{
+    char resolved[PATH_MAX];
+    char directory[PATH_MAX];
+    char name[256];
+    if (watch_file_descriptor < 0 || realpath(configuration_file_path, resolved) == NULL)
+    {
+        return;
+    }
+    split_path(resolved, directory, name);
+    if (target_watch_descriptor >= 0 && strcmp(directory, target_directory) == 0)
+    {
+        strcpy(target_name, name);
+        return;
+    }
+    // The watch of a directory is shared, the link directory watch is kept
+    if (target_watch_descriptor >= 0 && target_watch_descriptor != watch_descriptor)
+    {
+        inotify_rm_watch(watch_file_descriptor, target_watch_descriptor);
+    }
+    target_watch_descriptor = inotify_add_watch(watch_file_descriptor, directory, IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (target_watch_descriptor < 0)
+    {
+        warn("warning: failed to watch the configuration file target %s: %s\n", resolved, strerror(errno));
+        return;
+    }
+    strcpy(target_directory, directory);
+    strcpy(target_name, name);
+}
+
+/**
+ * Reads the pending watch events.
+ *
+ * @return int 1 if the configuration file was written or replaced, otherwise 0.
+ * */
+int read_watch_events()
+{
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    int changed = 0;
+    ssize_t result;
+    while ((result = read(watch_file_descriptor, buffer, sizeof(buffer))) > 0)
+    {
+        for (char* pointer = buffer; pointer < buffer + result;)
+        {
+            struct inotify_event* event = (struct inotify_event*)pointer;
+            if (event->len > 0
+                && ((event->wd == watch_descriptor && strcmp(event->name, watch_name) == 0)
+                    || (event->wd == target_watch_descriptor && strcmp(event->name, target_name) == 0)))
+            {
+                changed = 1;
+            }
+            if ((event->mask & IN_IGNORED) && event->wd == target_watch_descriptor && event->wd != watch_descriptor)
+            {
+                target_watch_descriptor = -1;
+            }
+            else if ((event->mask & IN_IGNORED) && event->wd == watch_descriptor)
+            {
+                error("error: the configuration directory watch was removed\n");
+                error("error: file events will no longer be processed\n");
+            }
+            pointer += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    if (result < 0 && errno != EAGAIN)
+    {
+        error("error: unable to read inotify event: %s\n", strerror(errno));
+    }
+    return changed;
+}
+
+/**
+ * Releases the configuration file watch.
+ * */
+int release_configuration_file_watch()
+{
+    if (watch_descriptor > 0)
+    {
+        log("info: releasing configuration file watch\n");
+        inotify_rm_watch(watch_file_descriptor, watch_descriptor);
+        watch_descriptor = -1;
+    }
+    target_watch_descriptor = -1;
+    if (watch_file_descriptor > 0)
+    {
+        close(watch_file_descriptor);
+        watch_file_descriptor = -1;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,38 @@
+#ifndef watch_h
+#define watch_h
+
+/**
+ * The inotify file descriptor for the configuration directory watch.
+ * */
+extern int watch_file_descriptor;
+
+/**
+ * The number of configuration change events that did not cause a reload,
+ * either because they were coalesced into a later reload or because the
+ * file content was unchanged.
+ * */
+extern unsigned int suppressed_reloads;
+
+/**
+ * Starts watching the directory of the configuration file.
+ * */
+int watch_configuration_file();
+
+/**
+ * Resolves the configuration file path and watches the directory of its target.
+ * */
+void update_configuration_file_watch();
+
+/**
+ * Reads the pending watch events.
+ *
+ * @return int 1 if the configuration file was written or replaced, otherwise 0.
+ * */
+int read_watch_events();
+
+/**
+ * Releases the configuration file watch.
+ * */
+int release_configuration_file_watch();
+
+#endif